@@ -4,7 +4,10 @@
 #include "core/puyo_controller.h"
 #include "core/field.h"
 #include "core/player.h"
+#include "core/cancellation.h"
+#include "opening_book.h"
 #include <string>
+#include <algorithm>
 #include <memory>
 #include <map>
 #include <functional>
@@ -51,6 +54,15 @@ struct GameState {
         PlacementHistory() : consecutive_chains(0), turns_since_chain(0) {}
     } placement_history;
     
+    // おじゃまぷよ情報（GarbageSystemの状態）
+    struct GarbageInfo {
+        int pending;              // 自分への予告おじゃまぷよ数（次の手の後、相殺分を除いて降る）
+        int accumulated_score;    // 送信計算の端数スコア（70点未満）
+        int opponent_pending;     // 相手への予告おじゃまぷよ数
+        
+        GarbageInfo() : pending(0), accumulated_score(0), opponent_pending(0) {}
+    } garbage;
+    
     // その他の情報
     int player_id;
     int turn_count;
@@ -105,6 +117,30 @@ protected:
     AIParameters parameters_;
     bool initialized_;
     
+    // 思考の締め切りと中止要求（think_until()の実行中のみ設定される）
+    struct ThinkControl {
+        Deadline deadline;
+        CancellationToken token;
+    } control_;
+    
+    // think_until()の間だけ締め切り・中止要求を差し替え、抜ける時に（例外でも）元に戻す
+    class ThinkControlScope {
+    public:
+        ThinkControlScope(ThinkControl& control, const Deadline& deadline, const CancellationToken& token)
+            : control_(control), previous_(control) {
+            control_.deadline = deadline;
+            control_.token = token;
+        }
+        ~ThinkControlScope() { control_ = previous_; }
+        
+        ThinkControlScope(const ThinkControlScope&) = delete;
+        ThinkControlScope& operator=(const ThinkControlScope&) = delete;
+        
+    private:
+        ThinkControl& control_;
+        ThinkControl previous_;
+    };
+    
 public:
     AIBase(const std::string& name) 
         : name_(name), initialized_(false) {}
@@ -140,17 +176,77 @@ public:
     // 思考処理（純粋仮想関数）
     virtual AIDecision think(const GameState& state) = 0;
     
+    // 締め切り・中止要求付きの思考
+    // 締め切りを過ぎるか中止されると、AIはその時点までの最善手を返す
+    // 1手の思考が短く一定のAI（RandomAI・RLPlayerAI）は確認せず、そのまま最後まで思考して返す
+    AIDecision think_until(const GameState& state, const Deadline& deadline,
+                           const CancellationToken& token = CancellationToken()) {
+        ThinkControlScope scope(control_, deadline, token);
+        return think(state);
+    }
+    
     // 思考時間制限（デフォルトは無制限）
     virtual int get_think_time_ms() const { return -1; }
     
     // デバッグ情報
     virtual std::string get_debug_info() const { return ""; }
     
+    // ターン間で保持している探索情報（探索木・置換表など）を破棄
+    // 新しい対局の開始時など、前回の思考結果が使えなくなった時に呼ぶ
+    virtual void clear_search_cache() {}
+    
+    // ターン間で保持している探索情報の退避・復元
+    // 先読み（Ponderer）が予想局面を思考しても、本番の手番で使う探索情報を消費しないようにする
+    struct SearchState {
+        virtual ~SearchState() = default;
+        virtual std::unique_ptr<SearchState> clone() const = 0;
+    };
+    
+    // 保持している探索情報を取り出す（AIからは破棄される、保持する情報が無いAIはnullptr）
+    virtual std::unique_ptr<SearchState> take_search_state() { return nullptr; }
+    
+    // take_search_state()で取り出した探索情報に置き換える（nullptrなら破棄）
+    virtual void restore_search_state(std::unique_ptr<SearchState> state) { (void)state; }
+    
     // AI種別情報（サブクラスで定義）
     virtual std::string get_type() const = 0;
     virtual std::string get_version() const { return "1.0"; }
 
 protected:
+    // 思考を打ち切るべきか（中止要求または締め切り超過）
+    bool should_stop() const {
+        return control_.token.is_cancelled() || control_.deadline.expired();
+    }
+    
+    // 自身の思考時間上限と締め切りまでの残り時間の短い方（ms）
+    double think_budget_ms(double own_limit_ms) const {
+        return std::min(own_limit_ms, control_.deadline.remaining_ms());
+    }
+    
+    // 定跡ブック（未設定ならnullptr）
+    std::shared_ptr<const OpeningBook> opening_book_;
+    
+    // 定跡ブックの読み込み（ファイルが無ければ定跡なしで動作）
+    void load_opening_book(const std::string& path) {
+        opening_book_ = path.empty() ? nullptr : OpeningBook::load_shared(path);
+    }
+    
+    // 序盤局面なら定跡手を返す（収録されていなければfalse）
+    bool try_opening_book(const GameState& state, AIDecision& decision) const {
+        if (!opening_book_ || !state.own_field) return false;
+        
+        int index = opening_book_->lookup(*state.own_field, state.current_pair, state.next_queue);
+        if (index < 0) return false;
+        
+        const Placement& placement = PLACEMENTS[index];
+        auto move_commands = MoveCommandGenerator::generate_move_commands(
+            *state.own_field, placement.x, placement.r);
+        decision = AIDecision(placement.x, placement.r, move_commands, 1.0,
+                              "OpeningBook: (" + std::to_string(placement.x) + "," +
+                              std::to_string(placement.r) + ")");
+        return true;
+    }
+    
     // ヘルパーメソッド：next情報を活用するための統一インターフェース
     
     // フィールド分析情報を計算
@@ -5,6 +5,8 @@
 #include "chain_search_ai.h"
 #include "rl_player_ai.h"
 #include "human_learning_ai.h"
+#include "mcts_ai.h"
+#include "portfolio_ai.h"
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -155,6 +157,31 @@ private:
             }
         );
         
+        // MCTSAI登録
+        register_ai(
+            "mcts",
+            "MCTS",
+            "1.0",
+            "Monte Carlo Tree Search AI with parallel bitboard playouts",
+            [](const AIParameters& params) -> std::unique_ptr<AIBase> {
+                return std::make_unique<MCTSAI>(params);
+            }
+        );
+        
+        // PortfolioAI登録（子AIはこのマネージャーから生成）
+        register_ai(
+            "portfolio",
+            "Portfolio",
+            "1.0",
+            "Runs several AIs in parallel and combines their decisions",
+            [this](const AIParameters& params) -> std::unique_ptr<AIBase> {
+                return std::make_unique<PortfolioAI>(params,
+                    [this](const std::string& name, const AIParameters& child_params) {
+                        return create_ai(name, child_params);
+                    });
+            }
+        );
+        
         // 他の組み込みAIもここに追加可能
     }
 };
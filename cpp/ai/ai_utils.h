@@ -23,33 +23,34 @@ public:
         }
         
         std::string line;
-        std::string current_section = "";
+        // 開いているセクション（インデント幅とキーの接頭辞）。入れ子のセクションは "a.b.c" のキーになる
+        std::vector<std::pair<size_t, std::string>> sections;
         
         while (std::getline(file, line)) {
-            line = trim(line);
+            // インデント幅はtrim前に数える
+            size_t indent = line.find_first_not_of(" \t");
+            line = trim(strip_comment(line));
             
-            // コメント行やセクションヘッダーをスキップ
-            if (line.empty() || line[0] == '#') continue;
+            // コメント行・空行をスキップ
+            if (line.empty()) continue;
             
-            // セクション判定（インデントなしの行）
-            if (line.find(':') != std::string::npos && line[0] != ' ') {
-                size_t colon_pos = line.find(':');
-                std::string key = trim(line.substr(0, colon_pos));
-                std::string value = trim(line.substr(colon_pos + 1));
-                
-                if (!value.empty()) {
-                    config[key] = value;
-                } else {
-                    current_section = key + ".";
-                }
+            size_t colon_pos = line.find(':');
+            if (colon_pos == std::string::npos) continue;
+            
+            std::string key = trim(line.substr(0, colon_pos));
+            std::string value = unquote(trim(line.substr(colon_pos + 1)));
+            
+            // インデントが同じか浅くなったら、そのセクションを閉じる
+            while (!sections.empty() && indent <= sections.back().first) {
+                sections.pop_back();
             }
-            // サブキー（インデント有り）
-            else if (line[0] == ' ' && line.find(':') != std::string::npos) {
-                size_t colon_pos = line.find(':');
-                std::string key = trim(line.substr(0, colon_pos));
-                std::string value = trim(line.substr(colon_pos + 1));
-                
-                config[current_section + key] = value;
+            std::string prefix = sections.empty() ? "" : sections.back().second;
+            
+            // 値の無いキーはセクション、値のあるキーは現在のセクションの下の設定
+            if (value.empty()) {
+                sections.emplace_back(indent, prefix + key + ".");
+            } else {
+                config[prefix + key] = value;
             }
         }
         
@@ -100,6 +101,30 @@ public:
     }
 
 private:
+    // 行末コメントを除去（引用符内の#は残す）
+    static std::string strip_comment(const std::string& str) {
+        char quote = 0;
+        for (size_t i = 0; i < str.size(); ++i) {
+            char c = str[i];
+            if (quote) {
+                if (c == quote) quote = 0;
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else if (c == '#' && (i == 0 || str[i - 1] == ' ' || str[i - 1] == '\t')) {
+                return str.substr(0, i);
+            }
+        }
+        return str;
+    }
+    
+    // 値を囲む引用符を除去
+    static std::string unquote(const std::string& str) {
+        if (str.size() >= 2 && (str.front() == '"' || str.front() == '\'') && str.back() == str.front()) {
+            return str.substr(1, str.size() - 2);
+        }
+        return str;
+    }
+    
     static std::string trim(const std::string& str) {
         size_t start = str.find_first_not_of(" \t\r\n");
         if (start == std::string::npos) return "";
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "core/bit_field.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// 全消し探索
+// 見えているツモは全配置の最大値、その先の未知のツモは色の組み合わせの期待値（expectimax）で
+// 全消しできる確率を求める。色ごとの個数をビットボードのpopcountで数え、
+// 4個に届かない色が残る局面（全消し不可能）を展開前に枝刈りする。
+class AllClearFinder {
+public:
+    using PairList = std::vector<std::pair<PuyoColor, PuyoColor>>;
+
+    struct Config {
+        int extra_depth;       // 見えているツモの先に読む未知ツモの数
+        double decay;          // 1手遅れるごとの割引率（早い全消しを優先）
+        long long max_nodes;   // 展開局面数の上限
+        double time_limit_ms;  // 探索時間の上限
+
+        Config() : extra_depth(1), decay(0.95), max_nodes(300000), time_limit_ms(50.0) {}
+    };
+
+    struct Result {
+        bool found;            // 全消しの可能性がある手があったか
+        int x;
+        int r;
+        double value;          // 割引後の全消し確率
+        int clear_ply;         // 確定で全消しできる最短手数（0始まり、無ければ-1）
+        long long nodes;       // 展開した局面数
+        long long pruned;      // 色数で枝刈りした局面数
+        long long memo_hits;   // 置換表で省略した局面数
+        bool truncated;        // 上限で打ち切ったか
+        double elapsed_ms;
+
+        Result() : found(false), x(-1), r(-1), value(0.0), clear_ply(-1), nodes(0), pruned(0),
+                   memo_hits(0), truncated(false), elapsed_ms(0.0) {}
+    };
+
+    AllClearFinder() = default;
+    explicit AllClearFinder(const Config& config) : config_(config) {}
+
+    void set_config(const Config& config) { config_ = config; }
+    const Config& get_config() const { return config_; }
+
+    // 全消しを狙う初手を探す（pairs[0]が現在のツモ）
+    Result find(const BitField& root, const PairList& pairs) {
+        auto start_time = std::chrono::steady_clock::now();
+        deadline_ = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(config_.time_limit_ms));
+
+        result_ = Result();
+        pairs_ = &pairs;
+        visible_ = static_cast<int>(pairs.size());
+        total_depth_ = visible_ + std::max(0, config_.extra_depth);
+        memo_.clear();
+
+        // 各手数以降の見えているツモに含まれる色ごとの個数
+        remaining_.assign(visible_ + 1, {});
+        for (int depth = visible_ - 1; depth >= 0; --depth) {
+            remaining_[depth] = remaining_[depth + 1];
+            remaining_[depth][color_slot(pairs[depth].first)]++;
+            remaining_[depth][color_slot(pairs[depth].second)]++;
+        }
+
+        if (visible_ > 0) {
+            int best_index = -1;
+            result_.value = search_known(root, 0, &best_index);
+            if (best_index >= 0 && result_.value > 0.0) {
+                result_.found = true;
+                result_.x = PLACEMENTS[best_index].x;
+                result_.r = PLACEMENTS[best_index].r;
+                result_.clear_ply = certain_clear_ply(result_.value);
+            }
+        }
+
+        result_.elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_time).count();
+        return result_;
+    }
+
+    // 盤面と残りのツモで全消しが不可能でないか（色ごとの不足数の合計が置けるぷよ数以内か）
+    // 4個以上ある色は連結すれば消せるため、1〜3個しかない色の不足分だけを数える。
+    static bool can_still_clear(const BitField& field, const std::array<int, 5>& known_colors, int unknown_pairs) {
+        int deficit = 0;
+        for (int slot = 0; slot < 5; ++slot) {
+            int count = field.count_color(static_cast<PuyoColor>(slot + 1)) + known_colors[slot];
+            if (count > 0 && count < 4) {
+                deficit += 4 - count;
+            }
+        }
+        return deficit <= unknown_pairs * 2;
+    }
+
+private:
+    // 未知ツモの色の組み合わせ（4色、順不同10通り）
+    static constexpr PuyoColor CHANCE_COLORS[4] = {PuyoColor::RED, PuyoColor::GREEN,
+                                                   PuyoColor::BLUE, PuyoColor::YELLOW};
+
+    Config config_;
+    Result result_;
+    const PairList* pairs_ = nullptr;
+    int visible_ = 0;
+    int total_depth_ = 0;
+    std::vector<std::array<int, 5>> remaining_;
+    std::unordered_map<uint64_t, double> memo_;   // (盤面, 手数) -> 全消し確率
+    std::chrono::steady_clock::time_point deadline_;
+
+    static int color_slot(PuyoColor color) {
+        int slot = static_cast<int>(color) - 1;
+        return std::max(0, std::min(4, slot));
+    }
+
+    static uint64_t memo_key(const BitField& field, int depth) {
+        return field.hash() ^ (static_cast<uint64_t>(depth + 1) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    // 割引後の値が1手目からの確定全消しなら、その手数を返す
+    int certain_clear_ply(double value) const {
+        for (int ply = 0; ply < total_depth_; ++ply) {
+            if (std::abs(value - std::pow(config_.decay, ply)) < 1e-9) return ply;
+        }
+        return -1;
+    }
+
+    bool out_of_budget() {
+        if (result_.nodes >= config_.max_nodes ||
+            ((result_.nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline_)) {
+            result_.truncated = true;
+        }
+        return result_.truncated;
+    }
+
+    // 1手置いた後の値
+    double evaluate_child(const BitField& field, int depth, int index, PuyoColor axis, PuyoColor child,
+                          bool& valid) {
+        const Placement& placement = PLACEMENTS[index];
+        BitField next = field;
+        BitChainResult result = next.place_and_simulate(placement.x, placement.r, axis, child);
+        valid = result.chain_count >= 0 && !next.is_game_over();
+        if (!valid) return 0.0;
+
+        result_.nodes++;
+        if (result.all_clear) return std::pow(config_.decay, depth);
+        return search(next, depth + 1);
+    }
+
+    // 盤面の値（手数depthのツモを置く前）
+    double search(const BitField& field, int depth) {
+        if (depth >= total_depth_ || out_of_budget()) return 0.0;
+
+        int unknown_pairs = total_depth_ - std::max(depth, visible_);
+        const std::array<int, 5>& known = remaining_[std::min(depth, visible_)];
+        if (!can_still_clear(field, known, unknown_pairs)) {
+            result_.pruned++;
+            return 0.0;
+        }
+
+        uint64_t key = memo_key(field, depth);
+        auto it = memo_.find(key);
+        if (it != memo_.end()) {
+            result_.memo_hits++;
+            return it->second;
+        }
+
+        double value = depth < visible_ ? search_known(field, depth, nullptr) : search_chance(field, depth);
+        if (!result_.truncated) {
+            memo_.emplace(key, value);
+        }
+        return value;
+    }
+
+    // 見えているツモ：全配置の最大値
+    double search_known(const BitField& field, int depth, int* best_index) {
+        const auto& pair = (*pairs_)[depth];
+        double best = 0.0;
+        double upper = std::pow(config_.decay, depth);  // この手数で得られる最大値
+
+        for (int index = 0; index < PLACEMENT_COUNT; ++index) {
+            bool valid = false;
+            double value = evaluate_child(field, depth, index, pair.first, pair.second, valid);
+            if (!valid) continue;
+            if (best_index && *best_index < 0) *best_index = index;
+            if (value > best) {
+                best = value;
+                if (best_index) *best_index = index;
+                if (best >= upper - 1e-12) break;
+            }
+            if (result_.truncated) break;
+        }
+        return best;
+    }
+
+    // 未知のツモ：色の組み合わせごとの最大値の期待値
+    double search_chance(const BitField& field, int depth) {
+        double expected = 0.0;
+        double upper = std::pow(config_.decay, depth);
+
+        for (int a = 0; a < 4; ++a) {
+            for (int b = a; b < 4; ++b) {
+                double probability = (a == b ? 1.0 : 2.0) / 16.0;
+                double best = 0.0;
+                for (int index = 0; index < PLACEMENT_COUNT; ++index) {
+                    bool valid = false;
+                    double value = evaluate_child(field, depth, index, CHANCE_COLORS[a], CHANCE_COLORS[b], valid);
+                    if (value > best) {
+                        best = value;
+                        if (best >= upper - 1e-12) break;
+                    }
+                    if (result_.truncated) return expected;
+                }
+                expected += probability * best;
+            }
+        }
+        return expected;
+    }
+};
+
+} // namespace ai
+} // namespace puyo
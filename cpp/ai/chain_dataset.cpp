@@ -0,0 +1,145 @@
+#include "chain_dataset.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+namespace puyo {
+namespace ai {
+
+namespace {
+
+constexpr char DATASET_MAGIC[8] = {'P', 'U', 'Y', 'O', 'C', 'H', 'D', 'S'};
+constexpr int CELL_BITS = 3;
+
+// 出現順（列ごとに下から）の色の振り直し表（おじゃまは固定）
+class ColorRemap {
+public:
+    ColorRemap() : table_{}, next_id_(1) {}
+
+    PuyoColor assign(PuyoColor color) {
+        if (color == PuyoColor::EMPTY || color == PuyoColor::GARBAGE) return color;
+        uint8_t& id = table_[static_cast<int>(color)];
+        if (id == 0) id = next_id_++;
+        return static_cast<PuyoColor>(id);
+    }
+
+private:
+    std::array<uint8_t, COLOR_COUNT + 1> table_;
+    uint8_t next_id_;
+};
+
+// 色を振り直した盤面（mirrorなら左右反転）
+BitField normalize(const BitField& field, bool mirror, ColorRemap& remap) {
+    BitField normalized;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        int source_x = mirror ? FIELD_WIDTH - 1 - x : x;
+        for (int y = 0; y < ChainDataset::STORED_ROWS; ++y) {
+            PuyoColor color = field.get_puyo(source_x, y);
+            if (color == PuyoColor::EMPTY) break;
+            normalized.set_puyo(x, y, remap.assign(color));
+        }
+    }
+    return normalized;
+}
+
+void set_cell(uint8_t* cells, int index, uint8_t value) {
+    int bit = index * CELL_BITS;
+    for (int i = 0; i < CELL_BITS; ++i, ++bit) {
+        if (value & (1 << i)) cells[bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+    }
+}
+
+uint8_t get_cell(const uint8_t* cells, int index) {
+    int bit = index * CELL_BITS;
+    uint8_t value = 0;
+    for (int i = 0; i < CELL_BITS; ++i, ++bit) {
+        if (cells[bit / 8] & (1 << (bit % 8))) value |= static_cast<uint8_t>(1 << i);
+    }
+    return value;
+}
+
+} // namespace
+
+ChainDatasetRecord ChainDataset::encode(const BitField& field, const ChainPotential& potential) {
+    static_assert(FIELD_WIDTH * STORED_ROWS * CELL_BITS <= static_cast<int>(sizeof(ChainDatasetRecord::cells)) * 8,
+                  "cells must hold the stored rows");
+
+    ColorRemap remap;
+    BitField normalized = normalize(field, false, remap);
+
+    ChainDatasetRecord record;
+    std::memset(&record, 0, sizeof(record));
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        for (int y = 0; y < STORED_ROWS; ++y) {
+            set_cell(record.cells, x * STORED_ROWS + y, static_cast<uint8_t>(normalized.get_puyo(x, y)));
+        }
+    }
+
+    record.score = static_cast<uint32_t>(std::max(0, potential.score));
+    record.chain_count = static_cast<uint8_t>(std::max(0, potential.chain_count));
+    record.added = static_cast<uint8_t>(std::max(0, potential.added));
+    record.trigger_x = static_cast<uint8_t>(std::max(0, potential.x));
+    record.trigger_color = static_cast<uint8_t>(potential.x >= 0 ? remap.assign(potential.color) : PuyoColor::EMPTY);
+    return record;
+}
+
+BitField ChainDataset::decode_field(const ChainDatasetRecord& record) {
+    BitField field;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        for (int y = 0; y < STORED_ROWS; ++y) {
+            uint8_t value = get_cell(record.cells, x * STORED_ROWS + y);
+            if (value != 0) {
+                field.set_puyo(x, y, static_cast<PuyoColor>(value));
+            }
+        }
+    }
+    return field;
+}
+
+uint64_t ChainDataset::canonical_hash(const BitField& field) {
+    ColorRemap remap;
+    ColorRemap mirror_remap;
+    uint64_t hash = normalize(field, false, remap).hash();
+    uint64_t mirror_hash = normalize(field, true, mirror_remap).hash();
+    return std::min(hash, mirror_hash);
+}
+
+bool ChainDataset::write_shard(const std::string& path, const std::vector<ChainDatasetRecord>& records) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    Header header{};
+    std::memcpy(header.magic, DATASET_MAGIC, sizeof(DATASET_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.record_count = static_cast<uint32_t>(records.size());
+    header.record_size = sizeof(ChainDatasetRecord);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(ChainDatasetRecord)));
+    return static_cast<bool>(file);
+}
+
+bool ChainDataset::read_shard(const std::string& path, std::vector<ChainDatasetRecord>& records) {
+    records.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    Header header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, DATASET_MAGIC, sizeof(DATASET_MAGIC)) != 0) return false;
+    if (header.version != FORMAT_VERSION || header.record_size != sizeof(ChainDatasetRecord)) return false;
+
+    records.resize(header.record_count);
+    file.read(reinterpret_cast<char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(ChainDatasetRecord)));
+    if (!file) {
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace ai
+} // namespace puyo
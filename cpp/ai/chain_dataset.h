@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/bit_field.h"
+#include "core/puyo_types.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// 連鎖形データセットのレコード（40バイト）
+// 盤面は1〜13段目の78マスを1マス3ビットで詰めて格納する（x * 13 + y番目のマス）。
+// 色は出現順に振り直した正規化済みの番号で、発火色も同じ対応で振り直す。
+struct ChainDatasetRecord {
+    uint32_t score;          // 発火したときの連鎖の得点
+    uint8_t cells[30];       // 盤面（3ビット × 78マス）
+    uint8_t chain_count;     // 発火したときの連鎖数
+    uint8_t added;           // 発火に必要な追加ぷよ数
+    uint8_t trigger_x;       // 発火列
+    uint8_t trigger_color;   // 発火色（正規化済み）
+    uint16_t reserved;
+};
+static_assert(sizeof(ChainDatasetRecord) == 40, "ChainDatasetRecord must be 40 bytes");
+
+// 連鎖形データセットのシャードファイル
+//
+// ファイル形式（リトルエンディアン）:
+//   Header（32バイト） + ChainDatasetRecord × record_count
+class ChainDataset {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr int STORED_ROWS = FIELD_HEIGHT - 1;  // 14段目は格納しない
+
+    struct Header {
+        char magic[8];          // "PUYOCHDS"
+        uint32_t version;
+        uint32_t record_count;
+        uint32_t record_size;
+        uint32_t reserved[3];
+    };
+    static_assert(sizeof(Header) == 32, "ChainDataset::Header must be 32 bytes");
+
+    // 盤面と発火情報からレコードを作る（色は正規化する）
+    static ChainDatasetRecord encode(const BitField& field, const ChainPotential& potential);
+    static BitField decode_field(const ChainDatasetRecord& record);
+
+    // 色の振り直しと左右反転で同じになる盤面が同じ値になるハッシュ
+    static uint64_t canonical_hash(const BitField& field);
+
+    static bool write_shard(const std::string& path, const std::vector<ChainDatasetRecord>& records);
+    static bool read_shard(const std::string& path, std::vector<ChainDatasetRecord>& records);
+};
+
+} // namespace ai
+} // namespace puyo
@@ -2,13 +2,21 @@
 
 #include "ai_base.h"
 #include "ai_utils.h"
+#include "move_ordering.h"
+#include "pattern_matcher.h"
+#include "exact_solver.h"
+#include "all_clear_finder.h"
 #include "core/field.h"
+#include "core/bit_field.h"
+#include "core/garbage_system.h"
 #include <vector>
 #include <memory>
 #include <climits>
 #include <map>
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <optional>
 
 namespace puyo {
 namespace ai {
@@ -33,13 +41,14 @@ private:
         double color_balance;
         double height_penalty;
         double gameover_penalty;
+        double chain_form;
         
         EvaluationWeights() : chain_potential(15.0), chain_trigger(25.0), 
                              next_compatibility(8.0), u_shape_bonus(12.0),
                              center_preference(3.0), height_balance(4.0),
                              stability(6.0), color_grouping(10.0),
                              color_balance(2.0), height_penalty(-20.0),
-                             gameover_penalty(-100.0) {}
+                             gameover_penalty(-100.0), chain_form(1.0) {}
     } weights_;
     
     // U字型評価設定
@@ -63,6 +72,72 @@ private:
                          chain_timing_threshold(8) {}
     } chain_strategy_;
     
+    // 手順序付け（履歴・キラー・事前評価、重複手・自殺手の除外）
+    MoveOrderer move_orderer_;
+    
+    // 連鎖形パターン（GTR・階段・挟み込みなど）
+    PatternMatcher chain_patterns_;
+    bool hot_reload_patterns_;
+    
+    // 対戦設定（相手盤面の解析）
+    struct VersusConfig {
+        bool enabled;
+        double budget_fraction;      // 相手解析に使う思考時間の割合
+        int max_added;               // 相手ポテンシャル計算で追加するぷよ数の上限
+        int threat_chain;            // 脅威とみなす相手の連鎖数
+        int threat_turns;            // 脅威とみなす発火までの手数
+        double counter_weight;       // 脅威時に発火する手への加点（連鎖数あたり）
+        double premature_penalty;    // 脅威がない時に小連鎖を撃つ手へのペナルティ
+        
+        VersusConfig() : enabled(true), budget_fraction(0.2), max_added(2), threat_chain(3),
+                        threat_turns(1), counter_weight(40.0), premature_penalty(-30.0) {}
+    } versus_;
+    
+    // 予告おじゃまぷよ設定
+    struct GarbageConfig {
+        bool enabled;
+        double drop_weight;          // 降ってくるおじゃま1個あたり
+        double offset_weight;        // 相殺したおじゃま1個あたり
+        double full_offset_bonus;    // 全て相殺できる手への加点
+        double overflow_penalty;     // 降下後に窒息する手へのペナルティ
+        
+        GarbageConfig() : enabled(true), drop_weight(-2.0), offset_weight(3.0),
+                         full_offset_bonus(50.0), overflow_penalty(-1000.0) {}
+    } garbage_;
+    
+    // 厳密解法モード（見えているツモの全配置列を列挙）
+    struct SolverConfig {
+        bool enabled;
+        ExactSolver::Objective objective;
+        int depth;                   // 列挙するツモ数（現在 + NEXT + NEXT-NEXT）
+        
+        SolverConfig() : enabled(false), objective(ExactSolver::Objective::MAX_CHAIN), depth(3) {}
+    } solver_config_;
+    ExactSolver exact_solver_;
+    ExactSolver::Result last_solver_result_;
+    
+    // 全消し探索モード（序盤の全消しを狙う）
+    struct AllClearConfig {
+        bool enabled;
+        int max_puyos;               // 盤面のぷよ数がこれ以下のときだけ探索する
+        double min_value;            // 採用する割引後の全消し確率の下限
+        
+        AllClearConfig() : enabled(false), max_puyos(24), min_value(0.5) {}
+    } all_clear_config_;
+    AllClearFinder all_clear_finder_;
+    AllClearFinder::Result last_all_clear_result_;
+    
+    // 相手盤面の解析結果（相手の盤面が変わるまで再利用）
+    struct OpponentAnalysis {
+        bool valid;
+        uint64_t field_hash;
+        ChainPotential potential;    // 相手が撃てる最大連鎖
+        int fire_turns;              // 発火までの手数（撃てなければ-1）
+        bool threat;
+        
+        OpponentAnalysis() : valid(false), field_hash(0), fire_turns(-1), threat(false) {}
+    } opponent_;
+    
     // デバッグ設定
     bool verbose_evaluation_;
     bool show_position_scores_;
@@ -70,7 +145,7 @@ private:
     
 public:
     ChainSearchAI(const AIParameters& params = {}) 
-        : AIBase("ChainSearchAI"), verbose_evaluation_(false), 
+        : AIBase("ChainSearchAI"), hot_reload_patterns_(true), verbose_evaluation_(false), 
           show_position_scores_(false), log_chain_analysis_(true) {
         
         // パラメータの設定
@@ -89,10 +164,13 @@ public:
         return AIBase::initialize();
     }
     
-    // YAML設定ファイル読み込み
+    // YAML設定ファイル読み込み（AIParametersで同名キーを上書き可能）
     void load_configuration() {
         std::string config_path = "config/ai_params/chain_search.yaml";
         auto config = ConfigLoader::load_config(config_path);
+        for (const auto& param : get_all_parameters()) {
+            config[param.first] = param.second;
+        }
         
         // 基本パラメータ
         search_depth_ = ConfigLoader::get_int(config, "search_depth", 4);
@@ -113,6 +191,7 @@ public:
         weights_.color_balance = ConfigLoader::get_double(config, "evaluation_weights.color_balance", 2.0);
         weights_.height_penalty = ConfigLoader::get_double(config, "evaluation_weights.height_penalty", -20.0);
         weights_.gameover_penalty = ConfigLoader::get_double(config, "evaluation_weights.gameover_penalty", -100.0);
+        weights_.chain_form = ConfigLoader::get_double(config, "evaluation_weights.chain_form", 1.0);
         
         // U字型設定
         u_config_.ideal_height_diff = ConfigLoader::get_int(config, "u_shape_evaluation.ideal_height_diff", 3);
@@ -123,6 +202,57 @@ public:
         chain_strategy_.multi_color_chains = ConfigLoader::get_bool(config, "chain_strategy.multi_color_chains", true);
         chain_strategy_.chain_timing_threshold = ConfigLoader::get_int(config, "chain_strategy.chain_timing_threshold", 8);
         
+        // 手順序付け
+        MoveOrderer::Config ordering;
+        ordering.prune_duplicates = ConfigLoader::get_bool(config, "move_ordering.prune_duplicates", true);
+        ordering.prune_suicidal = ConfigLoader::get_bool(config, "move_ordering.prune_suicidal", true);
+        ordering.adjacency_weight = ConfigLoader::get_double(config, "move_ordering.adjacency_weight", 1.0);
+        ordering.height_weight = ConfigLoader::get_double(config, "move_ordering.height_weight", 0.3);
+        ordering.chain_weight = ConfigLoader::get_double(config, "move_ordering.chain_weight", 2.0);
+        move_orderer_.set_config(ordering);
+        
+        // 連鎖形パターンライブラリ（テキストまたはcompile_patternsの出力）
+        chain_patterns_.load(ConfigLoader::get_string(config, "chain_patterns.path", "config/patterns/chain_forms.txt"));
+        hot_reload_patterns_ = ConfigLoader::get_bool(config, "chain_patterns.hot_reload", true);
+        
+        // 対戦設定
+        versus_.enabled = ConfigLoader::get_bool(config, "versus.enabled", true);
+        versus_.budget_fraction = std::max(0.0, std::min(1.0, ConfigLoader::get_double(config, "versus.budget_fraction", 0.2)));
+        versus_.max_added = std::max(1, ConfigLoader::get_int(config, "versus.max_added", 2));
+        versus_.threat_chain = ConfigLoader::get_int(config, "versus.threat_chain", 3);
+        versus_.threat_turns = ConfigLoader::get_int(config, "versus.threat_turns", 1);
+        versus_.counter_weight = ConfigLoader::get_double(config, "versus.counter_weight", 40.0);
+        versus_.premature_penalty = ConfigLoader::get_double(config, "versus.premature_penalty", -30.0);
+        
+        // 予告おじゃまぷよ設定
+        garbage_.enabled = ConfigLoader::get_bool(config, "garbage.enabled", true);
+        garbage_.drop_weight = ConfigLoader::get_double(config, "garbage.drop_weight", -2.0);
+        garbage_.offset_weight = ConfigLoader::get_double(config, "garbage.offset_weight", 3.0);
+        garbage_.full_offset_bonus = ConfigLoader::get_double(config, "garbage.full_offset_bonus", 50.0);
+        garbage_.overflow_penalty = ConfigLoader::get_double(config, "garbage.overflow_penalty", -1000.0);
+        
+        // 厳密解法モード
+        solver_config_.enabled = ConfigLoader::get_bool(config, "solver.enabled", false);
+        solver_config_.objective = ExactSolver::parse_objective(
+            ConfigLoader::get_string(config, "solver.objective", "max_chain"));
+        solver_config_.depth = std::max(1, std::min(3, ConfigLoader::get_int(config, "solver.depth", 3)));
+        
+        // 全消し探索モード
+        all_clear_config_.enabled = ConfigLoader::get_bool(config, "all_clear.enabled", false);
+        all_clear_config_.max_puyos = ConfigLoader::get_int(config, "all_clear.max_puyos", 24);
+        all_clear_config_.min_value = ConfigLoader::get_double(config, "all_clear.min_value", 0.5);
+        AllClearFinder::Config finder_config;
+        finder_config.extra_depth = ConfigLoader::get_int(config, "all_clear.extra_depth", 1);
+        finder_config.decay = ConfigLoader::get_double(config, "all_clear.decay", 0.95);
+        finder_config.max_nodes = ConfigLoader::get_int(config, "all_clear.max_nodes", 300000);
+        finder_config.time_limit_ms = ConfigLoader::get_double(config, "all_clear.time_limit_ms", 50.0);
+        all_clear_finder_.set_config(finder_config);
+        
+        // 定跡ブック
+        if (ConfigLoader::get_bool(config, "opening_book.enabled", true)) {
+            load_opening_book(ConfigLoader::get_string(config, "opening_book.path", "data/opening_book.bin"));
+        }
+        
         // デバッグ設定
         verbose_evaluation_ = ConfigLoader::get_bool(config, "debug.verbose_evaluation", false);
         show_position_scores_ = ConfigLoader::get_bool(config, "debug.show_position_scores", false);
@@ -131,6 +261,7 @@ public:
     
     AIDecision think(const GameState& state) override {
         auto start_time = std::chrono::high_resolution_clock::now();
+        double time_limit_ms = think_budget_ms(think_time_limit_);
         
         if (!initialized_) {
             return AIDecision(-1, 0, {}, 0.0, "AI not initialized");
@@ -140,8 +271,10 @@ public:
             return AIDecision(-1, 0, {}, 0.0, "Field not available");
         }
         
-        // フィールド分析情報を更新
-        auto analysis = calculate_field_analysis(*state.own_field);
+        // 局面単位の特徴量キャッシュ（全候補手で共有）
+        EvaluationContext context(*state.own_field, *this);
+        context.field_analysis = calculate_field_analysis(*state.own_field);
+        const auto& analysis = *context.field_analysis;
         
         // 配置可能な全位置を取得
         auto valid_positions = get_all_valid_positions(*state.own_field);
@@ -150,25 +283,69 @@ public:
             return AIDecision(-1, 0, {}, 0.0, "No valid positions available");
         }
         
+        // 全消しできる見込みが高ければ定跡より優先する
+        if (all_clear_config_.enabled) {
+            AIDecision all_clear_decision;
+            if (try_all_clear(state, time_limit_ms, all_clear_decision)) {
+                return all_clear_decision;
+            }
+        }
+        
+        // 序盤は定跡ブックの手を使い、思考時間を中盤以降に回す
+        AIDecision book_decision;
+        if (try_opening_book(state, book_decision)) {
+            return book_decision;
+        }
+        
+        // 厳密解法モード：見えているツモの範囲で最良の配置列を求める
+        if (solver_config_.enabled) {
+            AIDecision solver_decision;
+            if (solve_exact(state, solver_decision)) {
+                return solver_decision;
+            }
+        }
+        
+        // パターンライブラリが書き換えられていれば読み直す
+        if (hot_reload_patterns_) {
+            chain_patterns_.reload_if_changed();
+        }
+        
+        // 有望な手から評価する（時間切れでも良い手を評価済みにするため）
+        auto candidates = move_orderer_.generate(BitField::from_field(*state.own_field),
+                                                 state.current_pair.axis, state.current_pair.child);
+        
+        // 対戦時は相手の発火可能連鎖を解析（予算内、相手盤面が変わった時のみ）
+        const OpponentAnalysis* opponent = nullptr;
+        if (versus_.enabled && state.is_versus_mode && state.opponent_field) {
+            opponent = &analyze_opponent(*state.opponent_field, start_time, time_limit_ms);
+        }
+        
         // 高度な評価による最良手選択
         std::pair<int, int> best_move = {-1, -1};
+        int best_index = -1;
         double best_score = -std::numeric_limits<double>::max();
         std::string best_reason = "";
         
-        for (const auto& pos : valid_positions) {
-            // 時間制限チェック
+        for (const auto& candidate : candidates) {
+            const Placement& placement = PLACEMENTS[candidate.index];
+            std::pair<int, int> pos = {placement.x, placement.r};
+            
+            // 時間制限・中止要求チェック（最低1手は評価して、その時点の最善手を返す）
             auto current_time = std::chrono::high_resolution_clock::now();
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - start_time);
-            if (elapsed.count() > think_time_limit_) {
+            if (best_index >= 0 && (elapsed.count() > time_limit_ms || should_stop())) {
                 break; // 時間切れ
             }
             
             // 高度な評価関数による評価
-            auto eval_result = evaluate_position_advanced(*state.own_field, pos.first, pos.second, state);
+            auto eval_result = evaluate_position_advanced(context, pos.first, pos.second, state, candidate, opponent);
             
-            if (eval_result.total_score > best_score) {
+            // 同点は配置順の早い手を優先（並べ替えだけでは選ぶ手が変わらないように）
+            if (eval_result.total_score > best_score ||
+                (eval_result.total_score == best_score && candidate.index < best_index)) {
                 best_score = eval_result.total_score;
                 best_move = pos;
+                best_index = candidate.index;
                 best_reason = eval_result.reason;
             }
             
@@ -193,8 +370,14 @@ public:
         auto end_time = std::chrono::high_resolution_clock::now();
         auto think_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
         
+        const auto& ordering_stats = move_orderer_.last_stats();
         std::string reason = "ChainSearch[depth=" + std::to_string(search_depth_) + 
                            ", score=" + std::to_string(best_score) + 
+                           ", pruned=" + std::to_string(ordering_stats.pruned_duplicate + ordering_stats.pruned_suicidal) +
+                           "/" + std::to_string(ordering_stats.generated) + 
+                           (opponent ? ", opp=" + std::to_string(opponent->potential.chain_count) + "chain/" +
+                                       std::to_string(opponent->fire_turns) + "turn" : std::string()) +
+                           (state.garbage.pending > 0 ? ", garbage=" + std::to_string(state.garbage.pending) : std::string()) +
                            ", time=" + std::to_string(think_duration.count()) + "ms]: " + 
                            best_reason;
         
@@ -214,8 +397,80 @@ public:
     int get_think_time_ms() const override {
         return think_time_limit_;
     }
+    
+    // 直近の厳密解法の結果（壁時計時間・局面数を含む）
+    const ExactSolver::Result& last_solver_result() const {
+        return last_solver_result_;
+    }
+    
+    // 直近の全消し探索の結果
+    const AllClearFinder::Result& last_all_clear_result() const {
+        return last_all_clear_result_;
+    }
+    
+    void clear_search_cache() override {
+        move_orderer_.clear();
+        opponent_ = OpponentAnalysis();
+    }
 
 private:
+    // 局面評価コンテキスト
+    // 候補手に依存しないフィールド全体の特徴量を局面ごとに1回だけ計算し、遅延キャッシュする
+    struct EvaluationContext {
+        const Field* field;
+        std::array<int, FIELD_WIDTH> column_heights;  // 列の高さ（常に前計算）
+        
+        // 遅延計算される全体特徴量
+        std::optional<double> color_balance;
+        std::optional<double> u_shape;
+        std::optional<int> potential_chains;
+        std::optional<double> stability;
+        std::optional<GameState::FieldAnalysis> field_analysis;
+        std::optional<bool> trigger_chain;
+        
+        EvaluationContext(const Field& f, const ChainSearchAI& ai) : field(&f) {
+            for (int x = 0; x < FIELD_WIDTH; ++x) {
+                column_heights[x] = ai.get_column_height(f, x);
+            }
+        }
+    };
+    
+    // キャッシュ済み特徴量の取得
+    double cached_color_balance(EvaluationContext& ctx) const {
+        if (!ctx.color_balance) {
+            ctx.color_balance = FieldAnalyzer::evaluate_color_balance(*ctx.field);
+        }
+        return *ctx.color_balance;
+    }
+    
+    double cached_u_shape(EvaluationContext& ctx) const {
+        if (!ctx.u_shape) {
+            ctx.u_shape = FieldAnalyzer::evaluate_u_shape(*ctx.field);
+        }
+        return *ctx.u_shape;
+    }
+    
+    int cached_potential_chains(EvaluationContext& ctx) const {
+        if (!ctx.potential_chains) {
+            ctx.potential_chains = FieldAnalyzer::count_potential_chains(*ctx.field);
+        }
+        return *ctx.potential_chains;
+    }
+    
+    double cached_stability(EvaluationContext& ctx) const {
+        if (!ctx.stability) {
+            ctx.stability = evaluate_field_stability(ctx.column_heights);
+        }
+        return *ctx.stability;
+    }
+    
+    const GameState::FieldAnalysis& cached_field_analysis(EvaluationContext& ctx) const {
+        if (!ctx.field_analysis) {
+            ctx.field_analysis = calculate_field_analysis(*ctx.field);
+        }
+        return *ctx.field_analysis;
+    }
+    
     // 評価結果構造体
     struct EvaluationResult {
         double total_score;
@@ -223,26 +478,34 @@ private:
         double u_shape_score;
         double next_score;
         double stability_score;
+        double chain_form_score;
+        double versus_score;
+        double garbage_score;
         std::string reason;
         
         EvaluationResult() : total_score(0.0), chain_score(0.0), u_shape_score(0.0),
-                           next_score(0.0), stability_score(0.0) {}
+                           next_score(0.0), stability_score(0.0), chain_form_score(0.0),
+                           versus_score(0.0), garbage_score(0.0) {}
     };
     
     // 高度な位置評価関数（ネクスト情報・U字型・連鎖ポテンシャルを考慮）
-    EvaluationResult evaluate_position_advanced(const Field& field, int x, int r, const GameState& state) {
+    // 全体項はcontextのキャッシュを使い、候補手ごとには配置差分のみを計算する
+    EvaluationResult evaluate_position_advanced(EvaluationContext& ctx, int x, int r, const GameState& state,
+                                                const MoveOrderer::Candidate& candidate,
+                                                const OpponentAnalysis* opponent) {
         EvaluationResult result;
+        const Field& field = *ctx.field;
         
         // 1. 基本評価（中央寄り・高さ）
-        double basic_score = evaluate_basic_position(field, x, r);
+        double basic_score = evaluate_basic_position(ctx, x, r);
         result.total_score += basic_score;
         
         // 2. U字型評価
-        result.u_shape_score = evaluate_u_shape_contribution(field, x, r);
+        result.u_shape_score = evaluate_u_shape_contribution(ctx, x, r);
         result.total_score += result.u_shape_score * weights_.u_shape_bonus;
         
         // 3. 連鎖ポテンシャル評価
-        result.chain_score = evaluate_chain_potential_contribution(field, x, r);
+        result.chain_score = evaluate_chain_potential_contribution(ctx, x, r);
         result.total_score += result.chain_score * weights_.chain_potential;
         
         // 4. ネクスト互換性評価（ネクスト情報を活用）
@@ -252,31 +515,201 @@ private:
         }
         
         // 5. フィールド安定性
-        result.stability_score = evaluate_field_stability(field, x);
+        result.stability_score = cached_stability(ctx);
         result.total_score += result.stability_score * weights_.stability;
         
         // 6. 色バランス評価
-        double color_score = FieldAnalyzer::evaluate_color_balance(field) * weights_.color_balance;
+        double color_score = cached_color_balance(ctx) * weights_.color_balance;
         result.total_score += color_score;
         
         // 7. ゲームオーバー回避
-        int height = get_column_height(field, x);
+        int height = ctx.column_heights[x];
         if (height >= FIELD_HEIGHT - 2) {
             result.total_score += weights_.gameover_penalty;
         }
         
         // 8. 連鎖発火タイミング判定
-        if (should_trigger_chain(field, state)) {
-            double trigger_bonus = evaluate_chain_trigger_potential(field) * weights_.chain_trigger;
+        if (should_trigger_chain(ctx, state)) {
+            double trigger_bonus = evaluate_chain_trigger_potential(ctx) * weights_.chain_trigger;
             result.total_score += trigger_bonus;
         }
         
+        // 9. 連鎖形パターン（配置後の盤面で照合）
+        result.chain_form_score = chain_patterns_.score(candidate.field);
+        result.total_score += result.chain_form_score * weights_.chain_form;
+        
+        // 10. 対戦：相手の発火可能連鎖に応じて発火・構築を調整
+        if (opponent) {
+            result.versus_score = evaluate_versus(candidate.chain, *opponent);
+            result.total_score += result.versus_score;
+        }
+        
+        // 11. 予告おじゃまぷよ：相殺後の残りを降らせた盤面で評価
+        if (garbage_.enabled && state.garbage.pending > 0) {
+            result.garbage_score = evaluate_garbage(candidate, state.garbage.pending);
+            result.total_score += result.garbage_score;
+        }
+        
         // 理由文字列の構築
         result.reason = build_evaluation_reason(result, x, r, height);
         
         return result;
     }
     
+    // 全消し探索（見込みが閾値未満ならfalse）
+    bool try_all_clear(const GameState& state, double time_limit_ms, AIDecision& decision) {
+        BitField root = BitField::from_field(*state.own_field);
+        if (root.count_puyos() > all_clear_config_.max_puyos) return false;
+        
+        AllClearFinder::PairList pairs;
+        pairs.emplace_back(state.current_pair.axis, state.current_pair.child);
+        for (size_t i = 0; i < state.next_queue.size() && i < 2; ++i) {
+            pairs.emplace_back(state.next_queue[i].axis, state.next_queue[i].child);
+        }
+        
+        // 探索時間は思考時間の範囲に収める
+        AllClearFinder::Config finder_config = all_clear_finder_.get_config();
+        AllClearFinder::Config bounded = finder_config;
+        bounded.time_limit_ms = std::min(finder_config.time_limit_ms, time_limit_ms);
+        all_clear_finder_.set_config(bounded);
+        last_all_clear_result_ = all_clear_finder_.find(root, pairs);
+        all_clear_finder_.set_config(finder_config);
+        
+        const auto& result = last_all_clear_result_;
+        if (!result.found || result.value < all_clear_config_.min_value) return false;
+        
+        auto move_commands = MoveCommandGenerator::generate_move_commands(*state.own_field, result.x, result.r);
+        std::string reason = "AllClear[value=" + std::to_string(result.value) +
+                             ", ply=" + std::to_string(result.clear_ply >= 0 ? result.clear_ply + 1 : -1) +
+                             ", nodes=" + std::to_string(result.nodes) +
+                             ", pruned=" + std::to_string(result.pruned) +
+                             ", time=" + std::to_string(result.elapsed_ms) + "ms]";
+        
+        decision = AIDecision(result.x, result.r, move_commands, result.value, reason);
+        return true;
+    }
+    
+    // 厳密解法（有効な配置列が無ければfalse）
+    bool solve_exact(const GameState& state, AIDecision& decision) {
+        ExactSolver::PairList pairs;
+        pairs.emplace_back(state.current_pair.axis, state.current_pair.child);
+        for (const auto& pair : state.next_queue) {
+            if (static_cast<int>(pairs.size()) >= solver_config_.depth) break;
+            pairs.emplace_back(pair.axis, pair.child);
+        }
+        
+        last_solver_result_ = exact_solver_.solve(BitField::from_field(*state.own_field), pairs,
+                                                  solver_config_.objective);
+        const auto& result = last_solver_result_;
+        if (!result.found || result.sequence.empty()) return false;
+        
+        // 見えているツモで連鎖も全消しもできなければ、列の優劣がつかず最初の配置列が残るだけなので、
+        // 通常の評価（形・連鎖ポテンシャル）で選ぶ
+        if (result.max_chain == 0 && result.total_score == 0 && result.all_clear_ply < 0) return false;
+        
+        const Placement& placement = PLACEMENTS[result.sequence.front()];
+        auto move_commands = MoveCommandGenerator::generate_move_commands(
+            *state.own_field, placement.x, placement.r);
+        
+        std::string sequence;
+        for (int index : result.sequence) {
+            sequence += "(" + std::to_string(PLACEMENTS[index].x) + "," + std::to_string(PLACEMENTS[index].r) + ")";
+        }
+        std::string reason = "ExactSolver[objective=" + ExactSolver::objective_name(solver_config_.objective) +
+                             ", depth=" + std::to_string(pairs.size()) +
+                             ", chain=" + std::to_string(result.max_chain) +
+                             ", score=" + std::to_string(result.total_score) +
+                             (result.all_clear_ply >= 0 ? ", all_clear=" + std::to_string(result.all_clear_ply + 1) : std::string()) +
+                             ", nodes=" + std::to_string(result.nodes) +
+                             ", unique=" + std::to_string(result.unique_nodes) +
+                             ", time=" + std::to_string(result.elapsed_ms) + "ms]: " + sequence;
+        
+        decision = AIDecision(placement.x, placement.r, move_commands, 1.0, reason);
+        return true;
+    }
+    
+    // 相手盤面の解析（相手の盤面が前回と同じならキャッシュを返す）
+    const OpponentAnalysis& analyze_opponent(const Field& field,
+                                             std::chrono::high_resolution_clock::time_point start_time,
+                                             double time_limit_ms) {
+        BitField bits = BitField::from_field(field);
+        uint64_t hash = bits.hash();
+        if (opponent_.valid && opponent_.field_hash == hash) {
+            return opponent_;
+        }
+        
+        double budget_ms = time_limit_ms * versus_.budget_fraction;
+        auto elapsed_ms = [&]() {
+            return std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - start_time).count();
+        };
+        
+        OpponentAnalysis analysis;
+        analysis.valid = true;
+        analysis.field_hash = hash;
+        
+        // 1個追加で撃てる連鎖から、予算の範囲で追加数を1つずつ増やして精査
+        // （各段は新しい追加数だけを試し、それまでの最良と統合する）
+        analysis.potential = bits.chain_potential(1);
+        for (int added = 2; added <= versus_.max_added; ++added) {
+            if (elapsed_ms() >= budget_ms || should_stop()) break;
+            ChainPotential deeper = bits.chain_potential(added, added);
+            if (deeper.better(analysis.potential)) {
+                analysis.potential = deeper;
+            }
+        }
+        
+        // 1手で2個置けるとして発火までの手数を見積もる
+        if (analysis.potential.chain_count > 0) {
+            analysis.fire_turns = (analysis.potential.added + 1) / 2;
+        }
+        analysis.threat = analysis.potential.chain_count >= versus_.threat_chain &&
+                          analysis.fire_turns <= versus_.threat_turns;
+        
+        opponent_ = analysis;
+        return opponent_;
+    }
+    
+    // 対戦時の発火・構築判断
+    double evaluate_versus(const BitChainResult& chain, const OpponentAnalysis& opponent) const {
+        if (!chain.has_chains()) return 0.0;
+        
+        if (opponent.threat) {
+            // 相手がすぐ撃てる状態なら、先に撃って相殺・先制する
+            double bonus = versus_.counter_weight * chain.chain_count;
+            if (chain.score >= opponent.potential.score) {
+                bonus += versus_.counter_weight;
+            }
+            return bonus;
+        }
+        
+        // 相手に脅威がなければ小連鎖の暴発を避けて構築を優先
+        if (chain.chain_count < chain_strategy_.min_chain_target) {
+            return versus_.premature_penalty;
+        }
+        return 0.0;
+    }
+    
+    // 予告おじゃまぷよの評価（相殺 → 残りを降下 → 窒息判定）
+    double evaluate_garbage(const MoveOrderer::Candidate& candidate, int pending) const {
+        int score = candidate.chain.has_chains() ? candidate.chain.score : 0;
+        int offset = GarbageSystem::calculate_offset(score, pending);
+        int remaining = pending - offset;
+        
+        double value = garbage_.offset_weight * offset;
+        if (remaining == 0) {
+            return value + garbage_.full_offset_bonus;
+        }
+        
+        BitField dropped = candidate.field;
+        int placed = dropped.drop_garbage(remaining);
+        value += garbage_.drop_weight * placed;
+        if (dropped.is_game_over()) {
+            value += garbage_.overflow_penalty;
+        }
+        return value;
+    }
+    
     // フォールバック位置選択（中央寄り）
     std::pair<int, int> select_fallback_position(const std::vector<std::pair<int, int>>& valid_positions) {
         std::pair<int, int> best = valid_positions[0];
@@ -309,9 +742,9 @@ private:
     }
     
     // U字型貢献度評価
-    double evaluate_u_shape_contribution(const Field& field, int x, int r) {
-        // FieldAnalyzer::evaluate_u_shapeを使用して基本U字スコアを取得
-        double base_u_score = FieldAnalyzer::evaluate_u_shape(field);
+    double evaluate_u_shape_contribution(EvaluationContext& ctx, int x, int r) {
+        // FieldAnalyzer::evaluate_u_shapeの基本U字スコア（局面キャッシュ）
+        double base_u_score = cached_u_shape(ctx);
         
         // この配置がU字形成にどう貢献するかを評価
         double contribution = 0.0;
@@ -325,7 +758,7 @@ private:
         // 中央列は低く保つ
         if (std::find(u_config_.center_columns.begin(),
                      u_config_.center_columns.end(), x) != u_config_.center_columns.end()) {
-            int height = get_column_height(field, x);
+            int height = ctx.column_heights[x];
             if (height < u_config_.max_center_height) {
                 contribution += 3.0;
             } else {
@@ -337,24 +770,22 @@ private:
     }
     
     // 連鎖ポテンシャル貢献度評価
-    double evaluate_chain_potential_contribution(const Field& field, int x, int r) {
-        // 基本の連鎖ポテンシャルを取得
-        int base_potential = FieldAnalyzer::count_potential_chains(field);
+    double evaluate_chain_potential_contribution(EvaluationContext& ctx, int x, int r) {
+        // 基本の連鎖ポテンシャル（局面キャッシュ）
+        int base_potential = cached_potential_chains(ctx);
         
         // この手でどれだけ連鎖ポテンシャルが向上するかをシミュレーション
         // （実際の実装では配置シミュレーションが必要だが、簡易版として近似）
         double improvement = 0.0;
         
         // 同色ぷよとの隣接による連鎖構築貢献
-        improvement += count_same_color_adjacency(field, x) * 2.0;
+        improvement += count_same_color_adjacency(ctx, x) * 2.0;
         
         return base_potential * 2.0 + improvement;
     }
     
     // フィールド安定性評価
-    double evaluate_field_stability(const Field& field, int x) {
-        std::vector<int> heights = get_all_column_heights(field);
-        
+    double evaluate_field_stability(const std::array<int, FIELD_WIDTH>& heights) const {
         double stability = 0.0;
         
         // 高さの分散を評価（小さいほど安定）
@@ -374,24 +805,22 @@ private:
     }
     
     // 連鎖発火判定
-    bool should_trigger_chain(const Field& field, const GameState& state) {
-        // フィールドが一定以上の高さになった場合
-        auto analysis = calculate_field_analysis(field);
-        if (analysis.max_height >= chain_strategy_.chain_timing_threshold) {
-            return true;
-        }
-        
-        // 十分な連鎖ポテンシャルがある場合
-        if (analysis.chain_potential >= chain_strategy_.min_chain_target * 10) {
-            return true;
+    // 局面にのみ依存するため、判定結果もcontextにキャッシュする
+    bool should_trigger_chain(EvaluationContext& ctx, const GameState& state) {
+        if (!ctx.trigger_chain) {
+            const auto& analysis = cached_field_analysis(ctx);
+            
+            // フィールドが一定以上の高さになった場合
+            // 十分な連鎖ポテンシャルがある場合
+            ctx.trigger_chain = analysis.max_height >= chain_strategy_.chain_timing_threshold ||
+                                analysis.chain_potential >= chain_strategy_.min_chain_target * 10;
         }
-        
-        return false;
+        return *ctx.trigger_chain;
     }
     
     // 連鎖発火ポテンシャル評価
-    double evaluate_chain_trigger_potential(const Field& field) {
-        int potential_chains = FieldAnalyzer::count_potential_chains(field);
+    double evaluate_chain_trigger_potential(EvaluationContext& ctx) {
+        int potential_chains = cached_potential_chains(ctx);
         return potential_chains * 10.0; // 連鎖可能数×10
     }
     
@@ -402,6 +831,9 @@ private:
         if (result.u_shape_score > 5.0) reason += "U-shape+ ";
         if (result.chain_score > 10.0) reason += "Chain+ ";
         if (result.next_score > 5.0) reason += "Next+ ";
+        if (result.chain_form_score > 10.0) reason += "Form+ ";
+        if (result.versus_score > 0.0) reason += "Counter ";
+        if (result.garbage_score > 0.0) reason += "Offset ";
         if (height >= FIELD_HEIGHT - 2) reason += "Danger ";
         
         return reason;
@@ -425,9 +857,10 @@ private:
         return heights;
     }
     
-    int count_same_color_adjacency(const Field& field, int x) const {
+    int count_same_color_adjacency(const EvaluationContext& ctx, int x) const {
+        const Field& field = *ctx.field;
         int count = 0;
-        int y = get_column_height(field, x);
+        int y = ctx.column_heights[x];
         int dx[] = {-1, 1, 0, 0};
         int dy[] = {0, 0, -1, 1};
         
@@ -447,7 +880,7 @@ private:
     }
     
     // 基本位置評価（ChainSearchAI専用）
-    double evaluate_basic_position(const Field& field, int x, int r) const {
+    double evaluate_basic_position(const EvaluationContext& ctx, int x, int r) const {
         double score = 0.0;
         
         // 中央寄りボーナス
@@ -455,7 +888,7 @@ private:
         score += (3 - center_distance) * weights_.center_preference;
         
         // 低い位置ボーナス
-        int height = get_column_height(field, x);
+        int height = ctx.column_heights[x];
         score += (FIELD_HEIGHT - height) * weights_.height_balance;
         
         return score;
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "q_table.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace puyo {
+namespace ai {
+
+// 複数スレッドから同時に更新できるQ値テーブル（Hogwild方式）
+// スロットは最初に容量分を確保して拡張しない（2の冪、mix64 + 線形探索はQTableと同じ）。
+// 新しい状態はキーのCASで挿入し、Q値・訪問回数はrelaxedの原子変数で読み書きする。
+// 同じ行動を同時に更新すると片方の更新が失われることがあるが、ロックは取らない。
+class ConcurrentQTable {
+public:
+    static constexpr double MAX_LOAD_FACTOR = 0.7;
+
+    struct Slot {
+        std::atomic<uint64_t> key;
+        std::atomic<float> q_values[PLACEMENT_COUNT];
+        std::atomic<int32_t> visit_counts[PLACEMENT_COUNT];
+    };
+
+    explicit ConcurrentQTable(size_t capacity = 1 << 18)
+        : capacity_(round_up_capacity(capacity)), slots_(new Slot[capacity_]), size_(0),
+          max_size_(static_cast<size_t>(capacity_ * MAX_LOAD_FACTOR)) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].key.store(QTable::EMPTY_KEY, std::memory_order_relaxed);
+            for (int a = 0; a < PLACEMENT_COUNT; ++a) {
+                slots_[i].q_values[a].store(0.0f, std::memory_order_relaxed);
+                slots_[i].visit_counts[a].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ConcurrentQTable(const ConcurrentQTable&) = delete;
+    ConcurrentQTable& operator=(const ConcurrentQTable&) = delete;
+
+    // 行の検索（無ければnullptr）
+    Slot* find(uint64_t key) const {
+        if (key == QTable::EMPTY_KEY) return nullptr;
+        size_t mask = capacity_ - 1;
+        size_t index = static_cast<size_t>(QTable::mix64(key)) & mask;
+        for (;;) {
+            uint64_t current = slots_[index].key.load(std::memory_order_acquire);
+            if (current == key) return &slots_[index];
+            if (current == QTable::EMPTY_KEY) return nullptr;
+            index = (index + 1) & mask;
+        }
+    }
+
+    // 行の取得（無ければ挿入、負荷率の上限に達していればnullptr）
+    // 値は構築時に0で初期化済みなので、キーを書き込んだ時点で他スレッドから読める
+    Slot* find_or_insert(uint64_t key) {
+        if (key == QTable::EMPTY_KEY) return nullptr;
+        size_t mask = capacity_ - 1;
+        size_t index = static_cast<size_t>(QTable::mix64(key)) & mask;
+        for (;;) {
+            uint64_t current = slots_[index].key.load(std::memory_order_acquire);
+            if (current == key) return &slots_[index];
+            if (current == QTable::EMPTY_KEY) {
+                if (size_.fetch_add(1, std::memory_order_relaxed) >= max_size_) {
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                if (slots_[index].key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    return &slots_[index];
+                }
+                // 他スレッドが先に埋めた（同じキーならそのスロットを使う）
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                if (current == key) return &slots_[index];
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    // 行動価値（未知の状態は0）
+    double get(uint64_t key, int action) const {
+        if (action < 0 || action >= PLACEMENT_COUNT) return 0.0;
+        const Slot* slot = find(key);
+        return slot ? slot->q_values[action].load(std::memory_order_relaxed) : 0.0;
+    }
+
+    // 状態の最大Q値（未知の状態・全て負なら0、QTableでの更新と同じ扱い）
+    double max_q(uint64_t key) const {
+        const Slot* slot = find(key);
+        double best = 0.0;
+        if (slot) {
+            for (int a = 0; a < PLACEMENT_COUNT; ++a) {
+                best = std::max(best, static_cast<double>(slot->q_values[a].load(std::memory_order_relaxed)));
+            }
+        }
+        return best;
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    size_t capacity() const { return capacity_; }
+
+    // 1行の書き込み（表が満杯で追加できなければfalse）
+    // 読み手と並行に呼んでよいが、読み手は書き込み途中の行（一部の行動だけ新しい値）を見ることがある
+    bool store(uint64_t key, const QRow& row) {
+        Slot* slot = find_or_insert(key);
+        if (!slot) return false;
+        for (int a = 0; a < PLACEMENT_COUNT; ++a) {
+            slot->q_values[a].store(static_cast<float>(row[a].q_value), std::memory_order_relaxed);
+            slot->visit_counts[a].store(row[a].visit_count, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // QTableからの取り込み（学習の再開用、並行アクセスの前に呼ぶ）
+    // 入りきらなかった状態数を返す
+    size_t import_from(const QTable& table) {
+        size_t dropped = 0;
+        table.for_each([&](uint64_t key, const QRow& row) {
+            if (!store(key, row)) dropped++;
+        });
+        return dropped;
+    }
+
+    // QTableへの書き出し（全スレッドの更新が終わってから呼ぶ）
+    QTable to_q_table() const {
+        QTable table;
+        table.reserve(size());
+        for (size_t i = 0; i < capacity_; ++i) {
+            uint64_t key = slots_[i].key.load(std::memory_order_acquire);
+            if (key == QTable::EMPTY_KEY) continue;
+            QRow& row = table.get_or_insert(key);
+            for (int a = 0; a < PLACEMENT_COUNT; ++a) {
+                row[a] = QEntry(slots_[i].q_values[a].load(std::memory_order_relaxed),
+                                slots_[i].visit_counts[a].load(std::memory_order_relaxed));
+            }
+        }
+        return table;
+    }
+
+private:
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> size_;
+    size_t max_size_;
+
+    static size_t round_up_capacity(size_t capacity) {
+        size_t result = 16;
+        while (result < capacity) result <<= 1;
+        return result;
+    }
+};
+
+} // namespace ai
+} // namespace puyo
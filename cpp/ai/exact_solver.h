@@ -0,0 +1,192 @@
+#pragma once
+
+#include "core/bit_field.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// 見えているツモ（現在 + NEXT + NEXT-NEXT）の全配置列を列挙する厳密解法
+// 同じ手数で同じ盤面に到達した経路は、先に到達した経路に最大連鎖数・合計得点（全消しの手数）の
+// すべてで及ばなければ打ち切る（盤面ハッシュで重複排除）。
+// 3手で最大22^3 = 10648局面のため、ビットボードで数ミリ秒で解ける。
+// 評価が同じ列は先に見つけた列（配置インデックス順で最初の列）を返す。どの列も連鎖しない場合は
+// 全列が同点になるため、呼び出し側は通常の評価関数で選び直すこと（ChainSearchAI::solve_exact）。
+class ExactSolver {
+public:
+    // 目的関数
+    enum class Objective {
+        MAX_CHAIN,    // 最大連鎖数（同数なら合計得点）
+        MAX_SCORE,    // 合計得点（同点なら最大連鎖数）
+        ALL_CLEAR     // 全消し（早い手数を優先、無ければ合計得点）
+    };
+
+    using PairList = std::vector<std::pair<PuyoColor, PuyoColor>>;
+
+    struct Result {
+        bool found;                 // 有効な配置列があったか
+        std::vector<int> sequence;  // 最良の配置列（配置インデックス）
+        int max_chain;
+        int total_score;
+        int all_clear_ply;          // 全消しした手数（0始まり、無ければ-1）
+        long long nodes;            // 展開した局面数
+        long long unique_nodes;     // 重複排除後の局面数
+        double elapsed_ms;
+
+        Result() : found(false), max_chain(0), total_score(0), all_clear_ply(-1),
+                   nodes(0), unique_nodes(0), elapsed_ms(0.0) {}
+    };
+
+    static Objective parse_objective(const std::string& name) {
+        if (name == "max_score") return Objective::MAX_SCORE;
+        if (name == "all_clear") return Objective::ALL_CLEAR;
+        return Objective::MAX_CHAIN;
+    }
+
+    static std::string objective_name(Objective objective) {
+        switch (objective) {
+            case Objective::MAX_SCORE: return "max_score";
+            case Objective::ALL_CLEAR: return "all_clear";
+            case Objective::MAX_CHAIN:
+            default:                   return "max_chain";
+        }
+    }
+
+    // pairsの全配置列を列挙して最良の列を返す
+    Result solve(const BitField& root, const PairList& pairs, Objective objective) {
+        auto start_time = std::chrono::steady_clock::now();
+
+        objective_ = objective;
+        pairs_ = &pairs;
+        best_ = Result();
+        path_.clear();
+        visited_.assign(pairs.size(), {});
+
+        if (!pairs.empty()) {
+            search(root, 0, PathValue());
+        }
+
+        best_.elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_time).count();
+        return best_;
+    }
+
+private:
+    // 経路の累積評価
+    struct PathValue {
+        int max_chain;
+        int total_score;
+        int all_clear_ply;
+
+        PathValue() : max_chain(0), total_score(0), all_clear_ply(-1) {}
+    };
+
+    Objective objective_ = Objective::MAX_CHAIN;
+    const PairList* pairs_ = nullptr;
+    Result best_;
+    std::vector<int> path_;
+    std::vector<std::unordered_map<uint64_t, PathValue>> visited_;  // 手数ごとの到達盤面と最良の累積評価
+
+    // aから続けた列が、以降の手によらずbから続けた列を下回らないか
+    // 最大連鎖数・合計得点（全消しが目的なら全消しの手数も）のすべてでa以上の場合に限る。
+    // 評価で上回るだけでは足りない（最大連鎖では(2連鎖, 100点)の後に5連鎖すると、(1連鎖, 500点)の後の5連鎖に得点で負ける）
+    bool dominates(const PathValue& a, const PathValue& b) const {
+        if (a.max_chain < b.max_chain || a.total_score < b.total_score) return false;
+        if (objective_ != Objective::ALL_CLEAR || b.all_clear_ply < 0) return true;
+        return a.all_clear_ply >= 0 && a.all_clear_ply <= b.all_clear_ply;
+    }
+
+    // 目的関数での比較（aがbより良ければtrue）
+    bool better(const PathValue& a, const PathValue& b) const {
+        switch (objective_) {
+            case Objective::MAX_SCORE:
+                if (a.total_score != b.total_score) return a.total_score > b.total_score;
+                return a.max_chain > b.max_chain;
+            case Objective::ALL_CLEAR: {
+                bool a_clear = a.all_clear_ply >= 0;
+                bool b_clear = b.all_clear_ply >= 0;
+                if (a_clear != b_clear) return a_clear;
+                if (a_clear && a.all_clear_ply != b.all_clear_ply) return a.all_clear_ply < b.all_clear_ply;
+                if (a.total_score != b.total_score) return a.total_score > b.total_score;
+                return a.max_chain > b.max_chain;
+            }
+            case Objective::MAX_CHAIN:
+            default:
+                if (a.max_chain != b.max_chain) return a.max_chain > b.max_chain;
+                return a.total_score > b.total_score;
+        }
+    }
+
+    void record_leaf(const PathValue& value) {
+        PathValue current;
+        current.max_chain = best_.max_chain;
+        current.total_score = best_.total_score;
+        current.all_clear_ply = best_.all_clear_ply;
+
+        if (!best_.found || better(value, current)) {
+            best_.found = true;
+            best_.sequence = path_;
+            best_.max_chain = value.max_chain;
+            best_.total_score = value.total_score;
+            best_.all_clear_ply = value.all_clear_ply;
+        }
+    }
+
+    void search(const BitField& field, size_t depth, const PathValue& value) {
+        const auto& pair = (*pairs_)[depth];
+        bool expanded = false;
+
+        for (int index = 0; index < PLACEMENT_COUNT; ++index) {
+            const Placement& placement = PLACEMENTS[index];
+            BitField next = field;
+            BitChainResult result = next.place_and_simulate(placement.x, placement.r, pair.first, pair.second);
+            if (result.chain_count < 0 || next.is_game_over()) continue;
+
+            best_.nodes++;
+            expanded = true;
+
+            PathValue next_value = value;
+            if (result.has_chains()) {
+                next_value.max_chain = std::max(next_value.max_chain, result.chain_count);
+                next_value.total_score += result.score;
+                if (result.all_clear && next_value.all_clear_ply < 0) {
+                    next_value.all_clear_ply = static_cast<int>(depth);
+                }
+            }
+
+            // 同じ手数・同じ盤面に先に到達した経路に及ばない経路は打ち切る
+            // （及ばないとは言えなければ探索し、評価が上回る場合だけ記録を置き換える）
+            auto& visited = visited_[depth];
+            uint64_t key = next.hash();
+            auto it = visited.find(key);
+            if (it != visited.end() && dominates(it->second, next_value)) continue;
+            if (it == visited.end()) {
+                best_.unique_nodes++;
+                visited.emplace(key, next_value);
+            } else if (better(next_value, it->second)) {
+                it->second = next_value;
+            }
+
+            path_.push_back(index);
+            if (depth + 1 < pairs_->size()) {
+                search(next, depth + 1, next_value);
+            } else {
+                record_leaf(next_value);
+            }
+            path_.pop_back();
+        }
+
+        // 途中で置ける場所がなくなった場合はそこまでの列で評価
+        if (!expanded && depth > 0) {
+            record_leaf(value);
+        }
+    }
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "q_table.h"
+#include "core/puyo_types.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// 経験リプレイ用の状態スナップショット（48バイト）
+// 84マスを1マス4ビットで詰め、ツモの色も4ビットずつ格納する。
+struct PackedRLState {
+    uint8_t cells[42];          // y * 6 + x番目のマスの色（4ビット）
+    uint8_t current_pair;       // 軸色 | 子色 << 4
+    uint8_t next_pairs[2];      // NEXT・NEXT2（同上）
+    uint8_t last_chain_count;
+    uint16_t turn_count;
+
+    PackedRLState() { std::memset(this, 0, sizeof(*this)); }
+
+    uint8_t cell(int index) const {
+        return (cells[index >> 1] >> ((index & 1) * 4)) & 0xF;
+    }
+
+    void set_cell(int index, uint8_t color) {
+        int shift = (index & 1) * 4;
+        cells[index >> 1] = static_cast<uint8_t>((cells[index >> 1] & ~(0xF << shift)) | ((color & 0xF) << shift));
+    }
+
+    // Q値テーブルの状態キー（RLState::pack_keyと同じ値）
+    uint64_t state_key() const {
+        std::array<int, FIELD_WIDTH> heights{};
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            for (int y = FIELD_HEIGHT - 1; y >= 0; --y) {
+                if (cell(y * FIELD_WIDTH + x) != 0) {
+                    heights[x] = y + 1;
+                    break;
+                }
+            }
+        }
+        return make_state_key(heights, current_pair & 0xF, current_pair >> 4);
+    }
+};
+static_assert(sizeof(PackedRLState) == 48, "PackedRLState must be 48 bytes");
+
+// 経験1件（104バイト、ヒープ確保なし）
+struct CompactExperience {
+    PackedRLState state;
+    PackedRLState next_state;
+    float reward;
+    uint8_t action;             // PLACEMENTSのインデックス
+    uint8_t terminal;
+    uint8_t pending_garbage;       // stateでの予告おじゃまぷよ数（255で頭打ち、linearバックエンドの特徴量）
+    uint8_t next_pending_garbage;  // next_stateでの予告おじゃまぷよ数
+
+    CompactExperience() : reward(0.0f), action(0), terminal(0), pending_garbage(0), next_pending_garbage(0) {}
+};
+static_assert(sizeof(CompactExperience) == 104, "CompactExperience must be 104 bytes");
+
+// 固定容量のリングバッファによる経験リプレイ
+// 容量分を最初に一度だけ確保し、満杯になったら最も古い経験を上書きする。
+class ExperienceReplay {
+public:
+    explicit ExperienceReplay(size_t capacity = 0) : head_(0), size_(0) {
+        reset(capacity);
+    }
+
+    // 容量を設定し直す（内容は破棄）
+    void reset(size_t capacity) {
+        buffer_.assign(capacity, CompactExperience());
+        head_ = 0;
+        size_ = 0;
+    }
+
+    // 書き込んだスロット番号を返す（容量0なら何もしない）
+    size_t push(const CompactExperience& experience) {
+        if (buffer_.empty()) return 0;
+        size_t slot = head_;
+        buffer_[slot] = experience;
+        head_ = (head_ + 1) % buffer_.size();
+        if (size_ < buffer_.size()) size_++;
+        return slot;
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return buffer_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == buffer_.size() && size_ > 0; }
+
+    // 古い順にindex番目
+    const CompactExperience& at(size_t index) const {
+        size_t oldest = (head_ + buffer_.size() - size_) % buffer_.size();
+        return buffer_[(oldest + index) % buffer_.size()];
+    }
+
+    // 物理位置（スロット番号）で参照
+    const CompactExperience& slot(size_t index) const {
+        return buffer_[index];
+    }
+
+    const CompactExperience& latest() const {
+        return buffer_[(head_ + buffer_.size() - 1) % buffer_.size()];
+    }
+
+    // 一様ランダムにbatch_size件（重複あり）を選ぶ
+    template <typename Random>
+    void sample(size_t batch_size, Random& random, std::vector<const CompactExperience*>& out) const {
+        out.clear();
+        if (size_ == 0) return;
+        std::uniform_int_distribution<size_t> dist(0, size_ - 1);
+        for (size_t i = 0; i < batch_size; ++i) {
+            out.push_back(&at(dist(random)));
+        }
+    }
+
+private:
+    std::vector<CompactExperience> buffer_;
+    size_t head_;    // 次に書き込む位置
+    size_t size_;
+};
+
+// 優先度の和を保持する完全二分木
+// 葉がスロットごとの優先度、内部ノードが子の和。更新と累積和からの検索はO(log n)。
+class SumTree {
+public:
+    explicit SumTree(size_t capacity = 0) : leaves_(0) {
+        reset(capacity);
+    }
+
+    void reset(size_t capacity) {
+        leaves_ = 1;
+        while (leaves_ < capacity) leaves_ <<= 1;
+        nodes_.assign(leaves_ * 2, 0.0);
+    }
+
+    void update(size_t index, double priority) {
+        size_t node = leaves_ + index;
+        nodes_[node] = priority;
+        // 差分の加算ではなく子の和で置き直す（誤差が溜まらない）
+        for (node >>= 1; node >= 1; node >>= 1) {
+            nodes_[node] = nodes_[node * 2] + nodes_[node * 2 + 1];
+        }
+    }
+
+    double priority(size_t index) const { return nodes_[leaves_ + index]; }
+    double total() const { return nodes_[1]; }
+
+    // 累積和がvalueを超える最初の葉（valueは[0, total())）
+    size_t find(double value) const {
+        size_t node = 1;
+        while (node < leaves_) {
+            size_t left = node * 2;
+            if (value < nodes_[left] || nodes_[left + 1] <= 0.0) {
+                node = left;
+            } else {
+                value -= nodes_[left];
+                node = left + 1;
+            }
+        }
+        return node - leaves_;
+    }
+
+private:
+    size_t leaves_;
+    std::vector<double> nodes_;   // 1始まりのヒープ配置（葉はleaves_〜）
+};
+
+// 優先度付き経験リプレイ
+// TD誤差に比例した確率（|δ| + ε)^αで経験を選び、偏りを重要度重み(N·P)^-βで補正する。
+// βはサンプリングのたびにbeta_startからbeta_endへ線形に近づける。
+class PrioritizedReplay {
+public:
+    struct Config {
+        double alpha;            // 優先度の指数（0で一様）
+        double beta_start;       // 重要度重みの指数の初期値
+        double beta_end;
+        int beta_steps;          // beta_endに達するまでのサンプリング回数
+        double epsilon;          // 優先度が0にならないための下駄
+
+        Config() : alpha(0.6), beta_start(0.4), beta_end(1.0), beta_steps(100000), epsilon(0.01) {}
+    };
+
+    struct Sample {
+        size_t slot;
+        const CompactExperience* experience;
+        double weight;           // 重要度重み（バッチ内の最大で正規化、0〜1）
+    };
+
+    explicit PrioritizedReplay(size_t capacity = 0, const Config& config = Config())
+        : config_(config), max_priority_(1.0), sample_count_(0) {
+        reset(capacity);
+    }
+
+    void reset(size_t capacity) {
+        replay_.reset(capacity);
+        tree_.reset(capacity);
+        max_priority_ = 1.0;
+        sample_count_ = 0;
+    }
+
+    void set_config(const Config& config) { config_ = config; }
+    const Config& config() const { return config_; }
+
+    // 新しい経験は最大優先度で追加（少なくとも一度は選ばれるように）
+    void push(const CompactExperience& experience) {
+        if (replay_.capacity() == 0) return;
+        tree_.update(replay_.push(experience), max_priority_);
+    }
+
+    size_t size() const { return replay_.size(); }
+    size_t capacity() const { return replay_.capacity(); }
+    bool empty() const { return replay_.empty(); }
+    const CompactExperience& latest() const { return replay_.latest(); }
+    double total_priority() const { return tree_.total(); }
+    double priority(size_t slot) const { return tree_.priority(slot); }
+
+    double current_beta() const {
+        if (config_.beta_steps <= 0) return config_.beta_end;
+        double progress = std::min(1.0, static_cast<double>(sample_count_) / config_.beta_steps);
+        return config_.beta_start + (config_.beta_end - config_.beta_start) * progress;
+    }
+
+    // 層化サンプリング：全体をbatch_size区間に分け、各区間から優先度比例で1件
+    template <typename Random>
+    void sample(size_t batch_size, Random& random, std::vector<Sample>& out) {
+        out.clear();
+        double total = tree_.total();
+        if (replay_.empty() || batch_size == 0 || total <= 0.0) return;
+
+        double beta = current_beta();
+        sample_count_++;
+        double segment = total / batch_size;
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        double max_weight = 0.0;
+        for (size_t i = 0; i < batch_size; ++i) {
+            double value = std::min((i + dist(random)) * segment, std::nextafter(total, 0.0));
+            size_t slot = tree_.find(value);
+            double probability = tree_.priority(slot) / total;
+            double weight = std::pow(replay_.size() * probability, -beta);
+            max_weight = std::max(max_weight, weight);
+            out.push_back(Sample{slot, &replay_.slot(slot), weight});
+        }
+        for (auto& sample : out) {
+            sample.weight /= max_weight;
+        }
+    }
+
+    // TD誤差から優先度を更新
+    void update_priority(size_t slot, double td_error) {
+        double priority = std::pow(std::abs(td_error) + config_.epsilon, config_.alpha);
+        max_priority_ = std::max(max_priority_, priority);
+        tree_.update(slot, priority);
+    }
+
+    // バッチ単位の更新（td_errorsはbatchと同じ順）
+    void update_priorities(const std::vector<Sample>& batch, const std::vector<double>& td_errors) {
+        size_t count = std::min(batch.size(), td_errors.size());
+        for (size_t i = 0; i < count; ++i) {
+            update_priority(batch[i].slot, td_errors[i]);
+        }
+    }
+
+private:
+    Config config_;
+    ExperienceReplay replay_;
+    SumTree tree_;
+    double max_priority_;
+    uint64_t sample_count_;
+};
+
+} // namespace ai
+} // namespace puyo
@@ -352,6 +352,9 @@ private:
         std::vector<SituationSimilarity> similarities;
         
         for (size_t i = 0; i < learning_database_.size(); ++i) {
+            // 学習データが多いと時間がかかるため、中止・締め切りならそこまでの結果で判断する
+            if ((i & 255) == 0 && i > 0 && should_stop()) break;
+            
             const HumanPlayData& stored = learning_database_[i];
             double similarity = calculate_similarity(current, stored);
             
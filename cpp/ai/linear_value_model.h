@@ -0,0 +1,139 @@
+#pragma once
+
+#include "rl_features.h"
+#include "q_table_file.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace puyo {
+namespace ai {
+
+// 線形の状態価値関数 V(s) = w・φ(s)
+// 重みは特徴数分の連続したfloat配列で、状態数によらずメモリは一定。
+// 内積と更新はSSE2で4要素ずつ処理する（SSE2が無い環境ではスカラー）。
+//
+// ファイル形式（リトルエンディアン）:
+//   "PUYOLVM1" + version(uint32) + feature_count(uint32) + checksum(uint64) + float × feature_count
+class LinearValueModel {
+public:
+    static constexpr int FEATURE_COUNT = RLFeatureVector::SIZE;
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    LinearValueModel() : weights_{} {}
+
+    float predict(const RLFeatureVector& features) const {
+        return dot(weights_.data(), features.data(), FEATURE_COUNT);
+    }
+
+    // 目標値へ勾配降下で1ステップ近づける（更新前の誤差を返す）
+    float update(const RLFeatureVector& features, float target, float step) {
+        float error = target - predict(features);
+        axpy(step * error, features.data(), weights_.data(), FEATURE_COUNT);
+        return error;
+    }
+
+    float weight(int index) const { return weights_[index]; }
+    void set_weight(int index, float value) { weights_[index] = value; }
+    const float* weights() const { return weights_.data(); }
+    void clear() { weights_.fill(0.0f); }
+
+    static float dot(const float* a, const float* b, int n) {
+#if defined(__SSE2__)
+        __m128 sum = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        // 4レーンの水平加算
+        __m128 shuffled = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1));
+        sum = _mm_add_ps(sum, shuffled);
+        shuffled = _mm_movehl_ps(shuffled, sum);
+        sum = _mm_add_ss(sum, shuffled);
+        float result = _mm_cvtss_f32(sum);
+        for (; i < n; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+#else
+        return dot_scalar(a, b, n);
+#endif
+    }
+
+    static float dot_scalar(const float* a, const float* b, int n) {
+        float result = 0.0f;
+        for (int i = 0; i < n; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    // y += scale * x
+    static void axpy(float scale, const float* x, float* y, int n) {
+        int i = 0;
+#if defined(__SSE2__)
+        __m128 factor = _mm_set1_ps(scale);
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(factor, _mm_loadu_ps(x + i))));
+        }
+#endif
+        for (; i < n; ++i) {
+            y[i] += scale * x[i];
+        }
+    }
+
+    bool save(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+
+        uint32_t version = FORMAT_VERSION;
+        uint32_t feature_count = FEATURE_COUNT;
+        uint64_t checksum = QTableFile::checksum(weights_.data(), sizeof(weights_));
+        file.write(MAGIC, sizeof(MAGIC));
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char*>(&feature_count), sizeof(feature_count));
+        file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        file.write(reinterpret_cast<const char*>(weights_.data()), sizeof(weights_));
+        return static_cast<bool>(file);
+    }
+
+    // 形式・特徴数・チェックサムが合わないファイルは読まない（重みは変更しない）
+    bool load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        char magic[sizeof(MAGIC)];
+        uint32_t version = 0, feature_count = 0;
+        uint64_t checksum = 0;
+        std::array<float, FEATURE_COUNT> loaded;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&feature_count), sizeof(feature_count));
+        file.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
+        if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            version != FORMAT_VERSION || feature_count != static_cast<uint32_t>(FEATURE_COUNT)) {
+            return false;
+        }
+        if (!file.read(reinterpret_cast<char*>(loaded.data()), sizeof(loaded)) ||
+            QTableFile::checksum(loaded.data(), sizeof(loaded)) != checksum) {
+            return false;
+        }
+        std::copy(loaded.begin(), loaded.end(), weights_.begin());
+        return true;
+    }
+
+private:
+    static constexpr char MAGIC[8] = {'P', 'U', 'Y', 'O', 'L', 'V', 'M', '1'};
+
+    alignas(16) std::array<float, FEATURE_COUNT> weights_;
+};
+
+} // namespace ai
+} // namespace puyo
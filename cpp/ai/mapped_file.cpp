@@ -0,0 +1,79 @@
+#include "mapped_file.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace puyo {
+namespace ai {
+
+MappedFile::MappedFile() : open_(false), data_(nullptr), size_(0), mapping_(nullptr) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t file_size = static_cast<size_t>(st.st_size);
+    void* mapping = file_size > 0 ? ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd);
+
+    if (mapping != MAP_FAILED) {
+        mapping_ = mapping;
+        data_ = static_cast<const char*>(mapping);
+        size_ = file_size;
+        open_ = true;
+        return true;
+    }
+#endif
+
+    // mmapできない環境（空のファイルも含む）では全体を読み込む
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    size_t read_size = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+    buffer_.resize(read_size);
+    if (!file.read(buffer_.data(), static_cast<std::streamsize>(read_size))) {
+        buffer_.clear();
+        return false;
+    }
+
+    data_ = buffer_.data();
+    size_ = read_size;
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapping_) {
+        ::munmap(mapping_, size_);
+    }
+#endif
+    mapping_ = nullptr;
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// 読み取り専用で開いたファイル全体
+// mmapできればmmapし、できない環境（Windows、mmapの失敗）では全体をメモリに読み込む。
+// 読み込み先はnewで確保するので、mmapと同じく先頭は構造体を並べられるだけ整列している。
+// QTableFile・OpeningBookなど、ヘッダー + 固定長レコードの形式をその場で参照するクラスが使う。
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // ファイルを開く（開けない・読めない場合はfalse）
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return open_; }
+    bool is_mapped() const { return mapping_ != nullptr; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    bool open_;
+    const char* data_;
+    size_t size_;
+
+    void* mapping_;            // mmap領域（フォールバック時はnullptr）
+    std::vector<char> buffer_; // mmapできない環境での読み込み先
+};
+
+} // namespace ai
+} // namespace puyo
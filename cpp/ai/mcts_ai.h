@@ -0,0 +1,695 @@
+#pragma once
+
+#include "ai_base.h"
+#include "ai_utils.h"
+#include "core/bit_field.h"
+#include <vector>
+#include <array>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace puyo {
+namespace ai {
+
+// MCTS探索木のノード
+// 開ループ方式：ノードは手順（配置の列）のみで識別し、未知のツモは反復ごとに標本化する
+struct MCTSNode {
+    std::array<int32_t, PLACEMENT_COUNT> children;  // 子ノードインデックス（未展開は-1）
+    uint32_t visits;                                // 訪問回数（選択時に加算＝仮想損失）
+    double value_sum;                               // 報酬合計
+
+    MCTSNode() : visits(0), value_sum(0.0) { children.fill(-1); }
+
+    double mean_value() const { return visits > 0 ? value_sum / visits : 0.0; }
+};
+
+// モンテカルロ木探索AI（UCT + ランダムツモ標本化 + ビットボード高速プレイアウト）
+class MCTSAI : public AIBase {
+private:
+    // 探索パラメータ
+    struct SearchConfig {
+        int think_time_limit;        // 思考時間（ms）
+        int max_iterations;          // 最大反復回数（0で時間のみ）
+        double exploration_constant; // UCT探索定数
+        int max_tree_depth;          // 木の最大深さ
+        int playout_depth;           // プレイアウト手数
+        int num_threads;             // スレッド数（0で自動）
+        bool tree_parallel;          // true: 木並列, false: ルート並列
+        bool reuse_tree;             // ターン間で部分木を再利用する
+
+        SearchConfig() : think_time_limit(300), max_iterations(0), exploration_constant(0.7),
+                        max_tree_depth(4), playout_depth(8), num_threads(0), tree_parallel(false),
+                        reuse_tree(true) {}
+    } search_;
+
+    // プレイアウト方策・報酬設定
+    struct PlayoutConfig {
+        double random_rate;          // ランダム手の割合
+        double adjacency_weight;     // 同色隣接の重み
+        double height_weight;        // 高さペナルティの重み
+        double score_scale;          // 得点の正規化スケール
+        double survival_weight;      // 生存報酬の割合
+
+        PlayoutConfig() : random_rate(0.1), adjacency_weight(1.0), height_weight(0.25),
+                         score_scale(3000.0), survival_weight(0.3) {}
+    } playout_;
+
+    unsigned int base_seed_;
+
+    // 直近の思考統計
+    struct SearchStats {
+        long long playouts;
+        double elapsed_ms;
+        double playouts_per_sec;
+        size_t tree_nodes;
+        size_t reused_nodes;
+        int threads;
+        long long reuse_hits;
+        long long reuse_misses;
+
+        SearchStats() : playouts(0), elapsed_ms(0.0), playouts_per_sec(0.0), tree_nodes(0),
+                       reused_nodes(0), threads(0), reuse_hits(0), reuse_misses(0) {}
+    } last_stats_;
+
+    // 1回の思考で共有する探索情報
+    struct SearchContext {
+        BitField root_field;
+        std::vector<std::pair<PuyoColor, PuyoColor>> known_pairs;  // 現在 + NEXT
+        std::vector<PuyoColor> sample_colors;                      // 未知ツモの標本化に使う色
+        std::chrono::steady_clock::time_point deadline;
+        CancellationToken token;                                   // 外部からの中止要求
+    };
+
+    using Tree = std::vector<MCTSNode>;
+    
+    // 前ターンの探索木のうち、実際に指した手の部分木
+    // 次ターンの局面が想定どおり（盤面ハッシュとツモが一致）なら根として再利用する
+    struct RetainedSearch {
+        bool valid;
+        bool tree_parallel;
+        uint64_t expected_field_hash;                                  // 選択手を適用した後の盤面ハッシュ
+        std::vector<std::pair<PuyoColor, PuyoColor>> expected_pairs;   // 次ターンに見えるはずの既知ツモ
+        std::vector<Tree> trees;                                       // 部分木（木並列は1本、ルート並列はスレッド数）
+        
+        RetainedSearch() : valid(false), tree_parallel(false), expected_field_hash(0) {}
+    } retained_;
+    
+    // 退避用（AIBase::take_search_state）
+    struct RetainedSearchState : SearchState {
+        RetainedSearch search;
+        
+        std::unique_ptr<SearchState> clone() const override {
+            return std::make_unique<RetainedSearchState>(*this);
+        }
+    };
+
+public:
+    MCTSAI(const AIParameters& params = {})
+        : AIBase("MCTSAI"), base_seed_(std::random_device{}()) {
+
+        // パラメータの設定
+        for (const auto& param : params) {
+            set_parameter(param.first, param.second);
+        }
+
+        // YAML設定ファイルから設定を読み込み
+        load_configuration();
+    }
+
+    // YAML設定読み込み（AIParametersで同名キーを上書き可能）
+    void load_configuration() {
+        auto config = ConfigLoader::load_config("config/ai_params/mcts.yaml");
+        for (const auto& param : get_all_parameters()) {
+            config[param.first] = param.second;
+        }
+
+        search_.think_time_limit = ConfigLoader::get_int(config, "think_time_limit", 300);
+        search_.max_iterations = ConfigLoader::get_int(config, "max_iterations", 0);
+        search_.exploration_constant = ConfigLoader::get_double(config, "search.exploration_constant", 0.7);
+        search_.max_tree_depth = std::max(1, ConfigLoader::get_int(config, "search.max_tree_depth", 4));
+        search_.playout_depth = std::max(0, ConfigLoader::get_int(config, "search.playout_depth", 8));
+        search_.num_threads = ConfigLoader::get_int(config, "parallel.num_threads", 0);
+        search_.tree_parallel = ConfigLoader::get_string(config, "parallel.mode", "root") == "tree";
+        search_.reuse_tree = ConfigLoader::get_bool(config, "search.reuse_tree", true);
+
+        playout_.random_rate = ConfigLoader::get_double(config, "playout.random_rate", 0.1);
+        playout_.adjacency_weight = ConfigLoader::get_double(config, "playout.adjacency_weight", 1.0);
+        playout_.height_weight = ConfigLoader::get_double(config, "playout.height_weight", 0.25);
+        playout_.score_scale = std::max(1.0, ConfigLoader::get_double(config, "reward.score_scale", 3000.0));
+        playout_.survival_weight = ConfigLoader::get_double(config, "reward.survival_weight", 0.3);
+
+        if (ConfigLoader::get_bool(config, "opening_book.enabled", true)) {
+            load_opening_book(ConfigLoader::get_string(config, "opening_book.path", "data/opening_book.bin"));
+        }
+
+        int seed = ConfigLoader::get_int(config, "seed", 0);
+        if (seed != 0) {
+            base_seed_ = static_cast<unsigned int>(seed);
+        }
+    }
+
+    AIDecision think(const GameState& state) override {
+        auto start_time = std::chrono::steady_clock::now();
+
+        if (!initialized_) {
+            return AIDecision(-1, 0, {}, 0.0, "AI not initialized");
+        }
+
+        if (!state.own_field) {
+            return AIDecision(-1, 0, {}, 0.0, "Field not available");
+        }
+
+        // 序盤は定跡ブックの手を使う（保持中の探索木は局面が変わるため破棄）
+        AIDecision book_decision;
+        if (try_opening_book(state, book_decision)) {
+            retained_ = RetainedSearch();
+            return book_decision;
+        }
+
+        SearchContext context = build_context(state, start_time);
+
+        bool any_valid = false;
+        for (const auto& placement : PLACEMENTS) {
+            if (context.root_field.can_place(placement.x, placement.r)) {
+                any_valid = true;
+                break;
+            }
+        }
+        if (!any_valid) {
+            return AIDecision(-1, 0, {}, 0.0, "No valid positions available");
+        }
+
+        // 並列探索
+        int thread_count = resolve_thread_count();
+        std::array<uint64_t, PLACEMENT_COUNT> root_visits{};
+        std::array<double, PLACEMENT_COUNT> root_values{};
+        long long playouts = 0;
+        size_t tree_nodes = 0;
+        
+        // 前ターンの部分木を引き継げるか判定（不一致なら破棄して新規構築）
+        std::vector<Tree> trees = take_retained_trees(context, thread_count);
+        size_t reused_nodes = 0;
+        for (const auto& tree : trees) reused_nodes += tree.size() > 1 ? tree.size() : 0;
+
+        if (search_.tree_parallel) {
+            // 木並列：1本の木を共有し、選択・逆伝播のみロック
+            Tree& tree = trees[0];
+            tree.reserve(std::max<size_t>(tree.size() * 2, 1 << 16));
+            std::mutex tree_mutex;
+            std::vector<long long> counts(thread_count, 0);
+
+            run_workers(thread_count, [&](int thread_id) {
+                counts[thread_id] = run_search(tree, &tree_mutex, context, thread_id);
+            });
+
+            accumulate_root(tree, root_visits, root_values);
+            for (long long c : counts) playouts += c;
+            tree_nodes = tree.size();
+        } else {
+            // ルート並列：スレッドごとに独立した木を作り、ルート統計を合算
+            std::vector<long long> counts(thread_count, 0);
+
+            run_workers(thread_count, [&](int thread_id) {
+                Tree& tree = trees[thread_id];
+                tree.reserve(std::max<size_t>(tree.size() * 2, 1 << 14));
+                counts[thread_id] = run_search(tree, nullptr, context, thread_id);
+            });
+
+            for (int i = 0; i < thread_count; ++i) {
+                accumulate_root(trees[i], root_visits, root_values);
+                playouts += counts[i];
+                tree_nodes += trees[i].size();
+            }
+        }
+
+        // 訪問回数最大の手を選択（同数なら平均報酬の高い手）
+        int best_index = -1;
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            if (!context.root_field.can_place(PLACEMENTS[i].x, PLACEMENTS[i].r)) continue;
+            if (best_index < 0 || root_visits[i] > root_visits[best_index] ||
+                (root_visits[i] == root_visits[best_index] &&
+                 mean(root_values[i], root_visits[i]) > mean(root_values[best_index], root_visits[best_index]))) {
+                best_index = i;
+            }
+        }
+
+        const Placement& best = PLACEMENTS[best_index];
+        uint64_t total_visits = 0;
+        for (uint64_t v : root_visits) total_visits += v;
+
+        // 統計更新
+        auto end_time = std::chrono::steady_clock::now();
+        last_stats_.playouts = playouts;
+        last_stats_.elapsed_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        last_stats_.playouts_per_sec = last_stats_.elapsed_ms > 0.0 ? playouts * 1000.0 / last_stats_.elapsed_ms : 0.0;
+        last_stats_.tree_nodes = tree_nodes;
+        last_stats_.reused_nodes = reused_nodes;
+        last_stats_.threads = thread_count;
+        
+        // 指した手の部分木を次ターン用に保持
+        retain_subtrees(trees, context, best_index);
+
+        auto move_commands = MoveCommandGenerator::generate_move_commands(
+            *state.own_field, best.x, best.r);
+
+        double confidence = total_visits > 0 ? static_cast<double>(root_visits[best_index]) / total_visits : 0.0;
+        confidence = std::max(0.1, std::min(1.0, confidence));
+
+        std::string reason = "MCTS[playouts=" + std::to_string(playouts) +
+                           ", pps=" + std::to_string(static_cast<long long>(last_stats_.playouts_per_sec)) +
+                           ", threads=" + std::to_string(thread_count) +
+                           ", mode=" + (search_.tree_parallel ? "tree" : "root") + "]: (" +
+                           std::to_string(best.x) + "," + rotation_to_string(best.r) + ") visits=" +
+                           std::to_string(root_visits[best_index]) + " value=" +
+                           std::to_string(mean(root_values[best_index], root_visits[best_index]));
+
+        return AIDecision(best.x, best.r, move_commands, confidence, reason);
+    }
+
+    std::string get_type() const override {
+        return "MCTS";
+    }
+
+    std::string get_debug_info() const override {
+        return "MCTSAI[playouts_per_sec=" + std::to_string(static_cast<long long>(last_stats_.playouts_per_sec)) +
+               ", playouts=" + std::to_string(last_stats_.playouts) +
+               ", nodes=" + std::to_string(last_stats_.tree_nodes) +
+               ", reused=" + std::to_string(last_stats_.reused_nodes) +
+               ", reuse_hits=" + std::to_string(last_stats_.reuse_hits) +
+               "/" + std::to_string(last_stats_.reuse_hits + last_stats_.reuse_misses) +
+               ", threads=" + std::to_string(last_stats_.threads) +
+               ", mode=" + (search_.tree_parallel ? "tree" : "root") +
+               ", time=" + std::to_string(static_cast<int>(last_stats_.elapsed_ms)) + "ms]";
+    }
+    
+    void clear_search_cache() override {
+        retained_ = RetainedSearch();
+    }
+    
+    std::unique_ptr<SearchState> take_search_state() override {
+        auto state = std::make_unique<RetainedSearchState>();
+        state->search = std::move(retained_);
+        retained_ = RetainedSearch();
+        return state;
+    }
+    
+    void restore_search_state(std::unique_ptr<SearchState> state) override {
+        auto* retained = dynamic_cast<RetainedSearchState*>(state.get());
+        retained_ = retained ? std::move(retained->search) : RetainedSearch();
+    }
+
+    int get_think_time_ms() const override {
+        return search_.think_time_limit;
+    }
+
+    // 直近の思考でのプレイアウト毎秒
+    double get_playouts_per_second() const { return last_stats_.playouts_per_sec; }
+    long long get_last_playouts() const { return last_stats_.playouts; }
+    size_t get_last_reused_nodes() const { return last_stats_.reused_nodes; }
+
+private:
+    static double mean(double value_sum, uint64_t visits) {
+        return visits > 0 ? value_sum / visits : 0.0;
+    }
+
+    int resolve_thread_count() const {
+        if (search_.num_threads > 0) {
+            return search_.num_threads;
+        }
+        unsigned int hw = std::thread::hardware_concurrency();
+        return static_cast<int>(std::max(1u, std::min(hw, 8u)));
+    }
+
+    template <typename Worker>
+    static void run_workers(int thread_count, Worker&& worker) {
+        if (thread_count <= 1) {
+            worker(0);
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for (int i = 0; i < thread_count; ++i) {
+            threads.emplace_back([&worker, i]() { worker(i); });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    SearchContext build_context(const GameState& state, std::chrono::steady_clock::time_point start_time) const {
+        SearchContext context;
+        context.root_field = BitField::from_field(*state.own_field);
+        context.known_pairs.push_back({state.current_pair.axis, state.current_pair.child});
+        for (const auto& pair : state.next_queue) {
+            context.known_pairs.push_back({pair.axis, pair.child});
+        }
+
+        // 標本化に使う色：盤面とツモに現れた色（不足分は標準4色で補完）
+        auto add_color = [&context](PuyoColor color) {
+            if (color == PuyoColor::EMPTY || color == PuyoColor::GARBAGE) return;
+            if (context.sample_colors.size() >= 4) return;
+            if (std::find(context.sample_colors.begin(), context.sample_colors.end(), color) ==
+                context.sample_colors.end()) {
+                context.sample_colors.push_back(color);
+            }
+        };
+        for (const auto& pair : context.known_pairs) {
+            add_color(pair.first);
+            add_color(pair.second);
+        }
+        for (int c = static_cast<int>(PuyoColor::RED); c <= static_cast<int>(PuyoColor::PURPLE); ++c) {
+            if (context.root_field.count_color(static_cast<PuyoColor>(c)) > 0) {
+                add_color(static_cast<PuyoColor>(c));
+            }
+        }
+        for (PuyoColor color : {PuyoColor::RED, PuyoColor::GREEN, PuyoColor::BLUE, PuyoColor::YELLOW}) {
+            add_color(color);
+        }
+
+        // 自身の思考時間と外部の締め切りの早い方
+        context.deadline = std::min(start_time + std::chrono::milliseconds(search_.think_time_limit),
+                                    control_.deadline.time_point());
+        context.token = control_.token;
+        return context;
+    }
+
+    // 保持していた部分木を取り出す（局面が一致しなければ空の木を返す）
+    std::vector<Tree> take_retained_trees(const SearchContext& context, int thread_count) {
+        size_t tree_count = search_.tree_parallel ? 1 : static_cast<size_t>(thread_count);
+        std::vector<Tree> trees;
+        
+        if (retained_.valid) {
+            bool match = retained_.tree_parallel == search_.tree_parallel &&
+                         retained_.trees.size() == tree_count &&
+                         retained_.expected_field_hash == context.root_field.hash();
+            
+            // 前ターンで既知だったツモが今回の現在ツモ・NEXTと一致するか
+            size_t common = std::min(retained_.expected_pairs.size(), context.known_pairs.size());
+            for (size_t i = 0; match && i < common; ++i) {
+                match = retained_.expected_pairs[i] == context.known_pairs[i];
+            }
+            
+            if (match) {
+                trees = std::move(retained_.trees);
+                last_stats_.reuse_hits++;
+            } else {
+                last_stats_.reuse_misses++;
+            }
+            retained_ = RetainedSearch();
+        }
+        
+        if (trees.empty()) {
+            trees.resize(tree_count);
+            for (auto& tree : trees) {
+                tree.emplace_back();
+            }
+        }
+        return trees;
+    }
+    
+    // 選択した手の部分木を新しい根として保持する
+    void retain_subtrees(const std::vector<Tree>& trees, const SearchContext& context, int best_index) {
+        retained_ = RetainedSearch();
+        if (!search_.reuse_tree) return;
+        
+        const Placement& best = PLACEMENTS[best_index];
+        BitField next_field = context.root_field;
+        next_field.place_and_simulate(best.x, best.r, context.known_pairs[0].first, context.known_pairs[0].second);
+        if (next_field.is_game_over()) return;
+        
+        retained_.tree_parallel = search_.tree_parallel;
+        retained_.expected_field_hash = next_field.hash();
+        retained_.expected_pairs.assign(context.known_pairs.begin() + 1, context.known_pairs.end());
+        
+        for (const auto& tree : trees) {
+            int32_t child = tree[0].children[best_index];
+            retained_.trees.push_back(child >= 0 ? extract_subtree(tree, child) : Tree(1));
+        }
+        retained_.valid = true;
+    }
+    
+    // 指定ノード以下を新しい木としてコピー（インデックスを詰め直す）
+    static Tree extract_subtree(const Tree& tree, int32_t root) {
+        Tree subtree;
+        subtree.push_back(tree[root]);
+        
+        // 幅優先でコピーし、子インデックスを新しい木の位置に付け替える
+        for (size_t i = 0; i < subtree.size(); ++i) {
+            for (int a = 0; a < PLACEMENT_COUNT; ++a) {
+                int32_t child = subtree[i].children[a];
+                if (child < 0) continue;
+                subtree[i].children[a] = static_cast<int32_t>(subtree.size());
+                subtree.push_back(tree[child]);
+            }
+        }
+        return subtree;
+    }
+    
+    static void accumulate_root(const Tree& tree, std::array<uint64_t, PLACEMENT_COUNT>& visits,
+                                std::array<double, PLACEMENT_COUNT>& values) {
+        const MCTSNode& root = tree[0];
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            int32_t child = root.children[i];
+            if (child >= 0) {
+                visits[i] += tree[child].visits;
+                values[i] += tree[child].value_sum;
+            }
+        }
+    }
+
+    // 探索ループ（スレッド単位）、実行したプレイアウト数を返す
+    long long run_search(Tree& tree, std::mutex* tree_mutex, const SearchContext& context, int thread_id) const {
+        std::mt19937 rng(base_seed_ + 0x9E3779B9u * static_cast<unsigned int>(thread_id + 1));
+        long long iterations = 0;
+        int per_thread_limit = search_.max_iterations > 0
+            ? std::max(1, search_.max_iterations / resolve_thread_count()) : 0;
+
+        std::vector<int32_t> path;
+        path.reserve(search_.max_tree_depth + 1);
+
+        while (true) {
+            // 時間チェックは一定間隔で行う
+            if ((iterations & 15) == 0 && iterations > 0 &&
+                (std::chrono::steady_clock::now() >= context.deadline || context.token.is_cancelled())) {
+                break;
+            }
+            if (per_thread_limit > 0 && iterations >= per_thread_limit) {
+                break;
+            }
+
+            run_iteration(tree, tree_mutex, context, rng, path);
+            iterations++;
+        }
+
+        return iterations;
+    }
+
+    // 1反復：選択 → 展開 → プレイアウト → 逆伝播
+    void run_iteration(Tree& tree, std::mutex* tree_mutex, const SearchContext& context,
+                       std::mt19937& rng, std::vector<int32_t>& path) const {
+        BitField sim = context.root_field;
+        double score = 0.0;
+        bool dead = false;
+        int depth = 0;
+
+        path.clear();
+
+        // 選択・展開（木並列時はロック下で実施）
+        {
+            std::unique_lock<std::mutex> lock;
+            if (tree_mutex) lock = std::unique_lock<std::mutex>(*tree_mutex);
+
+            int32_t node = 0;
+            tree[node].visits++;
+            path.push_back(node);
+
+            for (; depth < search_.max_tree_depth; ++depth) {
+                auto pair = pair_at(context, depth, rng);
+
+                int legal[PLACEMENT_COUNT];
+                int legal_count = collect_legal(sim, legal);
+                if (legal_count == 0) {
+                    dead = true;
+                    break;
+                }
+
+                // 未展開の合法手があれば展開
+                int action = -1;
+                bool expanded = false;
+                int offset = static_cast<int>(rng() % legal_count);
+                for (int k = 0; k < legal_count; ++k) {
+                    int candidate = legal[(k + offset) % legal_count];
+                    if (tree[node].children[candidate] < 0) {
+                        action = candidate;
+                        expanded = true;
+                        break;
+                    }
+                }
+
+                if (expanded) {
+                    int32_t child = static_cast<int32_t>(tree.size());
+                    tree.emplace_back();
+                    tree[node].children[action] = child;
+                } else {
+                    action = select_uct(tree, node, legal, legal_count);
+                }
+
+                node = tree[node].children[action];
+                tree[node].visits++;
+                path.push_back(node);
+
+                const Placement& placement = PLACEMENTS[action];
+                BitChainResult result = sim.place_and_simulate(placement.x, placement.r, pair.first, pair.second);
+                score += result.score;
+                if (sim.is_game_over()) {
+                    dead = true;
+                    break;
+                }
+
+                if (expanded) {
+                    depth++;
+                    break;
+                }
+            }
+        }
+
+        // プレイアウト（ロック不要）
+        if (!dead) {
+            for (int k = 0; k < search_.playout_depth; ++k, ++depth) {
+                auto pair = pair_at(context, depth, rng);
+                int action = select_playout_action(sim, pair.first, pair.second, rng);
+                if (action < 0) {
+                    dead = true;
+                    break;
+                }
+                const Placement& placement = PLACEMENTS[action];
+                BitChainResult result = sim.place_and_simulate(placement.x, placement.r, pair.first, pair.second);
+                score += result.score;
+                if (sim.is_game_over()) {
+                    dead = true;
+                    break;
+                }
+            }
+        }
+
+        double reward = dead ? 0.0
+            : playout_.survival_weight + (1.0 - playout_.survival_weight) * (1.0 - std::exp(-score / playout_.score_scale));
+
+        // 逆伝播（訪問回数は選択時に加算済み）
+        {
+            std::unique_lock<std::mutex> lock;
+            if (tree_mutex) lock = std::unique_lock<std::mutex>(*tree_mutex);
+            for (int32_t node : path) {
+                tree[node].value_sum += reward;
+            }
+        }
+    }
+
+    std::pair<PuyoColor, PuyoColor> pair_at(const SearchContext& context, int depth, std::mt19937& rng) const {
+        if (depth < static_cast<int>(context.known_pairs.size())) {
+            return context.known_pairs[depth];
+        }
+        const auto& colors = context.sample_colors;
+        return {colors[rng() % colors.size()], colors[rng() % colors.size()]};
+    }
+
+    static int collect_legal(const BitField& field, int* legal) {
+        int count = 0;
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            if (field.can_place(PLACEMENTS[i].x, PLACEMENTS[i].r)) {
+                legal[count++] = i;
+            }
+        }
+        return count;
+    }
+
+    int select_uct(const Tree& tree, int32_t node, const int* legal, int legal_count) const {
+        double log_parent = std::log(static_cast<double>(std::max<uint32_t>(1, tree[node].visits)));
+        int best_action = legal[0];
+        double best_ucb = -std::numeric_limits<double>::max();
+
+        for (int k = 0; k < legal_count; ++k) {
+            const MCTSNode& child = tree[tree[node].children[legal[k]]];
+            double n = std::max<uint32_t>(1, child.visits);
+            double ucb = child.value_sum / n + search_.exploration_constant * std::sqrt(log_parent / n);
+            if (ucb > best_ucb) {
+                best_ucb = ucb;
+                best_action = legal[k];
+            }
+        }
+        return best_action;
+    }
+
+    // 軽量プレイアウト方策：着地点の同色隣接数と高さのみで評価（連鎖シミュレーションは行わない）
+    int select_playout_action(const BitField& field, PuyoColor axis, PuyoColor child, std::mt19937& rng) const {
+        int legal[PLACEMENT_COUNT];
+        int legal_count = collect_legal(field, legal);
+        if (legal_count == 0) return -1;
+
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        if (unit(rng) < playout_.random_rate) {
+            return legal[rng() % legal_count];
+        }
+
+        int best_action = legal[0];
+        double best_score = -std::numeric_limits<double>::max();
+        for (int k = 0; k < legal_count; ++k) {
+            const Placement& p = PLACEMENTS[legal[k]];
+            int axis_y = field.height(p.x);
+            int child_x = p.x;
+            int child_y = axis_y + 1;
+            if (p.r == 1 || p.r == 3) {
+                child_x = p.x + (p.r == 1 ? 1 : -1);
+                child_y = field.height(child_x);
+            } else if (p.r == 2) {
+                child_y = axis_y;
+                axis_y = axis_y + 1;
+            }
+
+            double score = playout_.adjacency_weight *
+                (count_same_neighbors(field, p.x, axis_y, axis) + count_same_neighbors(field, child_x, child_y, child));
+            if (axis == child && p.r != 1 && p.r != 3) {
+                score += playout_.adjacency_weight;
+            }
+            score -= playout_.height_weight * (axis_y + child_y);
+            score += unit(rng) * 0.5;  // 同点崩し
+
+            if (score > best_score) {
+                best_score = score;
+                best_action = legal[k];
+            }
+        }
+        return best_action;
+    }
+
+    static int count_same_neighbors(const BitField& field, int x, int y, PuyoColor color) {
+        if (y >= FIELD_HEIGHT) return 0;
+        BitBoard128 bits = field.get_color_bits(color);
+        int count = 0;
+        if (y > 0 && get_bit(bits, BitField::bit_index(x, y - 1))) count++;
+        if (y + 1 < FIELD_HEIGHT && get_bit(bits, BitField::bit_index(x, y + 1))) count++;
+        if (x > 0 && get_bit(bits, BitField::bit_index(x - 1, y))) count++;
+        if (x + 1 < FIELD_WIDTH && get_bit(bits, BitField::bit_index(x + 1, y))) count++;
+        return count;
+    }
+
+    // 回転状態を文字列に変換
+    std::string rotation_to_string(int r) const {
+        switch (r) {
+            case 0: return "UP";
+            case 1: return "RIGHT";
+            case 2: return "DOWN";
+            case 3: return "LEFT";
+            default: return "UNKNOWN";
+        }
+    }
+};
+
+} // namespace ai
+} // namespace puyo
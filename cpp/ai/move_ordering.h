@@ -0,0 +1,160 @@
+#pragma once
+
+#include "core/bit_field.h"
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <unordered_map>
+
+namespace puyo {
+namespace ai {
+
+// 探索用の手順序付け
+// 軽量な静的事前評価で候補手を並べ替え、結果盤面が同一の配置と、窒息点を埋める自殺手を事前に除外する。
+// 結果盤面が同一の配置は配置インデックスの最も小さい手だけを残す。評価関数が配置(x, r)自体にも依存する場合、
+// 除外した手の方が高く評価されることがあるため、重複除外を有効にすると選ぶ手が変わりうる。
+class MoveOrderer {
+public:
+    // 順序付け設定
+    struct Config {
+        bool prune_duplicates;     // 結果盤面が同一の配置を除外
+        bool prune_suicidal;       // 窒息する配置を除外（全手が窒息する場合は残す）
+        double adjacency_weight;   // 設置ぷよの同色隣接数の重み
+        double height_weight;      // 着地高さのペナルティ
+        double chain_weight;       // 即時連鎖数の重み
+
+        Config() : prune_duplicates(true), prune_suicidal(true), adjacency_weight(1.0),
+                  height_weight(0.3), chain_weight(2.0) {}
+    };
+
+    // 候補手（設置・連鎖後の盤面つき）
+    struct Candidate {
+        int index;              // PLACEMENTSのインデックス
+        BitField field;         // 設置・連鎖後の盤面
+        BitChainResult chain;   // 即時連鎖結果
+        double pre_score;       // 並べ替え用の事前スコア
+    };
+
+    // 直近の生成統計
+    struct Stats {
+        int generated;
+        int pruned_duplicate;
+        int pruned_suicidal;
+
+        Stats() : generated(0), pruned_duplicate(0), pruned_suicidal(0) {}
+    };
+
+    explicit MoveOrderer(const Config& config = Config()) : config_(config) {
+        clear();
+    }
+
+    void set_config(const Config& config) { config_ = config; }
+    const Config& get_config() const { return config_; }
+    const Stats& last_stats() const { return stats_; }
+
+    // 候補手を生成し、事前スコアの降順に並べる（同点は配置インデックス順）
+    std::vector<Candidate> generate(const BitField& field, PuyoColor axis, PuyoColor child) {
+        stats_ = Stats();
+
+        // ツモ色が不明な場合は盤面の同一性を判定できないため重複除外しない
+        bool colors_known = axis != PuyoColor::EMPTY && child != PuyoColor::EMPTY;
+
+        std::vector<Candidate> candidates;
+        std::vector<Candidate> suicidal;
+        candidates.reserve(PLACEMENT_COUNT);
+        std::unordered_map<uint64_t, size_t> seen;
+
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            const Placement& placement = PLACEMENTS[i];
+            if (!field.can_place(placement.x, placement.r)) continue;
+            stats_.generated++;
+
+            Candidate candidate;
+            candidate.index = i;
+            candidate.field = field;
+            candidate.chain = candidate.field.place_and_simulate(placement.x, placement.r, axis, child);
+            if (candidate.chain.chain_count < 0) continue;
+
+            candidate.pre_score = static_score(field, candidate, placement);
+
+            if (config_.prune_suicidal && candidate.field.is_game_over()) {
+                suicidal.push_back(std::move(candidate));
+                continue;
+            }
+
+            // 結果盤面が同一の配置（同色ペアの上下反転・左右入れ替えなど）を除外
+            if (config_.prune_duplicates && colors_known) {
+                uint64_t key = candidate.field.hash();
+                auto it = seen.find(key);
+                if (it != seen.end() && candidates[it->second].field == candidate.field) {
+                    stats_.pruned_duplicate++;
+                    continue;
+                }
+                seen.emplace(key, candidates.size());
+            }
+            candidates.push_back(std::move(candidate));
+        }
+
+        // 全手が窒息する場合は除外せずに返す
+        if (candidates.empty()) {
+            candidates = std::move(suicidal);
+        } else {
+            stats_.pruned_suicidal = static_cast<int>(suicidal.size());
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const Candidate& a, const Candidate& b) { return a.pre_score > b.pre_score; });
+        return candidates;
+    }
+
+    void clear() {
+        stats_ = Stats();
+    }
+
+private:
+    Config config_;
+    Stats stats_;
+
+    // 軽量な静的事前評価（着地高さ・設置ぷよの同色隣接・即時連鎖）
+    double static_score(const BitField& before, const Candidate& candidate, const Placement& placement) const {
+        double score = 0.0;
+
+        int landing = before.height(placement.x);
+        if (placement.r == 1 && placement.x + 1 < FIELD_WIDTH) {
+            landing = std::max(landing, before.height(placement.x + 1));
+        } else if (placement.r == 3 && placement.x > 0) {
+            landing = std::max(landing, before.height(placement.x - 1));
+        }
+        score -= landing * config_.height_weight;
+
+        if (candidate.chain.has_chains()) {
+            return score + candidate.chain.chain_count * config_.chain_weight;
+        }
+
+        // 連鎖が起きない場合、増えたビットが今回設置したぷよ
+        BitBoard128 placed = candidate.field.get_occupied_bits() & ~before.get_occupied_bits();
+        BitBoard128 mask = BitField::field_mask();
+        int adjacency = 0;
+        for (int c = static_cast<int>(PuyoColor::RED); c < static_cast<int>(PuyoColor::GARBAGE); ++c) {
+            PuyoColor color = static_cast<PuyoColor>(c);
+            BitBoard128 bits = candidate.field.get_color_bits(color);
+            BitBoard128 own = placed & bits;
+            if (own == 0) continue;
+
+            BitBoard128 others = bits & ~own;
+            BitBoard128 neighbors = ((own << 1) | (own >> 1) |
+                                     (own << BitField::COLUMN_STRIDE) |
+                                     (own >> BitField::COLUMN_STRIDE)) & mask;
+            adjacency += popcount(neighbors & others);
+        }
+        return score + adjacency * config_.adjacency_weight;
+    }
+
+    static int popcount(BitBoard128 board) {
+        return __builtin_popcountll(static_cast<uint64_t>(board)) +
+               __builtin_popcountll(static_cast<uint64_t>(board >> 64));
+    }
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace puyo {
+namespace ai {
+
+// ロックフリーの固定容量キュー（複数生産者・単一消費者）
+// 各セルに書き込み順の番号を持たせ、生産者はCASで書き込み位置を確保する。
+// 消費者は1スレッドだけなので取り出し位置は自分だけが進める。
+// 容量は2の冪に切り上げる。
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t capacity) : enqueue_pos_(0), dequeue_pos_(0) {
+        capacity_ = 2;
+        while (capacity_ < capacity) capacity_ <<= 1;
+        mask_ = capacity_ - 1;
+        cells_.reset(new Cell[capacity_]);
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // 満杯ならfalse（呼び出し側で待つ）
+    bool try_push(const T& value) {
+        size_t position = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 空ならfalse（消費者スレッドからのみ呼ぶ）
+    bool try_pop(T& value) {
+        Cell& cell = cells_[dequeue_pos_ & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeue_pos_ + 1) return false;
+        value = cell.value;
+        cell.sequence.store(dequeue_pos_ + capacity_, std::memory_order_release);
+        dequeue_pos_++;
+        return true;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t capacity_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) size_t dequeue_pos_;
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,570 @@
+#include "nazo_solver.h"
+#include "all_clear_finder.h"
+#include "core/chain_system.h"
+#include "core/field.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace puyo {
+namespace ai {
+
+namespace {
+
+using PairList = NazoPuzzle::PairList;
+using ColorCounts = std::array<int, 5>;
+
+bool parse_color(char c, PuyoColor& color) {
+    switch (std::toupper(static_cast<unsigned char>(c))) {
+        case 'R': color = PuyoColor::RED; return true;
+        case 'G': color = PuyoColor::GREEN; return true;
+        case 'B': color = PuyoColor::BLUE; return true;
+        case 'Y': color = PuyoColor::YELLOW; return true;
+        case 'P': color = PuyoColor::PURPLE; return true;
+        case 'O': color = PuyoColor::GARBAGE; return true;
+        default: return false;
+    }
+}
+
+char color_char(PuyoColor color) {
+    switch (color) {
+        case PuyoColor::RED: return 'R';
+        case PuyoColor::GREEN: return 'G';
+        case PuyoColor::BLUE: return 'B';
+        case PuyoColor::YELLOW: return 'Y';
+        case PuyoColor::PURPLE: return 'P';
+        case PuyoColor::GARBAGE: return 'O';
+        default: return '.';
+    }
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+bool parse_field(const std::string& text, BitField& field, std::string* error) {
+    field = BitField();
+    if (text == "-") return true;
+
+    std::vector<std::string> rows;
+    std::string row;
+    std::istringstream stream(text);
+    while (std::getline(stream, row, '/')) {
+        rows.push_back(row);
+    }
+    if (rows.empty() || rows.size() > static_cast<size_t>(FIELD_HEIGHT - 1)) {
+        return fail(error, "field must have 1-13 rows");
+    }
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+        int y = static_cast<int>(rows.size() - 1 - i);
+        int x = 0;
+        for (char c : rows[i]) {
+            if (std::isdigit(static_cast<unsigned char>(c))) {
+                x += c - '0';
+                continue;
+            }
+            PuyoColor color;
+            if (!parse_color(c, color)) {
+                return fail(error, "invalid cell '" + std::string(1, c) + "' in row " + std::to_string(i + 1));
+            }
+            if (x >= FIELD_WIDTH) {
+                return fail(error, "row " + std::to_string(i + 1) + " has more than 6 cells");
+            }
+            field.set_puyo(x++, y, color);
+        }
+        if (x != FIELD_WIDTH) {
+            return fail(error, "row " + std::to_string(i + 1) + " must have 6 cells");
+        }
+    }
+
+    // 浮いているぷよがある盤面は受け付けない
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        for (int y = 1; y < FIELD_HEIGHT - 1; ++y) {
+            if (field.get_puyo(x, y) != PuyoColor::EMPTY && field.get_puyo(x, y - 1) == PuyoColor::EMPTY) {
+                return fail(error, "floating puyo in column " + std::to_string(x + 1));
+            }
+        }
+    }
+    return true;
+}
+
+bool parse_pairs(const std::string& text, PairList& pairs, std::string* error) {
+    pairs.clear();
+    std::string token;
+    std::istringstream stream(text);
+    while (std::getline(stream, token, ',')) {
+        PuyoColor axis, child;
+        if (token.size() != 2 || !parse_color(token[0], axis) || !parse_color(token[1], child) ||
+            axis == PuyoColor::GARBAGE || child == PuyoColor::GARBAGE) {
+            return fail(error, "invalid pair '" + token + "'");
+        }
+        pairs.emplace_back(axis, child);
+    }
+    if (pairs.empty()) return fail(error, "no pairs");
+    return true;
+}
+
+bool parse_goal(const std::string& text, NazoPuzzle& puzzle, std::string* error) {
+    if (text == "clear") {
+        puzzle.goal = NazoPuzzle::Goal::ALL_CLEAR;
+        puzzle.target = 0;
+        return true;
+    }
+
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) return fail(error, "invalid goal '" + text + "'");
+    std::string kind = text.substr(0, colon);
+    std::string value = text.substr(colon + 1);
+    if (value.empty() || !std::all_of(value.begin(), value.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+        return fail(error, "invalid goal value '" + value + "'");
+    }
+
+    if (kind == "chain") {
+        puzzle.goal = NazoPuzzle::Goal::CHAIN;
+    } else if (kind == "score") {
+        puzzle.goal = NazoPuzzle::Goal::SCORE;
+    } else {
+        return fail(error, "unknown goal '" + kind + "'");
+    }
+    puzzle.target = std::stoi(value);
+    return true;
+}
+
+// 配置後に条件を満たしたか
+bool goal_reached(const NazoPuzzle& puzzle, const BitChainResult& result, int total_score) {
+    switch (puzzle.goal) {
+        case NazoPuzzle::Goal::ALL_CLEAR: return result.all_clear;
+        case NazoPuzzle::Goal::SCORE:     return result.has_chains() && total_score >= puzzle.target;
+        case NazoPuzzle::Goal::CHAIN:
+        default:                          return result.chain_count >= puzzle.target;
+    }
+}
+
+// 探索の共有情報
+struct SearchShared {
+    const NazoPuzzle& puzzle;
+    std::vector<ColorCounts> remaining_colors;  // 各手数以降のツモに含まれる色ごとの個数
+    bool find_all;
+    size_t max_solutions;
+    std::atomic<bool> stop;                     // 全解モードで上限に達した
+    std::atomic<int> first_task;                // 最初の解モードで解が見つかった最小のタスク
+    std::atomic<size_t> solution_count;
+
+    SearchShared(const NazoPuzzle& puzzle, const NazoSolver::Options& options)
+        : puzzle(puzzle), find_all(options.find_all), max_solutions(options.max_solutions),
+          stop(false), first_task(INT_MAX), solution_count(0) {
+        size_t count = puzzle.pairs.size();
+        remaining_colors.assign(count + 1, ColorCounts{});
+        for (size_t depth = count; depth-- > 0;) {
+            remaining_colors[depth] = remaining_colors[depth + 1];
+            remaining_colors[depth][static_cast<int>(puzzle.pairs[depth].first) - 1]++;
+            remaining_colors[depth][static_cast<int>(puzzle.pairs[depth].second) - 1]++;
+        }
+    }
+
+    // 残りのツモで条件を満たす可能性があるか
+    bool can_reach(const BitField& field, size_t depth) const {
+        int remaining_pairs = static_cast<int>(puzzle.pairs.size() - depth);
+        if (remaining_pairs <= 0) return false;
+
+        switch (puzzle.goal) {
+            case NazoPuzzle::Goal::CHAIN: {
+                // N連鎖には色ぷよが4N個以上必要
+                int colored = field.count_puyos() - field.count_color(PuyoColor::GARBAGE);
+                return colored + remaining_pairs * 2 >= puzzle.target * 4;
+            }
+            case NazoPuzzle::Goal::ALL_CLEAR:
+                return AllClearFinder::can_still_clear(field, remaining_colors[depth], 0);
+            case NazoPuzzle::Goal::SCORE:
+            default:
+                return true;
+        }
+    }
+};
+
+struct Counters {
+    long long nodes = 0;
+    long long pruned = 0;
+    long long dead_hits = 0;
+    long long duplicate_moves = 0;
+
+    void add(const Counters& other) {
+        nodes += other.nodes;
+        pruned += other.pruned;
+        dead_hits += other.dead_hits;
+        duplicate_moves += other.duplicate_moves;
+    }
+};
+
+// 全配置を試す（同じ盤面・同じ得点になる配置は最初の1つだけ）
+// visitがfalseを返したら打ち切る
+template <typename Visit>
+void for_each_move(const NazoPuzzle& puzzle, const BitField& field, size_t depth, Counters& counters, Visit visit) {
+    const auto& pair = puzzle.pairs[depth];
+    std::array<std::pair<uint64_t, int>, PLACEMENT_COUNT> seen;
+    int seen_count = 0;
+
+    for (int index = 0; index < PLACEMENT_COUNT; ++index) {
+        const Placement& placement = PLACEMENTS[index];
+        BitField next = field;
+        BitChainResult result = next.place_and_simulate(placement.x, placement.r, pair.first, pair.second);
+        if (result.chain_count < 0 || next.is_game_over()) continue;
+
+        std::pair<uint64_t, int> key(next.hash(), result.score);
+        if (std::find(seen.begin(), seen.begin() + seen_count, key) != seen.begin() + seen_count) {
+            counters.duplicate_moves++;
+            continue;
+        }
+        seen[seen_count++] = key;
+
+        counters.nodes++;
+        if (!visit(index, next, result)) return;
+    }
+}
+
+NazoSolution make_solution(const std::vector<int>& path, const BitChainResult& result, int total_score) {
+    NazoSolution solution;
+    solution.placements = path;
+    solution.chain_count = result.chain_count;
+    solution.total_score = total_score;
+    solution.all_clear = result.all_clear;
+    return solution;
+}
+
+// 探索タスク（ルート付近の配置列）
+struct Task {
+    BitField field;
+    std::vector<int> path;
+    int score = 0;
+    bool solved = false;        // この配置列で条件を満たした
+    NazoSolution solution;
+};
+
+// スレッドごとの深さ優先探索
+class Searcher {
+public:
+    explicit Searcher(SearchShared& shared) : shared_(shared), task_index_(0), aborted_(false) {}
+
+    void run(const Task& task, int task_index, std::vector<NazoSolution>& out) {
+        task_index_ = task_index;
+        aborted_ = false;
+        std::vector<int> path = task.path;
+        dfs(task.field, task.path.size(), task.score, path, out);
+    }
+
+    Counters counters;
+
+private:
+    SearchShared& shared_;
+    int task_index_;
+    bool aborted_;
+    std::unordered_set<uint64_t> dead_;   // 解が無いと確定した（盤面, 手数, 得点）
+
+    bool should_abort() const {
+        if (shared_.stop.load(std::memory_order_relaxed)) return true;
+        return !shared_.find_all && shared_.first_task.load(std::memory_order_relaxed) < task_index_;
+    }
+
+    uint64_t dead_key(const BitField& field, size_t depth, int score) const {
+        uint64_t key = field.hash() ^ (static_cast<uint64_t>(depth + 1) * 0x9E3779B97F4A7C15ULL);
+        if (shared_.puzzle.goal == NazoPuzzle::Goal::SCORE) {
+            key ^= static_cast<uint64_t>(score) * 0xBF58476D1CE4E5B9ULL;
+        }
+        return key;
+    }
+
+    // 部分木に解があればtrue
+    bool dfs(const BitField& field, size_t depth, int score, std::vector<int>& path, std::vector<NazoSolution>& out) {
+        if (!shared_.can_reach(field, depth)) {
+            counters.pruned++;
+            return false;
+        }
+
+        uint64_t key = dead_key(field, depth, score);
+        if (dead_.count(key)) {
+            counters.dead_hits++;
+            return false;
+        }
+
+        bool found = false;
+        for_each_move(shared_.puzzle, field, depth, counters,
+                      [&](int index, const BitField& next, const BitChainResult& result) {
+            if (should_abort()) {
+                aborted_ = true;
+                return false;
+            }
+
+            int next_score = score + result.score;
+            path.push_back(index);
+            bool solved = false;
+            if (goal_reached(shared_.puzzle, result, next_score)) {
+                out.push_back(make_solution(path, result, next_score));
+                solved = true;
+                if (shared_.find_all && ++shared_.solution_count >= shared_.max_solutions) {
+                    shared_.stop = true;
+                }
+            } else if (depth + 1 < shared_.puzzle.pairs.size()) {
+                solved = dfs(next, depth + 1, next_score, path, out);
+            }
+            path.pop_back();
+
+            found = found || solved;
+            return !(solved && !shared_.find_all);
+        });
+
+        if (!found && !aborted_) {
+            dead_.insert(key);
+        }
+        return found;
+    }
+};
+
+// ルート付近（split_depth手）までの配置列をタスクとして列挙する（配置順）
+void generate_tasks(const SearchShared& shared, const BitField& field, size_t depth, int score, size_t split_depth,
+                    std::vector<int>& path, std::vector<Task>& tasks, Counters& counters) {
+    if (!shared.can_reach(field, depth)) {
+        counters.pruned++;
+        return;
+    }
+
+    for_each_move(shared.puzzle, field, depth, counters,
+                  [&](int index, const BitField& next, const BitChainResult& result) {
+        int next_score = score + result.score;
+        path.push_back(index);
+        if (goal_reached(shared.puzzle, result, next_score)) {
+            Task task;
+            task.path = path;
+            task.solved = true;
+            task.solution = make_solution(path, result, next_score);
+            tasks.push_back(std::move(task));
+        } else if (depth + 1 < shared.puzzle.pairs.size()) {
+            if (depth + 1 < split_depth) {
+                generate_tasks(shared, next, depth + 1, next_score, split_depth, path, tasks, counters);
+            } else {
+                Task task;
+                task.field = next;
+                task.path = path;
+                task.score = next_score;
+                tasks.push_back(std::move(task));
+            }
+        }
+        path.pop_back();
+        return true;
+    });
+}
+
+} // namespace
+
+bool NazoPuzzle::parse(const std::string& text, NazoPuzzle& puzzle, std::string* error) {
+    std::istringstream stream(text);
+    std::string field_text, pairs_text, goal_text, extra;
+    if (!(stream >> field_text >> pairs_text >> goal_text) || (stream >> extra)) {
+        return fail(error, "expected '<field> <pairs> <goal>'");
+    }
+
+    NazoPuzzle parsed;
+    if (!parse_field(field_text, parsed.field, error)) return false;
+    if (!parse_pairs(pairs_text, parsed.pairs, error)) return false;
+    if (!parse_goal(goal_text, parsed, error)) return false;
+    puzzle = parsed;
+    return true;
+}
+
+std::string NazoPuzzle::to_string() const {
+    std::string text;
+
+    int top = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        top = std::max(top, field.height(x));
+    }
+    top = std::min(top, FIELD_HEIGHT - 1);
+    if (top == 0) {
+        text = "-";
+    }
+    for (int y = top - 1; y >= 0; --y) {
+        int empty = 0;
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            PuyoColor color = field.get_puyo(x, y);
+            if (color == PuyoColor::EMPTY) {
+                empty++;
+                continue;
+            }
+            if (empty > 0) text += static_cast<char>('0' + empty);
+            empty = 0;
+            text += color_char(color);
+        }
+        if (empty > 0) text += static_cast<char>('0' + empty);
+        if (y > 0) text += '/';
+    }
+
+    text += ' ';
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        if (i > 0) text += ',';
+        text += color_char(pairs[i].first);
+        text += color_char(pairs[i].second);
+    }
+
+    text += ' ';
+    switch (goal) {
+        case Goal::ALL_CLEAR: text += "clear"; break;
+        case Goal::SCORE:     text += "score:" + std::to_string(target); break;
+        case Goal::CHAIN:
+        default:              text += "chain:" + std::to_string(target); break;
+    }
+    return text;
+}
+
+NazoSolver::Result NazoSolver::solve(const NazoPuzzle& puzzle, const Options& options) {
+    auto start_time = std::chrono::steady_clock::now();
+    Result result;
+    SearchShared shared(puzzle, options);
+
+    int threads = options.threads > 0 ? options.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, threads);
+
+    // ルート2手分（最大22^2）をタスクにしてスレッドに配る
+    Counters root_counters;
+    std::vector<Task> tasks;
+    std::vector<int> path;
+    size_t split_depth = std::min<size_t>(2, puzzle.pairs.size());
+    if (!puzzle.pairs.empty()) {
+        generate_tasks(shared, puzzle.field, 0, 0, split_depth, path, tasks, root_counters);
+    }
+
+    std::vector<std::vector<NazoSolution>> task_solutions(tasks.size());
+    std::atomic<size_t> next_task(0);
+    std::mutex counters_mutex;
+    Counters total = root_counters;
+
+    auto worker = [&]() {
+        Searcher searcher(shared);
+        while (true) {
+            size_t index = next_task.fetch_add(1);
+            if (index >= tasks.size() || shared.stop) break;
+            int task_index = static_cast<int>(index);
+            if (!shared.find_all && shared.first_task.load() < task_index) continue;
+
+            const Task& task = tasks[index];
+            auto& out = task_solutions[index];
+            if (task.solved) {
+                out.push_back(task.solution);
+                if (shared.find_all && ++shared.solution_count >= shared.max_solutions) {
+                    shared.stop = true;
+                }
+            } else {
+                searcher.run(task, task_index, out);
+            }
+
+            if (!out.empty() && !shared.find_all) {
+                int current = shared.first_task.load();
+                while (task_index < current && !shared.first_task.compare_exchange_weak(current, task_index)) {}
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(counters_mutex);
+        total.add(searcher.counters);
+    };
+
+    int worker_count = std::max(1, std::min<int>(threads, static_cast<int>(tasks.size())));
+    std::vector<std::thread> workers;
+    for (int i = 1; i < worker_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    // タスク順（配置順）に解を並べる
+    for (auto& solutions : task_solutions) {
+        for (auto& solution : solutions) {
+            if (result.solutions.size() >= (options.find_all ? options.max_solutions : 1)) break;
+            result.solutions.push_back(std::move(solution));
+        }
+    }
+
+    result.nodes = total.nodes;
+    result.pruned = total.pruned;
+    result.dead_hits = total.dead_hits;
+    result.duplicate_moves = total.duplicate_moves;
+    result.truncated = shared.stop;
+    result.threads = worker_count;
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start_time).count();
+    return result;
+}
+
+bool NazoSolver::verify(const NazoPuzzle& puzzle, const NazoSolution& solution, std::string* error) {
+    if (solution.placements.empty() || solution.placements.size() > puzzle.pairs.size()) {
+        return fail(error, "invalid placement count");
+    }
+
+    BitField bit_field = puzzle.field;
+    int total_score = 0;
+    BitChainResult last;
+    for (size_t i = 0; i < solution.placements.size(); ++i) {
+        const Placement& placement = PLACEMENTS[solution.placements[i]];
+        std::string step = "step " + std::to_string(i + 1) + ": ";
+        if (!bit_field.place_pair(placement.x, placement.r, puzzle.pairs[i].first, puzzle.pairs[i].second)) {
+            return fail(error, step + "cannot place " + format_placement(solution.placements[i]));
+        }
+
+        // 設置直後の盤面を通常の連鎖処理とビットボードの連鎖処理で比較する
+        Field field = bit_field.to_field();
+        ChainSystem chain_system(&field);
+        ChainSystemResult expected = chain_system.execute_chains();
+        last = bit_field.simulate();
+
+        if (expected.total_chains != last.chain_count) {
+            return fail(error, step + "chain count " + std::to_string(last.chain_count) +
+                               " != " + std::to_string(expected.total_chains));
+        }
+        if (expected.score_result.total_score != last.score) {
+            return fail(error, step + "score " + std::to_string(last.score) +
+                               " != " + std::to_string(expected.score_result.total_score));
+        }
+        if (BitField::from_field(field) != bit_field) {
+            return fail(error, step + "field mismatch after chain");
+        }
+        total_score += last.score;
+    }
+
+    if (last.chain_count != solution.chain_count || total_score != solution.total_score ||
+        last.all_clear != solution.all_clear) {
+        return fail(error, "solution summary does not match replay");
+    }
+
+    if (!goal_reached(puzzle, last, total_score)) return fail(error, "goal not reached");
+    return true;
+}
+
+std::string NazoSolver::format_placement(int index) {
+    static const char* ROTATION_NAMES[4] = {"UP", "RIGHT", "DOWN", "LEFT"};
+    if (index < 0 || index >= PLACEMENT_COUNT) return "?";
+    const Placement& placement = PLACEMENTS[index];
+    return std::to_string(placement.x + 1) + ":" + ROTATION_NAMES[placement.r & 3];
+}
+
+std::string NazoSolver::format_solution(const NazoSolution& solution) {
+    std::string text;
+    for (size_t i = 0; i < solution.placements.size(); ++i) {
+        if (i > 0) text += ' ';
+        text += format_placement(solution.placements[i]);
+    }
+    text += " (chain=" + std::to_string(solution.chain_count) +
+            ", score=" + std::to_string(solution.total_score) +
+            (solution.all_clear ? ", all_clear" : "") + ")";
+    return text;
+}
+
+} // namespace ai
+} // namespace puyo
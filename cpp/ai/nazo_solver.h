@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/bit_field.h"
+#include "core/puyo_types.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// なぞぷよ問題（盤面 + 使えるツモ + 条件）
+//
+// テキスト形式（空白区切りの3項目）:
+//   <盤面> <ツモ> <条件>
+//   盤面: 上の段から順に'/'区切り。R/G/B/Y/P=色, O=おじゃま, 数字=空きマス数（各段6マス）
+//         最下段が最後。空の盤面は"-"
+//   ツモ: 軸・子の2文字をカンマ区切り（例: RG,BB）
+//   条件: chain:N（N連鎖以上）, score:N（合計N点以上）, clear（全消し）
+//   例: "R5/RG4/GGB3 BR,BB chain:3"
+struct NazoPuzzle {
+    enum class Goal {
+        CHAIN,       // target連鎖以上
+        SCORE,       // 合計target点以上
+        ALL_CLEAR    // 全消し
+    };
+
+    using PairList = std::vector<std::pair<PuyoColor, PuyoColor>>;
+
+    BitField field;
+    PairList pairs;
+    Goal goal;
+    int target;
+
+    NazoPuzzle() : goal(Goal::CHAIN), target(0) {}
+
+    // テキスト形式から読み込む（不正な場合はfalseとerrorに理由）
+    static bool parse(const std::string& text, NazoPuzzle& puzzle, std::string* error = nullptr);
+    std::string to_string() const;
+};
+
+// 解（条件を満たした時点までの配置列）
+struct NazoSolution {
+    std::vector<int> placements;  // PLACEMENTSのインデックス
+    int chain_count;              // 最後の配置で起きた連鎖数
+    int total_score;              // 合計得点
+    bool all_clear;
+
+    NazoSolution() : chain_count(0), total_score(0), all_clear(false) {}
+};
+
+// なぞぷよソルバー
+// ルート付近の配置列をタスクに分けて並列に深さ優先探索する。
+// 同じ親から同じ盤面・同じ得点になる配置（同色ツモの向き違いなど）は配置順で最初の1つにまとめ、
+// 全解モードでもまとめた配置は別の解として列挙しない。
+// 解が無いと確定した（盤面, 手数）はハッシュで記録して再探索しない。
+// 条件ごとに、残りのぷよ数では達成できない局面を枝刈りする。
+class NazoSolver {
+public:
+    struct Options {
+        int threads;                  // 並列数（0ならハードウェア並列数）
+        bool find_all;                // 全解を求めるか（falseなら配置順で最初の解、同じ盤面になる配置は1つにまとめる）
+        size_t max_solutions;         // 全解モードの上限
+
+        Options() : threads(0), find_all(false), max_solutions(10000) {}
+    };
+
+    struct Result {
+        std::vector<NazoSolution> solutions;
+        long long nodes;            // 展開した局面数
+        long long pruned;           // 条件による枝刈り数
+        long long dead_hits;        // 解無し局面の再訪を省略した数
+        long long duplicate_moves;  // 同じ盤面になる配置をまとめた数
+        bool truncated;             // max_solutionsで打ち切ったか
+        int threads;
+        double elapsed_ms;
+
+        Result() : nodes(0), pruned(0), dead_hits(0), duplicate_moves(0), truncated(false),
+                   threads(0), elapsed_ms(0.0) {}
+    };
+
+    static Result solve(const NazoPuzzle& puzzle, const Options& options = Options());
+
+    // 通常のField/ChainSystemで解を再生し、ビットボードの結果と一致するか確認する
+    static bool verify(const NazoPuzzle& puzzle, const NazoSolution& solution, std::string* error = nullptr);
+
+    // 配置の表示（"3:UP"形式、列は1始まり）
+    static std::string format_placement(int index);
+    static std::string format_solution(const NazoSolution& solution);
+};
+
+} // namespace ai
+} // namespace puyo
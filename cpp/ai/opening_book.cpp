@@ -0,0 +1,180 @@
+#include "opening_book.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace puyo {
+namespace ai {
+
+namespace {
+
+constexpr char BOOK_MAGIC[8] = {'P', 'U', 'Y', 'O', 'B', 'O', 'O', 'K'};
+
+inline uint64_t mix64(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+// ヘッダーの妥当性チェック
+bool validate_header(const OpeningBook::Header& header, size_t file_size) {
+    if (std::memcmp(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0) return false;
+    if (header.version != OpeningBook::FORMAT_VERSION) return false;
+    if (header.pair_count != static_cast<uint32_t>(OpeningBook::PAIR_COUNT)) return false;
+    return file_size == sizeof(OpeningBook::Header) +
+                        static_cast<size_t>(header.entry_count) * sizeof(OpeningBookEntry);
+}
+
+} // namespace
+
+OpeningBook::OpeningBook() : entries_(nullptr), entry_count_(0), max_turns_(0) {}
+
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+bool OpeningBook::open(const std::string& path) {
+    close();
+
+    if (!file_.open(path)) return false;
+
+    Header header;
+    if (file_.size() < sizeof(Header)) {
+        file_.close();
+        return false;
+    }
+    std::memcpy(&header, file_.data(), sizeof(Header));
+    if (!validate_header(header, file_.size())) {
+        file_.close();
+        return false;
+    }
+
+    entries_ = reinterpret_cast<const OpeningBookEntry*>(file_.data() + sizeof(Header));
+    entry_count_ = header.entry_count;
+    max_turns_ = static_cast<int>(header.max_turns);
+    return true;
+}
+
+void OpeningBook::close() {
+    file_.close();
+    entries_ = nullptr;
+    entry_count_ = 0;
+    max_turns_ = 0;
+}
+
+const OpeningBookEntry* OpeningBook::find(uint64_t key) const {
+    if (!entries_) return nullptr;
+
+    const OpeningBookEntry* end = entries_ + entry_count_;
+    const OpeningBookEntry* it = std::lower_bound(entries_, end, key,
+        [](const OpeningBookEntry& entry, uint64_t k) { return entry.key < k; });
+    return (it != end && it->key == key) ? it : nullptr;
+}
+
+int OpeningBook::lookup(const BitField& field, const PairList& pairs) const {
+    if (!entries_ || static_cast<int>(pairs.size()) < PAIR_COUNT) return -1;
+
+    // 収録手数を超えて置かれている盤面は序盤ではない
+    if (field.count_puyos() > max_turns_ * 2) return -1;
+
+    PairList key_pairs(pairs.begin(), pairs.begin() + PAIR_COUNT);
+    const OpeningBookEntry* entry = find(make_key(field, key_pairs));
+    if (!entry || entry->placement >= PLACEMENT_COUNT) return -1;
+
+    const Placement& placement = PLACEMENTS[entry->placement];
+    return field.can_place(placement.x, placement.r) ? entry->placement : -1;
+}
+
+int OpeningBook::lookup(const Field& field, const PuyoPair& current,
+                        const std::vector<PuyoPair>& next_queue) const {
+    if (!entries_ || static_cast<int>(next_queue.size()) < PAIR_COUNT - 1) return -1;
+
+    PairList pairs;
+    pairs.emplace_back(current.axis, current.child);
+    for (int i = 0; i < PAIR_COUNT - 1; ++i) {
+        pairs.emplace_back(next_queue[i].axis, next_queue[i].child);
+    }
+    return lookup(BitField::from_field(field), pairs);
+}
+
+uint64_t OpeningBook::make_key(const BitField& field, const PairList& pairs) {
+    // 出現順に色番号を振り直す（おじゃまは固定）
+    std::array<uint8_t, COLOR_COUNT + 1> remap{};
+    uint8_t next_id = 1;
+    auto assign = [&](PuyoColor color) -> PuyoColor {
+        int c = static_cast<int>(color);
+        if (color == PuyoColor::EMPTY || color == PuyoColor::GARBAGE) return color;
+        if (remap[c] == 0) remap[c] = next_id++;
+        return static_cast<PuyoColor>(remap[c]);
+    };
+
+    BitField normalized;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        for (int y = 0; y < FIELD_HEIGHT; ++y) {
+            PuyoColor color = field.get_puyo(x, y);
+            if (color != PuyoColor::EMPTY) {
+                normalized.set_puyo(x, y, assign(color));
+            }
+        }
+    }
+
+    uint64_t key = normalized.hash();
+    for (const auto& pair : pairs) {
+        uint64_t a = static_cast<uint64_t>(assign(pair.first));
+        uint64_t b = static_cast<uint64_t>(assign(pair.second));
+        key = mix64(key ^ ((a << 8) | b | 0x10000ULL));
+    }
+    return key;
+}
+
+bool OpeningBook::write(const std::string& path, std::vector<OpeningBookEntry> entries,
+                        int max_turns, int color_count) {
+    std::sort(entries.begin(), entries.end(),
+              [](const OpeningBookEntry& a, const OpeningBookEntry& b) { return a.key < b.key; });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [](const OpeningBookEntry& a, const OpeningBookEntry& b) { return a.key == b.key; }),
+                  entries.end());
+
+    Header header;
+    std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.pair_count = PAIR_COUNT;
+    header.max_turns = static_cast<uint32_t>(max_turns);
+    header.color_count = static_cast<uint32_t>(color_count);
+    header.reserved = 0;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(OpeningBookEntry));
+    return static_cast<bool>(file);
+}
+
+std::shared_ptr<const OpeningBook> OpeningBook::load_shared(const std::string& path) {
+    static std::mutex cache_mutex;
+    static std::map<std::string, std::weak_ptr<const OpeningBook>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(path);
+    if (it != cache.end()) {
+        if (auto book = it->second.lock()) return book;
+    }
+
+    auto book = std::make_shared<OpeningBook>();
+    if (!book->open(path)) return nullptr;
+
+    std::shared_ptr<const OpeningBook> shared = book;
+    cache[path] = shared;
+    return shared;
+}
+
+} // namespace ai
+} // namespace puyo
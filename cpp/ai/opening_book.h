@@ -0,0 +1,89 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "core/bit_field.h"
+#include "core/puyo_types.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+namespace puyo {
+namespace ai {
+
+// 定跡エントリ（16バイト、キー昇順でファイルに格納）
+struct OpeningBookEntry {
+    uint64_t key;        // 色正規化済み局面キー
+    uint8_t placement;   // PLACEMENTSのインデックス
+    uint8_t turn;        // 何手目の局面か（0始まり）
+    uint16_t reserved;
+    int32_t value;       // 構築時の探索評価値
+};
+static_assert(sizeof(OpeningBookEntry) == 16, "OpeningBookEntry must be 16 bytes");
+
+// 初手定跡ブック
+// 空フィールドからの序盤局面（盤面 + 現在・NEXT・NEXT2）を色正規化したキーで引き、
+// オフライン探索で求めた配置を返す。ファイルはmmapで読み込み、二分探索で検索する。
+//
+// ファイル形式（リトルエンディアン）:
+//   Header（32バイト） + OpeningBookEntry × entry_count（key昇順）
+class OpeningBook {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr int PAIR_COUNT = 3;  // キーに含めるツモ数（現在 + NEXT + NEXT2）
+
+    struct Header {
+        char magic[8];          // "PUYOBOOK"
+        uint32_t version;
+        uint32_t entry_count;
+        uint32_t pair_count;
+        uint32_t max_turns;     // 収録している手数
+        uint32_t color_count;   // 構築時の色数
+        uint32_t reserved;
+    };
+    static_assert(sizeof(Header) == 32, "OpeningBook::Header must be 32 bytes");
+
+    using PairList = std::vector<std::pair<PuyoColor, PuyoColor>>;
+
+    OpeningBook();
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    // ファイルを開く（形式不正・存在しない場合はfalse）
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return entries_ != nullptr; }
+    size_t size() const { return entry_count_; }
+    int max_turns() const { return max_turns_; }
+
+    // 局面から配置インデックスを検索（未収録なら-1）
+    int lookup(const BitField& field, const PairList& pairs) const;
+    int lookup(const Field& field, const PuyoPair& current, const std::vector<PuyoPair>& next_queue) const;
+
+    // キーでエントリ検索（未収録ならnullptr）
+    const OpeningBookEntry* find(uint64_t key) const;
+
+    // 色正規化した局面キー
+    // 盤面の色を出現順（列優先・下から）、続いてツモの出現順に振り直してからハッシュする
+    static uint64_t make_key(const BitField& field, const PairList& pairs);
+
+    // ブックの書き出し（構築ツール用、エントリはキー順に整列・重複排除される）
+    static bool write(const std::string& path, std::vector<OpeningBookEntry> entries,
+                      int max_turns, int color_count);
+
+    // パスごとに共有されるインスタンス（開けなかった場合はnullptr）
+    static std::shared_ptr<const OpeningBook> load_shared(const std::string& path);
+
+private:
+    MappedFile file_;
+    const OpeningBookEntry* entries_;
+    size_t entry_count_;
+    int max_turns_;
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,455 @@
+#include "pattern_matcher.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+namespace puyo {
+namespace ai {
+
+namespace {
+
+constexpr char PATTERN_MAGIC[8] = {'P', 'U', 'Y', 'O', 'P', 'A', 'T', 'N'};
+constexpr int MAX_PATTERN_HEIGHT = FIELD_HEIGHT - 1;  // 14段目は落下しないため対象外
+constexpr int PLAYABLE_COLORS = 5;                    // RED-PURPLE
+
+inline int popcount128(BitBoard128 board) {
+    return __builtin_popcountll(static_cast<uint64_t>(board)) +
+           __builtin_popcountll(static_cast<uint64_t>(board >> 64));
+}
+
+inline std::string trim(const std::string& str) {
+    size_t start = str.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
+
+// テンプレートの1セル
+struct TemplateCell {
+    int x, y;
+    char letter;
+};
+
+// 解析中のパターン定義
+struct PatternSource {
+    std::string name;
+    double weight = 1.0;
+    bool mirror = false;
+    bool shift = false;
+    std::vector<std::string> rows;
+};
+
+bool parse_bool(const std::string& value) {
+    return value == "true" || value == "yes" || value == "1";
+}
+
+// セル配置からパターンを構築
+ChainPattern build_pattern(const std::string& name, double weight, const std::vector<TemplateCell>& cells) {
+    ChainPattern pattern;
+    pattern.name = name;
+    pattern.weight = weight;
+    pattern.total_cells = static_cast<int>(cells.size());
+
+    std::map<char, int> group_of;
+    std::map<std::pair<int, int>, int> cell_group;
+    for (const auto& cell : cells) {
+        auto it = group_of.find(cell.letter);
+        if (it == group_of.end()) {
+            it = group_of.emplace(cell.letter, static_cast<int>(pattern.groups.size())).first;
+            pattern.groups.push_back(PatternGroup{0, 0, 0});
+        }
+        PatternGroup& group = pattern.groups[it->second];
+        set_bit(group.row_mask, Position(cell.x, cell.y).to_bit_index());
+        set_bit(group.column_mask, BitField::bit_index(cell.x, cell.y));
+        group.cells++;
+        cell_group[{cell.x, cell.y}] = it->second;
+    }
+
+    // 隣接する異なる文字は別色（同色だとつながってしまう）
+    std::set<std::pair<uint8_t, uint8_t>> different;
+    for (const auto& entry : cell_group) {
+        int x = entry.first.first;
+        int y = entry.first.second;
+        const std::pair<int, int> neighbors[2] = {{x + 1, y}, {x, y + 1}};
+        for (const auto& neighbor : neighbors) {
+            auto it = cell_group.find(neighbor);
+            if (it != cell_group.end() && it->second != entry.second) {
+                uint8_t a = static_cast<uint8_t>(std::min(entry.second, it->second));
+                uint8_t b = static_cast<uint8_t>(std::max(entry.second, it->second));
+                different.insert({a, b});
+            }
+        }
+    }
+    pattern.different.assign(different.begin(), different.end());
+    return pattern;
+}
+
+// 左右反転・平行移動した変種を展開
+bool expand_source(const PatternSource& source, std::vector<ChainPattern>& out, std::string* error) {
+    int height = static_cast<int>(source.rows.size());
+    int width = 0;
+    for (const auto& row : source.rows) {
+        width = std::max(width, static_cast<int>(row.size()));
+    }
+
+    if (height == 0 || height > MAX_PATTERN_HEIGHT || width > FIELD_WIDTH) {
+        if (error) *error = "pattern '" + source.name + "' has invalid size";
+        return false;
+    }
+
+    std::vector<TemplateCell> cells;
+    for (int i = 0; i < height; ++i) {
+        const std::string& row = source.rows[i];
+        for (int x = 0; x < static_cast<int>(row.size()); ++x) {
+            char c = row[x];
+            if (c == '.') continue;
+            if (c < 'A' || c > 'Z') {
+                if (error) *error = "pattern '" + source.name + "' has invalid cell '" + std::string(1, c) + "'";
+                return false;
+            }
+            cells.push_back(TemplateCell{x, height - 1 - i, c});
+        }
+    }
+    if (cells.empty()) {
+        if (error) *error = "pattern '" + source.name + "' is empty";
+        return false;
+    }
+
+    // 変種（反転有無 × 平行移動量）
+    std::vector<std::pair<bool, int>> variants;
+    if (source.shift) {
+        for (int offset = 0; offset + width <= FIELD_WIDTH; ++offset) {
+            variants.push_back({false, offset});
+            if (source.mirror) variants.push_back({true, offset});
+        }
+    } else {
+        variants.push_back({false, 0});
+        if (source.mirror) variants.push_back({true, FIELD_WIDTH - width});
+    }
+
+    std::set<std::vector<std::tuple<int, int, char>>> seen;
+    for (const auto& variant : variants) {
+        std::vector<TemplateCell> moved;
+        std::vector<std::tuple<int, int, char>> signature;
+        for (const auto& cell : cells) {
+            int x = (variant.first ? width - 1 - cell.x : cell.x) + variant.second;
+            moved.push_back(TemplateCell{x, cell.y, cell.letter});
+            signature.emplace_back(x, cell.y, cell.letter);
+        }
+        std::sort(signature.begin(), signature.end());
+        if (!seen.insert(signature).second) continue;
+
+        std::string name = source.name;
+        if (variant.first) name += "(mirror)";
+        if (source.shift) name += "@" + std::to_string(variant.second);
+        out.push_back(build_pattern(name, source.weight, moved));
+    }
+    return true;
+}
+
+template <typename T>
+void write_pod(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_pod(std::ifstream& file, T& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(file);
+}
+
+void write_mask(std::ofstream& file, BitBoard128 mask) {
+    write_pod(file, static_cast<uint64_t>(mask));
+    write_pod(file, static_cast<uint64_t>(mask >> 64));
+}
+
+bool read_mask(std::ifstream& file, BitBoard128& mask) {
+    uint64_t low, high;
+    if (!read_pod(file, low) || !read_pod(file, high)) return false;
+    mask = (static_cast<BitBoard128>(high) << 64) | low;
+    return true;
+}
+
+} // namespace
+
+// ========== PatternCompiler ==========
+
+bool PatternCompiler::compile_text(const std::string& text, std::vector<ChainPattern>& patterns, std::string* error) {
+    std::vector<ChainPattern> compiled;
+    std::istringstream stream(text);
+    std::string line;
+    int line_number = 0;
+
+    PatternSource source;
+    bool in_pattern = false;
+
+    while (std::getline(stream, line)) {
+        line_number++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line = line.substr(0, comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::istringstream tokens(line);
+        std::string keyword, value;
+        tokens >> keyword;
+        std::getline(tokens, value);
+        value = trim(value);
+
+        if (keyword == "pattern") {
+            if (in_pattern || value.empty()) {
+                if (error) *error = "line " + std::to_string(line_number) + ": unexpected 'pattern'";
+                return false;
+            }
+            source = PatternSource();
+            source.name = value;
+            in_pattern = true;
+        } else if (!in_pattern) {
+            if (error) *error = "line " + std::to_string(line_number) + ": expected 'pattern'";
+            return false;
+        } else if (keyword == "end") {
+            if (!expand_source(source, compiled, error)) return false;
+            in_pattern = false;
+        } else if (keyword == "weight") {
+            try {
+                source.weight = std::stod(value);
+            } catch (...) {
+                if (error) *error = "line " + std::to_string(line_number) + ": invalid weight";
+                return false;
+            }
+        } else if (keyword == "mirror") {
+            source.mirror = parse_bool(value);
+        } else if (keyword == "shift") {
+            source.shift = parse_bool(value);
+        } else {
+            source.rows.push_back(line);
+        }
+    }
+
+    if (in_pattern) {
+        if (error) *error = "pattern '" + source.name + "' is missing 'end'";
+        return false;
+    }
+
+    patterns = std::move(compiled);
+    return true;
+}
+
+bool PatternCompiler::write_binary(const std::string& path, const std::vector<ChainPattern>& patterns) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    file.write(PATTERN_MAGIC, sizeof(PATTERN_MAGIC));
+    write_pod(file, FORMAT_VERSION);
+    write_pod(file, static_cast<uint32_t>(patterns.size()));
+
+    for (const auto& pattern : patterns) {
+        write_pod(file, static_cast<uint16_t>(pattern.name.size()));
+        file.write(pattern.name.data(), pattern.name.size());
+        write_pod(file, pattern.weight);
+        write_pod(file, static_cast<uint16_t>(pattern.total_cells));
+
+        write_pod(file, static_cast<uint16_t>(pattern.groups.size()));
+        for (const auto& group : pattern.groups) {
+            write_mask(file, group.row_mask);
+            write_mask(file, group.column_mask);
+            write_pod(file, static_cast<uint16_t>(group.cells));
+        }
+
+        write_pod(file, static_cast<uint16_t>(pattern.different.size()));
+        for (const auto& pair : pattern.different) {
+            write_pod(file, pair.first);
+            write_pod(file, pair.second);
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+bool PatternCompiler::read_binary(const std::string& path, std::vector<ChainPattern>& patterns) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    char magic[sizeof(PATTERN_MAGIC)];
+    uint32_t version, count;
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, PATTERN_MAGIC, sizeof(magic)) != 0) return false;
+    if (!read_pod(file, version) || version != FORMAT_VERSION || !read_pod(file, count)) return false;
+
+    std::vector<ChainPattern> loaded(count);
+    for (auto& pattern : loaded) {
+        uint16_t name_length, total_cells, group_count, different_count;
+        if (!read_pod(file, name_length)) return false;
+        pattern.name.resize(name_length);
+        file.read(&pattern.name[0], name_length);
+        if (!read_pod(file, pattern.weight) || !read_pod(file, total_cells)) return false;
+        pattern.total_cells = total_cells;
+
+        if (!read_pod(file, group_count)) return false;
+        pattern.groups.resize(group_count);
+        for (auto& group : pattern.groups) {
+            uint16_t cells;
+            if (!read_mask(file, group.row_mask) || !read_mask(file, group.column_mask) ||
+                !read_pod(file, cells)) {
+                return false;
+            }
+            group.cells = cells;
+        }
+
+        if (!read_pod(file, different_count)) return false;
+        pattern.different.resize(different_count);
+        for (auto& pair : pattern.different) {
+            if (!read_pod(file, pair.first) || !read_pod(file, pair.second)) return false;
+            if (pair.first >= group_count || pair.second >= group_count) return false;
+        }
+    }
+
+    patterns = std::move(loaded);
+    return true;
+}
+
+bool PatternCompiler::load_file(const std::string& path, std::vector<ChainPattern>& patterns, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (content.size() >= sizeof(PATTERN_MAGIC) &&
+        std::memcmp(content.data(), PATTERN_MAGIC, sizeof(PATTERN_MAGIC)) == 0) {
+        if (!read_binary(path, patterns)) {
+            if (error) *error = "invalid compiled pattern file " + path;
+            return false;
+        }
+        return true;
+    }
+    return compile_text(content, patterns, error);
+}
+
+// ========== PatternMatcher ==========
+
+bool PatternMatcher::load(const std::string& path) {
+    std::vector<ChainPattern> patterns;
+    if (!PatternCompiler::load_file(path, patterns)) {
+        return false;
+    }
+
+    std::error_code ec;
+    auto modified = std::filesystem::last_write_time(path, ec);
+    path_ = path;
+    loaded_time_ = ec ? std::filesystem::file_time_type{} : modified;
+    set_patterns(std::move(patterns));
+    return true;
+}
+
+bool PatternMatcher::reload_if_changed() {
+    if (path_.empty()) return false;
+
+    std::error_code ec;
+    auto modified = std::filesystem::last_write_time(path_, ec);
+    if (ec || modified == loaded_time_) return false;
+
+    // 読み込みに失敗した場合は現在のライブラリを使い続ける
+    return load(path_);
+}
+
+void PatternMatcher::set_patterns(std::vector<ChainPattern> patterns) {
+    std::atomic_store(&patterns_, std::shared_ptr<const PatternSet>(
+        std::make_shared<PatternSet>(std::move(patterns))));
+}
+
+std::shared_ptr<const PatternMatcher::PatternSet> PatternMatcher::snapshot() const {
+    return std::atomic_load(&patterns_);
+}
+
+size_t PatternMatcher::size() const {
+    auto patterns = snapshot();
+    return patterns ? patterns->size() : 0;
+}
+
+std::string PatternMatcher::pattern_name(int index) const {
+    auto patterns = snapshot();
+    if (!patterns || index < 0 || index >= static_cast<int>(patterns->size())) return "";
+    return (*patterns)[index].name;
+}
+
+PatternMatch PatternMatcher::match(const FieldBitBoards& field) const {
+    auto patterns = snapshot();
+    if (!patterns) return PatternMatch();
+
+    return match_bits(*patterns, field.color_bits.data(),
+                      field.get_color_bits(PuyoColor::GARBAGE), &PatternGroup::row_mask);
+}
+
+PatternMatch PatternMatcher::match(const BitField& field) const {
+    auto patterns = snapshot();
+    if (!patterns) return PatternMatch();
+
+    std::array<BitBoard128, PLAYABLE_COLORS> colors;
+    for (int c = 0; c < PLAYABLE_COLORS; ++c) {
+        colors[c] = field.get_color_bits(static_cast<PuyoColor>(c + 1));
+    }
+    return match_bits(*patterns, colors.data(),
+                      field.get_color_bits(PuyoColor::GARBAGE), &PatternGroup::column_mask);
+}
+
+PatternMatch PatternMatcher::match_bits(const PatternSet& patterns, const BitBoard128* colors,
+                                        BitBoard128 garbage, BitBoard128 PatternGroup::*mask) {
+    PatternMatch best;
+    std::vector<uint8_t> group_colors;
+
+    for (size_t p = 0; p < patterns.size(); ++p) {
+        const ChainPattern& pattern = patterns[p];
+        group_colors.assign(pattern.groups.size(), 0);
+
+        // 各グループに置かれている色を調べる（2色以上混在・おじゃまは不一致）
+        int matched = 0;
+        bool consistent = true;
+        for (size_t g = 0; g < pattern.groups.size() && consistent; ++g) {
+            BitBoard128 group_mask = pattern.groups[g].*mask;
+            if (group_mask & garbage) {
+                consistent = false;
+                break;
+            }
+
+            uint8_t present = 0;
+            for (int c = 0; c < PLAYABLE_COLORS; ++c) {
+                BitBoard128 hit = group_mask & colors[c];
+                if (hit) {
+                    present |= static_cast<uint8_t>(1u << c);
+                    matched += popcount128(hit);
+                }
+            }
+            consistent = (present & (present - 1)) == 0;
+            group_colors[g] = present;
+        }
+        if (!consistent || matched == 0) continue;
+
+        // 隣接グループが同色になっていないか
+        for (const auto& pair : pattern.different) {
+            if (group_colors[pair.first] != 0 && group_colors[pair.first] == group_colors[pair.second]) {
+                consistent = false;
+                break;
+            }
+        }
+        if (!consistent) continue;
+
+        double coverage = static_cast<double>(matched) / pattern.total_cells;
+        double score = pattern.weight * coverage * coverage;
+        if (score > best.score) {
+            best.score = score;
+            best.coverage = coverage;
+            best.pattern = static_cast<int>(p);
+        }
+    }
+    return best;
+}
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "core/puyo_types.h"
+#include "core/bit_field.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <filesystem>
+
+namespace puyo {
+namespace ai {
+
+// 連鎖形パターンの同色グループ（テンプレート上の同じ文字）
+struct PatternGroup {
+    BitBoard128 row_mask;     // FieldBitBoards配置（bit = y * 6 + x）
+    BitBoard128 column_mask;  // BitField配置（bit = x * 16 + y）
+    int cells;
+};
+
+// コンパイル済み連鎖形パターン
+struct ChainPattern {
+    std::string name;
+    double weight;
+    int total_cells;
+    std::vector<PatternGroup> groups;
+    std::vector<std::pair<uint8_t, uint8_t>> different;  // 別色でなければならないグループ対（隣接する異なる文字）
+};
+
+// パターン照合結果
+struct PatternMatch {
+    double score;      // weight × 充足率^2
+    double coverage;   // 置かれているセル / パターンのセル数
+    int pattern;       // 最良パターンのインデックス（一致なしは-1）
+
+    PatternMatch() : score(0.0), coverage(0.0), pattern(-1) {}
+};
+
+// パターンライブラリのコンパイラ
+//
+// テキスト形式:
+//   pattern <名前>        パターン開始
+//   weight <数値>         評価の重み
+//   mirror true|false     左右反転版も生成
+//   shift true|false      左右にずらした版も生成
+//   <行>...               テンプレート（上の行から、最終行が1段目、左端が1列目）
+//                         大文字 = 同色グループ、'.' = 不問
+//   end                   パターン終了
+// '#' 以降はコメント
+class PatternCompiler {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    // テキストをコンパイル（エラー時はfalseとメッセージ）
+    static bool compile_text(const std::string& text, std::vector<ChainPattern>& patterns, std::string* error = nullptr);
+
+    // バイナリ形式の読み書き（マスク表をそのまま保存）
+    static bool write_binary(const std::string& path, const std::vector<ChainPattern>& patterns);
+    static bool read_binary(const std::string& path, std::vector<ChainPattern>& patterns);
+
+    // テキスト・バイナリを自動判別して読み込み
+    static bool load_file(const std::string& path, std::vector<ChainPattern>& patterns, std::string* error = nullptr);
+};
+
+// 連鎖形パターンマッチャー
+// 全パターンをビット演算で部分一致評価する。ライブラリは実行中に差し替え可能（探索スレッドから参照中でも安全）。
+class PatternMatcher {
+public:
+    PatternMatcher() = default;
+
+    // ライブラリの読み込み（テキストまたはコンパイル済みバイナリ）
+    bool load(const std::string& path);
+
+    // ファイルが更新されていれば読み直す（読み直した場合true）
+    bool reload_if_changed();
+
+    // ライブラリの直接設定
+    void set_patterns(std::vector<ChainPattern> patterns);
+
+    size_t size() const;
+    std::string pattern_name(int index) const;
+
+    // 最も良く一致したパターンを返す
+    PatternMatch match(const FieldBitBoards& field) const;
+    PatternMatch match(const BitField& field) const;
+
+    // 評価値のみ
+    double score(const FieldBitBoards& field) const { return match(field).score; }
+    double score(const BitField& field) const { return match(field).score; }
+
+private:
+    using PatternSet = std::vector<ChainPattern>;
+
+    std::shared_ptr<const PatternSet> patterns_;
+    std::string path_;
+    std::filesystem::file_time_type loaded_time_{};
+
+    std::shared_ptr<const PatternSet> snapshot() const;
+
+    // 色ごとのビットマップから照合（masksはグループのマスクを選ぶメンバーポインタ）
+    static PatternMatch match_bits(const PatternSet& patterns, const BitBoard128* colors,
+                                   BitBoard128 garbage, BitBoard128 PatternGroup::*mask);
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,245 @@
+#pragma once
+
+#include "ai_base.h"
+#include "core/bit_field.h"
+#include "core/garbage_system.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// 先読み（ポンダー）
+// 相手の手番中に、自分の次の手番で起こりうる局面（予告おじゃまの増減）を
+// バックグラウンドスレッドで思考しておき、手番開始時に一致する結果を渡す。
+// 思考はAI本体で行う。AIがターン間で保持する探索情報（MCTSの探索木など）は先読み開始時に退避し、
+// 予想局面ごとに退避した情報から思考する。一致した場合はその局面を思考した後の探索情報を、
+// 一致しなかった場合は退避した情報をAIに戻すので、手番の思考は先読みしなかった場合と同じ情報から始まる。
+// ポンダー中はAIのthink()を直接呼ばず、必ずtake()またはcancel()で先読みを止めてから使うこと。
+//
+// GameManagerはAIを直接呼ばない（入力はInputCallback経由）ため、AIを駆動する側が
+// 手番終了の通知（GameManager::set_turn_end_callback）でstart()、次の手番の入力の前にtake()を呼ぶ。
+// Python UIではAIPlayerController(ponder=True)が同じ順で呼ぶ。
+class Ponderer {
+public:
+    struct Stats {
+        int started;      // 先読み開始回数
+        int searched;     // 思考済みの予想局面数
+        int hits;         // 手番開始時に結果を使えた回数
+        int misses;       // 一致する予想局面がなかった回数
+        int cancelled;    // 思考前に中止した予想局面数
+
+        Stats() : started(0), searched(0), hits(0), misses(0), cancelled(0) {}
+    };
+
+    explicit Ponderer(AIBase& ai) : ai_(ai), stop_(false), running_(false), current_(-1) {}
+    ~Ponderer() { cancel(); }
+
+    Ponderer(const Ponderer&) = delete;
+    Ponderer& operator=(const Ponderer&) = delete;
+
+    // 予告おじゃまの予想値（そのまま、相手が今撃てる最大連鎖を撃った場合）
+    static std::vector<int> predict_pending_outcomes(const GameState& upcoming) {
+        std::vector<int> outcomes = {upcoming.garbage.pending};
+
+        if (upcoming.opponent_field) {
+            ChainPotential potential = BitField::from_field(*upcoming.opponent_field).chain_potential(2);
+            int incoming = potential.score / GarbageSystem::GARBAGE_RATE;
+            if (incoming > 0) {
+                outcomes.push_back(upcoming.garbage.pending + incoming);
+            }
+        }
+        return outcomes;
+    }
+
+    // 先読み開始
+    // upcomingには自分の次の手番の既知情報（盤面・次に操作するツモ・NEXT・予告おじゃま・相手盤面）を渡す
+    void start(const GameState& upcoming) {
+        cancel();
+        if (!upcoming.own_field) return;
+
+        // GameStateは盤面をポインタで参照するため、予想局面ごとに盤面を複製して保持する
+        for (int pending : predict_pending_outcomes(upcoming)) {
+            entries_.emplace_back();
+            Entry& entry = entries_.back();
+            entry.own_field = *upcoming.own_field;
+            entry.has_opponent = upcoming.opponent_field != nullptr;
+            if (entry.has_opponent) {
+                entry.opponent_field = *upcoming.opponent_field;
+            }
+            entry.state = upcoming;
+            entry.state.own_field = &entry.own_field;
+            entry.state.opponent_field = entry.has_opponent ? &entry.opponent_field : nullptr;
+            entry.state.garbage.pending = pending;
+            entry.key = make_key(entry.state);
+        }
+
+        saved_state_ = ai_.take_search_state();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.started++;
+            stop_ = false;
+            current_ = -1;
+        }
+        token_ = CancellationToken();
+        running_ = true;
+        worker_ = std::thread([this]() { run(); });
+    }
+
+    // 先読みを中止（思考中の局面には中止要求を出し、終わるまで待つ）
+    void cancel() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        token_.cancel();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+        finish(nullptr);
+    }
+
+    // 手番開始：先読みを止め、実際の局面に一致する結果があればdecisionに設定してtrue
+    // 一致する局面を思考中なら終わるのを待つ（まだ思考を始めていなければ使わずにfalse）
+    bool take(const GameState& actual, AIDecision& decision) {
+        int match = -1;
+        if (actual.own_field) {
+            uint64_t key = make_key(actual);
+            for (size_t i = 0; i < entries_.size(); ++i) {
+                if (entries_[i].key == key) {
+                    match = static_cast<int>(i);
+                    break;
+                }
+            }
+        }
+
+        // 以降の予想局面は思考しない。一致する局面を思考中ならそのまま終わるのを待ち、それ以外は中止する
+        // （思考する局面の選択と同じロックの下で判定するので、一致する局面の思考を途中で止めることはない）
+        bool wait_for_match;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            wait_for_match = match >= 0 && current_ == match;
+        }
+        if (!wait_for_match) {
+            token_.cancel();
+        }
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+
+        Entry* hit = match >= 0 && entries_[match].done ? &entries_[match] : nullptr;
+        if (hit) {
+            decision = hit->decision;
+            decision.reason = "Ponder: " + decision.reason;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (hit) {
+                stats_.hits++;
+            } else {
+                stats_.misses++;
+            }
+        }
+        finish(hit);
+        return hit != nullptr;
+    }
+
+    bool is_pondering() const { return running_; }
+
+    Stats get_stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    struct Entry {
+        Field own_field;
+        Field opponent_field;
+        bool has_opponent;
+        GameState state;
+        uint64_t key;
+        bool done;
+        AIDecision decision;
+        std::unique_ptr<AIBase::SearchState> search_state;   // この局面を思考した後のAIの探索情報
+
+        Entry() : has_opponent(false), key(0), done(false) {}
+    };
+
+    AIBase& ai_;
+    std::deque<Entry> entries_;   // 要素のアドレスが変わらないようdequeで保持
+    std::unique_ptr<AIBase::SearchState> saved_state_;   // 先読み開始時に退避したAIの探索情報
+    std::thread worker_;
+    mutable std::mutex mutex_;    // stop_・current_・done・statsを保護
+    bool stop_;
+    std::atomic<bool> running_;
+    int current_;                 // 思考中の予想局面（-1なら無し）
+    CancellationToken token_;
+    Stats stats_;
+
+    // 一致判定キー（自分の盤面・ツモ・NEXT2組・予告おじゃま）
+    // 相手盤面は含めない（相手の手で変わるため、一致判定には使わない）
+    static uint64_t make_key(const GameState& state) {
+        uint64_t key = BitField::from_field(*state.own_field).hash();
+        auto mix = [&key](uint64_t value) {
+            key ^= value + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+        };
+
+        mix((static_cast<uint64_t>(state.current_pair.axis) << 8) |
+            static_cast<uint64_t>(state.current_pair.child));
+        for (size_t i = 0; i < state.next_queue.size() && i < 2; ++i) {
+            mix((static_cast<uint64_t>(state.next_queue[i].axis) << 8) |
+                static_cast<uint64_t>(state.next_queue[i].child) | ((i + 1) << 16));
+        }
+        mix(static_cast<uint64_t>(state.garbage.pending) << 24);
+        return key;
+    }
+
+    void run() {
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stop_) break;
+                current_ = static_cast<int>(i);
+            }
+
+            // 予想局面ごとに、退避した探索情報から思考する
+            Entry& entry = entries_[i];
+            ai_.restore_search_state(saved_state_ ? saved_state_->clone() : nullptr);
+            AIDecision decision = ai_.think_until(entry.state, Deadline::none(), token_);
+            std::unique_ptr<AIBase::SearchState> after = ai_.take_search_state();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            current_ = -1;
+            if (token_.is_cancelled()) break;  // 打ち切られた思考の結果は使わない
+            entry.decision = decision;
+            entry.search_state = std::move(after);
+            entry.done = true;
+            stats_.searched++;
+        }
+        running_ = false;
+    }
+
+    // 先読みの後始末：AIの探索情報を戻し（一致した局面があればその思考後の情報）、予想局面を破棄する
+    void finish(Entry* hit) {
+        running_ = false;
+        if (entries_.empty()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& entry : entries_) {
+                if (!entry.done) stats_.cancelled++;
+            }
+        }
+        ai_.restore_search_state(hit ? std::move(hit->search_state) : std::move(saved_state_));
+        saved_state_.reset();
+        entries_.clear();
+    }
+};
+
+} // namespace ai
+} // namespace puyo
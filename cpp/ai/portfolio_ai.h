@@ -0,0 +1,379 @@
+#pragma once
+
+#include "ai_base.h"
+#include "ai_utils.h"
+#include "thread_pool.h"
+#include "core/bit_field.h"
+#include <chrono>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace puyo {
+namespace ai {
+
+// ポートフォリオAI
+// 設定した複数の子AIを同じ局面でスレッドプール上に並列に思考させ、
+// 共通の締め切りまでに出そろった判断を方策（多数決・確信度最大・審判評価）で統合する。
+class PortfolioAI : public AIBase {
+public:
+    // 子AIの生成関数（AI名とパラメータから生成、通常はAIManager::create_ai）
+    using Factory = std::function<std::unique_ptr<AIBase>(const std::string&, const AIParameters&)>;
+
+    // 統合方策
+    enum class Policy {
+        VOTE,              // 重み付き多数決
+        MAX_CONFIDENCE,    // 確信度が最大の子AIに従う
+        ARBITER            // 提案手を共通の評価関数で比較
+    };
+
+    PortfolioAI(const AIParameters& params, const Factory& factory)
+        : AIBase("PortfolioAI"), think_time_limit_(300), policy_(Policy::VOTE), num_threads_(0) {
+
+        // パラメータの設定
+        for (const auto& param : params) {
+            set_parameter(param.first, param.second);
+        }
+
+        // YAML設定ファイルから設定を読み込み、子AIを生成
+        load_configuration(factory);
+    }
+
+    // YAML設定読み込み（AIParametersで同名キーを上書き可能）
+    void load_configuration(const Factory& factory) {
+        auto config = ConfigLoader::load_config("config/ai_params/portfolio.yaml");
+        for (const auto& param : get_all_parameters()) {
+            config[param.first] = param.second;
+        }
+
+        think_time_limit_ = ConfigLoader::get_int(config, "think_time_limit", 300);
+        policy_ = parse_policy(ConfigLoader::get_string(config, "policy", "vote"));
+        num_threads_ = ConfigLoader::get_int(config, "num_threads", 0);
+
+        arbiter_.score_weight = ConfigLoader::get_double(config, "arbiter.score_weight", 1.0);
+        arbiter_.potential_weight = ConfigLoader::get_double(config, "arbiter.potential_weight", 0.5);
+        arbiter_.height_weight = ConfigLoader::get_double(config, "arbiter.height_weight", -20.0);
+
+        // 子AI：members に並べた名前ごとのセクション（type / weight / params）
+        members_.clear();
+        skipped_.clear();
+        std::string member_list = ConfigLoader::get_string(config, "members", "chain_search");
+        for (const auto& name : split(member_list, ',')) {
+            std::string type = ConfigLoader::get_string(config, name + ".type", name);
+            if (type == "portfolio" || !factory) {
+                skipped_.push_back(name);
+                continue;
+            }
+
+            std::unique_ptr<AIBase> ai = factory(type, parse_params(ConfigLoader::get_string(config, name + ".params", "")));
+            if (!ai) {
+                skipped_.push_back(name);
+                continue;
+            }
+
+            Member member;
+            member.name = name;
+            member.type = type;
+            member.weight = ConfigLoader::get_double(config, name + ".weight", 1.0);
+            member.ai = std::move(ai);
+            members_.push_back(std::move(member));
+        }
+    }
+
+    bool initialize() override {
+        for (auto& member : members_) {
+            member.ai->initialize();
+        }
+
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        int thread_count = num_threads_ > 0 ? num_threads_
+                                            : std::min<int>(members_.size(), std::max(1, hardware));
+        pool_ = std::make_unique<ThreadPool>(std::max(1, thread_count));
+        return AIBase::initialize();
+    }
+
+    void shutdown() override {
+        for (auto& member : members_) {
+            member.ai->shutdown();
+        }
+        pool_.reset();
+        AIBase::shutdown();
+    }
+
+    AIDecision think(const GameState& state) override {
+        auto start_time = std::chrono::steady_clock::now();
+
+        if (!initialized_ || !pool_) {
+            return AIDecision(-1, 0, {}, 0.0, "AI not initialized");
+        }
+        if (!state.own_field) {
+            return AIDecision(-1, 0, {}, 0.0, "Field not available");
+        }
+        if (members_.empty()) {
+            return AIDecision(-1, 0, {}, 0.0, "No member AIs");
+        }
+
+        // 全子AIで共通の締め切り、外部からの中止要求はそのまま子AIへ伝える
+        Deadline deadline = Deadline::after_ms(think_budget_ms(think_time_limit_));
+        CancellationToken token = control_.token;
+
+        std::vector<std::future<AIDecision>> futures;
+        for (auto& member : members_) {
+            Member* target = &member;
+            futures.push_back(pool_->submit([target, &state, deadline, token]() {
+                auto member_start = std::chrono::steady_clock::now();
+                AIDecision decision = target->ai->think_until(state, deadline, token);
+                target->last_time_ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - member_start).count();
+                return decision;
+            }));
+        }
+
+        // 子AIの結果を回収（設置できない手・例外は無効票）
+        std::vector<int> valid;
+        for (size_t i = 0; i < members_.size(); ++i) {
+            Member& member = members_[i];
+            try {
+                member.last_decision = futures[i].get();
+            } catch (const std::exception& e) {
+                member.last_decision = AIDecision(-1, 0, {}, 0.0, std::string("error: ") + e.what());
+            }
+            if (state.own_field->can_place(member.last_decision.x, member.last_decision.r)) {
+                valid.push_back(static_cast<int>(i));
+            }
+        }
+
+        if (valid.empty()) {
+            return AIDecision(-1, 0, {}, 0.0, "Portfolio: no valid member decision");
+        }
+
+        Selection selection;
+        switch (policy_) {
+            case Policy::MAX_CONFIDENCE: selection = select_max_confidence(valid); break;
+            case Policy::ARBITER:        selection = select_arbiter(valid, state); break;
+            case Policy::VOTE:
+            default:                     selection = select_vote(valid); break;
+        }
+
+        const Member& chosen = members_[selection.member];
+        int x = chosen.last_decision.x;
+        int r = chosen.last_decision.r;
+        auto move_commands = MoveCommandGenerator::generate_move_commands(*state.own_field, x, r);
+
+        int agree = 0;
+        for (int index : valid) {
+            if (members_[index].last_decision.x == x && members_[index].last_decision.r == r) agree++;
+        }
+
+        double elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_time).count();
+        std::string reason = "Portfolio[policy=" + policy_name(policy_) +
+                             ", agree=" + std::to_string(agree) + "/" + std::to_string(valid.size()) +
+                             ", time=" + std::to_string(static_cast<int>(elapsed_ms)) + "ms]: " +
+                             chosen.name + " -> " + chosen.last_decision.reason;
+
+        return AIDecision(x, r, move_commands, selection.confidence, reason);
+    }
+
+    std::string get_type() const override {
+        return "Portfolio";
+    }
+
+    std::string get_debug_info() const override {
+        std::ostringstream oss;
+        oss << "PortfolioAI[policy=" << policy_name(policy_)
+            << ", threads=" << (pool_ ? pool_->size() : 0) << "]";
+        for (const auto& member : members_) {
+            oss << " " << member.name << "=(" << member.last_decision.x << "," << member.last_decision.r
+                << ", " << static_cast<int>(member.last_time_ms) << "ms)";
+        }
+        for (const auto& name : skipped_) {
+            oss << " " << name << "=skipped";
+        }
+        return oss.str();
+    }
+
+    int get_think_time_ms() const override {
+        return think_time_limit_;
+    }
+
+    void clear_search_cache() override {
+        for (auto& member : members_) {
+            member.ai->clear_search_cache();
+        }
+    }
+
+    // 子AIの数
+    size_t member_count() const { return members_.size(); }
+
+private:
+    struct Member {
+        std::string name;
+        std::string type;
+        double weight;
+        std::unique_ptr<AIBase> ai;
+        AIDecision last_decision;
+        double last_time_ms;
+
+        Member() : weight(1.0), last_time_ms(0.0) {}
+    };
+
+    // 審判評価の重み
+    struct ArbiterWeights {
+        double score_weight;       // 即時連鎖の得点
+        double potential_weight;   // 設置後の連鎖ポテンシャルの得点
+        double height_weight;      // 最も高い列の段数
+
+        ArbiterWeights() : score_weight(1.0), potential_weight(0.5), height_weight(-20.0) {}
+    } arbiter_;
+
+    struct Selection {
+        int member;
+        double confidence;
+
+        Selection() : member(-1), confidence(0.0) {}
+    };
+
+    int think_time_limit_;
+    Policy policy_;
+    int num_threads_;
+    std::vector<Member> members_;
+    std::vector<std::string> skipped_;
+    std::unique_ptr<ThreadPool> pool_;
+
+    // 重み付き多数決（同票は確信度の合計、さらに同じなら設定順）
+    Selection select_vote(const std::vector<int>& valid) const {
+        std::map<int, std::pair<double, double>> tally;  // 配置番号 → (重み合計, 確信度合計)
+        double total_weight = 0.0;
+        for (int index : valid) {
+            const Member& member = members_[index];
+            auto& entry = tally[placement_index(member.last_decision.x, member.last_decision.r)];
+            entry.first += member.weight;
+            entry.second += member.last_decision.confidence;
+            total_weight += member.weight;
+        }
+
+        Selection selection;
+        std::pair<double, double> best(-std::numeric_limits<double>::max(), 0.0);
+        for (int index : valid) {
+            const Member& member = members_[index];
+            const auto& entry = tally[placement_index(member.last_decision.x, member.last_decision.r)];
+            if (entry > best) {
+                best = entry;
+                selection.member = index;
+            }
+        }
+        selection.confidence = total_weight > 0.0 ? best.first / total_weight : 0.0;
+        return selection;
+    }
+
+    // 確信度最大（同値は重みの大きい子AI）
+    Selection select_max_confidence(const std::vector<int>& valid) const {
+        Selection selection;
+        double best_weight = 0.0;
+        for (int index : valid) {
+            const Member& member = members_[index];
+            double confidence = member.last_decision.confidence;
+            if (selection.member < 0 || confidence > selection.confidence ||
+                (confidence == selection.confidence && member.weight > best_weight)) {
+                selection.member = index;
+                selection.confidence = confidence;
+                best_weight = member.weight;
+            }
+        }
+        return selection;
+    }
+
+    // 審判評価：提案手を同じ評価関数で採点（窒息する手は除外）
+    Selection select_arbiter(const std::vector<int>& valid, const GameState& state) const {
+        BitField root = BitField::from_field(*state.own_field);
+        std::map<int, double> scores;  // 配置番号 → 評価値（同じ手は1回だけ評価）
+
+        Selection selection;
+        double best_score = -std::numeric_limits<double>::max();
+        for (int index : valid) {
+            const Member& member = members_[index];
+            int placement = placement_index(member.last_decision.x, member.last_decision.r);
+            auto it = scores.find(placement);
+            if (it == scores.end()) {
+                it = scores.emplace(placement, arbiter_score(root, member.last_decision.x,
+                                                             member.last_decision.r, state.current_pair)).first;
+            }
+            if (selection.member < 0 || it->second > best_score) {
+                best_score = it->second;
+                selection.member = index;
+            }
+        }
+        selection.confidence = members_[selection.member].last_decision.confidence;
+        return selection;
+    }
+
+    double arbiter_score(const BitField& root, int x, int r, const PuyoPair& pair) const {
+        BitField field = root;
+        BitChainResult result = field.place_and_simulate(x, r, pair.axis, pair.child);
+        if (result.chain_count < 0 || field.is_game_over()) {
+            return -std::numeric_limits<double>::max() / 2;
+        }
+
+        int max_height = 0;
+        for (int column = 0; column < FIELD_WIDTH; ++column) {
+            max_height = std::max(max_height, field.height(column));
+        }
+
+        ChainPotential potential = field.chain_potential(2);
+        return arbiter_.score_weight * (result.chain_count > 0 ? result.score : 0) +
+               arbiter_.potential_weight * potential.score +
+               arbiter_.height_weight * max_height;
+    }
+
+    static Policy parse_policy(const std::string& name) {
+        if (name == "max_confidence") return Policy::MAX_CONFIDENCE;
+        if (name == "arbiter") return Policy::ARBITER;
+        return Policy::VOTE;
+    }
+
+    static std::string policy_name(Policy policy) {
+        switch (policy) {
+            case Policy::MAX_CONFIDENCE: return "max_confidence";
+            case Policy::ARBITER:        return "arbiter";
+            case Policy::VOTE:
+            default:                     return "vote";
+        }
+    }
+
+    // "key=value; key=value" 形式の子AIパラメータ
+    static AIParameters parse_params(const std::string& text) {
+        AIParameters params;
+        for (const auto& item : split(text, ';')) {
+            size_t equal_pos = item.find('=');
+            if (equal_pos == std::string::npos) continue;
+            params[trim(item.substr(0, equal_pos))] = trim(item.substr(equal_pos + 1));
+        }
+        return params;
+    }
+
+    static std::string trim(const std::string& text) {
+        size_t begin = text.find_first_not_of(" \t");
+        if (begin == std::string::npos) return "";
+        size_t end = text.find_last_not_of(" \t");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    static std::vector<std::string> split(const std::string& text, char delimiter) {
+        std::vector<std::string> items;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, delimiter)) {
+            item = trim(item);
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,216 @@
+#include "q_cold_store.h"
+#include "q_table_file.h"
+#include <filesystem>
+
+namespace puyo {
+namespace ai {
+
+namespace {
+
+constexpr char COLD_MAGIC[8] = {'P', 'U', 'Y', 'O', 'Q', 'C', 'L', 'D'};
+
+struct ColdHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t key_schema;
+    uint32_t row_size;
+};
+static_assert(sizeof(ColdHeader) == 24, "ColdHeader must be 24 bytes");
+
+void set_error(std::string* error, const std::string& message) {
+    if (error) *error = message;
+}
+
+} // namespace
+
+QColdStore::QColdStore()
+    : half_precision_(false), end_offset_(0), record_count_(0), index_size_(0) {}
+
+size_t QColdStore::record_size() const {
+    size_t value_size = half_precision_ ? sizeof(uint16_t) : sizeof(double);
+    return sizeof(uint64_t) + PLACEMENT_COUNT * (value_size + sizeof(int32_t));
+}
+
+bool QColdStore::open(const std::string& path, bool half_precision, std::string* error) {
+    close();
+
+    std::error_code ec;
+    uint64_t file_size = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+    if (ec) file_size = 0;
+
+    ColdHeader header{};
+    if (file_size == 0) {
+        // 新規作成
+        std::memcpy(header.magic, COLD_MAGIC, sizeof(COLD_MAGIC));
+        header.version = FORMAT_VERSION;
+        header.flags = half_precision ? FLAG_HALF : 0;
+        header.key_schema = QTableFile::KEY_SCHEMA;
+        header.row_size = PLACEMENT_COUNT;
+        std::ofstream created(path, std::ios::binary | std::ios::trunc);
+        created.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!created) {
+            set_error(error, "failed to create " + path);
+            return false;
+        }
+        file_size = sizeof(header);
+    }
+
+    file_.open(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file_.is_open()) {
+        set_error(error, "failed to open " + path);
+        return false;
+    }
+    if (file_size < sizeof(header) || !file_.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, COLD_MAGIC, sizeof(COLD_MAGIC)) != 0) {
+        file_.close();
+        set_error(error, "not a Q-table cold tier file");
+        return false;
+    }
+    if (header.version != FORMAT_VERSION || header.key_schema != QTableFile::KEY_SCHEMA ||
+        header.row_size != static_cast<uint32_t>(PLACEMENT_COUNT)) {
+        file_.close();
+        set_error(error, "unsupported Q-table cold tier format");
+        return false;
+    }
+    path_ = path;
+    half_precision_ = (header.flags & FLAG_HALF) != 0;
+
+    // 索引の再構築（同じキーは後のレコードが有効）
+    index_.assign(1024, IndexEntry{QTable::EMPTY_KEY, 0});
+    size_t size = record_size();
+    uint64_t records = (file_size - sizeof(header)) / size;
+    uint64_t offset = sizeof(header);
+    for (uint64_t i = 0; i < records; ++i, offset += size) {
+        uint64_t key = 0;
+        file_.seekg(static_cast<std::streamoff>(offset));
+        if (!file_.read(reinterpret_cast<char*>(&key), sizeof(key))) break;
+        insert_index(key, offset);
+        record_count_++;
+    }
+    file_.clear();
+    end_offset_ = offset;
+
+    // 書きかけで終わったレコードは切り捨てる
+    if (end_offset_ != file_size) {
+        file_.close();
+        std::filesystem::resize_file(path, end_offset_, ec);
+        file_.open(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (ec || !file_.is_open()) {
+            close();
+            set_error(error, "failed to truncate " + path);
+            return false;
+        }
+    }
+    return true;
+}
+
+void QColdStore::close() {
+    if (file_.is_open()) file_.close();
+    file_.clear();
+    path_.clear();
+    end_offset_ = 0;
+    record_count_ = 0;
+    index_.clear();
+    index_size_ = 0;
+}
+
+bool QColdStore::append(uint64_t key, const QRow& row) {
+    if (!file_.is_open() || key == QTable::EMPTY_KEY) return false;
+
+    encode(key, row);
+    file_.seekp(static_cast<std::streamoff>(end_offset_));
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    if (!file_) {
+        file_.clear();
+        return false;
+    }
+    insert_index(key, end_offset_);
+    end_offset_ += buffer_.size();
+    record_count_++;
+    return true;
+}
+
+bool QColdStore::read(uint64_t key, QRow& row) {
+    const IndexEntry* entry = find_index(key);
+    if (!entry) return false;
+
+    buffer_.resize(record_size());
+    file_.seekg(static_cast<std::streamoff>(entry->offset));
+    if (!file_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()))) {
+        file_.clear();
+        return false;
+    }
+    decode(row);
+    return true;
+}
+
+const QColdStore::IndexEntry* QColdStore::find_index(uint64_t key) const {
+    if (index_.empty() || key == QTable::EMPTY_KEY) return nullptr;
+    size_t mask = index_.size() - 1;
+    size_t i = static_cast<size_t>(QTable::mix64(key)) & mask;
+    while (index_[i].key != QTable::EMPTY_KEY) {
+        if (index_[i].key == key) return &index_[i];
+        i = (i + 1) & mask;
+    }
+    return nullptr;
+}
+
+void QColdStore::insert_index(uint64_t key, uint64_t offset) {
+    if (key == QTable::EMPTY_KEY) return;
+    if (static_cast<double>(index_size_ + 1) > QTable::MAX_LOAD_FACTOR * index_.size()) {
+        std::vector<IndexEntry> old_index(index_.size() * 2, IndexEntry{QTable::EMPTY_KEY, 0});
+        old_index.swap(index_);
+        index_size_ = 0;
+        for (const auto& entry : old_index) {
+            if (entry.key != QTable::EMPTY_KEY) insert_index(entry.key, entry.offset);
+        }
+    }
+    size_t mask = index_.size() - 1;
+    size_t i = static_cast<size_t>(QTable::mix64(key)) & mask;
+    while (index_[i].key != QTable::EMPTY_KEY && index_[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    if (index_[i].key == QTable::EMPTY_KEY) index_size_++;
+    index_[i] = IndexEntry{key, offset};
+}
+
+void QColdStore::encode(uint64_t key, const QRow& row) {
+    buffer_.resize(record_size());
+    char* out = buffer_.data();
+    std::memcpy(out, &key, sizeof(key));
+    out += sizeof(key);
+    for (const auto& entry : row) {
+        if (half_precision_) {
+            uint16_t value = float_to_half(static_cast<float>(entry.q_value));
+            std::memcpy(out, &value, sizeof(value));
+            out += sizeof(value);
+        } else {
+            std::memcpy(out, &entry.q_value, sizeof(entry.q_value));
+            out += sizeof(entry.q_value);
+        }
+        std::memcpy(out, &entry.visit_count, sizeof(entry.visit_count));
+        out += sizeof(entry.visit_count);
+    }
+}
+
+void QColdStore::decode(QRow& row) const {
+    const char* in = buffer_.data() + sizeof(uint64_t);
+    for (auto& entry : row) {
+        if (half_precision_) {
+            uint16_t value;
+            std::memcpy(&value, in, sizeof(value));
+            entry.q_value = half_to_float(value);
+            in += sizeof(value);
+        } else {
+            std::memcpy(&entry.q_value, in, sizeof(entry.q_value));
+            in += sizeof(entry.q_value);
+        }
+        std::memcpy(&entry.visit_count, in, sizeof(entry.visit_count));
+        in += sizeof(entry.visit_count);
+        entry.reserved = 0;
+    }
+}
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "q_table.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// IEEE 754 半精度（float16）との変換（最近接偶数丸め、範囲外は±inf）
+inline uint16_t float_to_half(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t raw_exponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (raw_exponent == 0xFF) {
+        return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+    }
+    int exponent = static_cast<int>(raw_exponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+    if (exponent <= 0) {
+        // 非正規化数（小さすぎれば0）
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000;
+        int shift = 14 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFF;
+    // 繰り上がりで指数部に桁上がりしても正しい値（最大値を超えればinf）になる
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) half++;
+    return static_cast<uint16_t>(half);
+}
+
+inline float half_to_float(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+    uint32_t bits;
+    if (exponent == 0) {
+        float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    } else if (exponent == 31) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Q表から追い出した状態の退避先（コールドティア）
+// 追記専用のファイルに行を書き、キー → ファイル位置の索引をメモリに持つ。
+// 同じキーを再び書いた場合は新しいレコードが有効になる（古いレコードは残る）。
+// 開くときにファイルを走査して索引を作り直すので、学習を再開しても退避した状態を引ける。
+//
+// ファイル形式（リトルエンディアン）:
+//   "PUYOQCLD" + version(uint32) + flags(uint32, bit0 = float16) + key_schema(uint32) + row_size(uint32)
+//   レコード: key(uint64) + 22配置の(Q値 + 訪問回数(int32))
+//   Q値はfloat16ならuint16、そうでなければdouble
+class QColdStore {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t FLAG_HALF = 1;
+
+    QColdStore();
+
+    QColdStore(const QColdStore&) = delete;
+    QColdStore& operator=(const QColdStore&) = delete;
+
+    // ファイルを開く（無ければ作る）
+    // 既存のファイルはそのファイルの精度で追記する（half_precisionは新規作成時のみ有効）
+    bool open(const std::string& path, bool half_precision, std::string* error = nullptr);
+    void close();
+
+    bool is_open() const { return file_.is_open(); }
+    bool half_precision() const { return half_precision_; }
+
+    // 行の追記
+    bool append(uint64_t key, const QRow& row);
+
+    // 行の読み込み（退避していなければfalse）
+    bool read(uint64_t key, QRow& row);
+
+    // 退避している全状態の走査（キーごとに最新のレコードを読む）
+    template <typename Function>
+    void for_each(Function function) {
+        QRow row;
+        for (size_t i = 0; i < index_.size(); ++i) {
+            uint64_t key = index_[i].key;
+            if (key != QTable::EMPTY_KEY && read(key, row)) {
+                function(key, static_cast<const QRow&>(row));
+            }
+        }
+    }
+
+    bool contains(uint64_t key) const { return find_index(key) != nullptr; }
+    size_t size() const { return index_size_; }                 // 退避している状態数
+    uint64_t record_count() const { return record_count_; }     // ファイル中のレコード数（重複を含む）
+    size_t record_size() const;
+
+private:
+    struct IndexEntry {
+        uint64_t key;
+        uint64_t offset;
+    };
+
+    std::fstream file_;
+    std::string path_;
+    bool half_precision_;
+    uint64_t end_offset_;
+    uint64_t record_count_;
+
+    // キー → レコード位置（2の冪の容量、mix64 + 線形探索）
+    std::vector<IndexEntry> index_;
+    size_t index_size_;
+    std::vector<char> buffer_;
+
+    const IndexEntry* find_index(uint64_t key) const;
+    void insert_index(uint64_t key, uint64_t offset);
+    void encode(uint64_t key, const QRow& row);
+    void decode(QRow& row) const;
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "core/bit_field.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// Q値テーブルのエントリ（16バイト、パディングなしでそのままファイルに書き出す）
+struct QEntry {
+    double q_value;
+    int32_t visit_count;
+    int32_t reserved;
+
+    QEntry() : q_value(0.0), visit_count(0), reserved(0) {}
+    QEntry(double q, int count) : q_value(q), visit_count(count), reserved(0) {}
+};
+static_assert(sizeof(QEntry) == 16, "QEntry must be 16 bytes");
+
+// 1状態分の行動価値（PLACEMENTSの22配置を固定長で保持）
+using QRow = std::array<QEntry, PLACEMENT_COUNT>;
+
+// Q値テーブル用の状態キー
+// 各列の高さ4ビット × 6列（0〜23ビット）+ 軸ぷよの色3ビット（24〜26）+ 子ぷよの色3ビット（27〜29）
+inline uint64_t make_state_key(const std::array<int, FIELD_WIDTH>& heights, int axis, int child) {
+    uint64_t key = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        key |= static_cast<uint64_t>(heights[x] & 0xF) << (x * 4);
+    }
+    key |= static_cast<uint64_t>(axis & 0x7) << 24;
+    key |= static_cast<uint64_t>(child & 0x7) << 27;
+    return key;
+}
+
+// オープンアドレス法のQ値テーブル
+// 64ビットの状態キーから行動価値の行を引く。行はスロットに直接格納し、
+// 容量は2の冪、線形探索、負荷率が上限を超えたら倍に拡張する。
+// キーはmix64で散らすため、通常は1回の探索で見つかる。
+class QTable {
+public:
+    static constexpr uint64_t EMPTY_KEY = ~0ULL;   // 空きスロット（状態キーには現れない値）
+    static constexpr double MAX_LOAD_FACTOR = 0.7;
+
+    struct Slot {
+        uint64_t key;
+        QRow row;
+
+        Slot() : key(EMPTY_KEY) {}
+    };
+
+    explicit QTable(size_t initial_capacity = 1024) : size_(0) {
+        slots_.resize(round_up_capacity(initial_capacity));
+    }
+
+    // 行の検索（無ければnullptr）
+    const QRow* find(uint64_t key) const {
+        const Slot& slot = slots_[probe(key)];
+        return slot.key == key ? &slot.row : nullptr;
+    }
+
+    QRow* find(uint64_t key) {
+        Slot& slot = slots_[probe(key)];
+        return slot.key == key ? &slot.row : nullptr;
+    }
+
+    // 行の取得（無ければ0で初期化して追加）
+    QRow& get_or_insert(uint64_t key) {
+        size_t index = probe(key);
+        if (slots_[index].key == key) {
+            return slots_[index].row;
+        }
+
+        if (static_cast<double>(size_ + 1) > MAX_LOAD_FACTOR * slots_.size()) {
+            rehash(slots_.size() * 2);
+            index = probe(key);
+        }
+        slots_[index].key = key;
+        slots_[index].row = QRow();
+        size_++;
+        return slots_[index].row;
+    }
+
+    // 行動価値（未知の状態・行動は0）
+    double get(uint64_t key, int action) const {
+        if (action < 0 || action >= PLACEMENT_COUNT) return 0.0;
+        const QRow* row = find(key);
+        return row ? (*row)[action].q_value : 0.0;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        for (auto& slot : slots_) {
+            slot.key = EMPTY_KEY;
+        }
+        size_ = 0;
+    }
+
+    void reserve(size_t count) {
+        size_t needed = round_up_capacity(static_cast<size_t>(count / MAX_LOAD_FACTOR) + 1);
+        if (needed > slots_.size()) {
+            rehash(needed);
+        }
+    }
+
+    // スロット配列（QTableFileの直列化用）
+    const std::vector<Slot>& slots() const { return slots_; }
+
+    // 同じ配置規則（2の冪の容量、mix64 + 線形探索）で並んだスロット配列をそのまま採用する
+    void assign_slots(std::vector<Slot>&& slots, size_t size) {
+        slots_ = std::move(slots);
+        size_ = size;
+    }
+
+    // 価値の低い状態からcount件を取り除く（取り除いた件数を返す）
+    // 訪問回数の合計が少ない順、同数ならQ値の絶対値の最大が小さい順。
+    // 取り除く行ごとにon_evict(key, row)を呼び、最後に同じ容量で詰め直す。
+    template <typename OnEvict>
+    size_t evict(size_t count, OnEvict on_evict) {
+        count = std::min(count, size_);
+        if (count == 0) return 0;
+
+        struct Candidate {
+            int64_t visits;
+            double magnitude;
+            size_t index;
+        };
+        std::vector<Candidate> candidates;
+        candidates.reserve(size_);
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].key == EMPTY_KEY) continue;
+            Candidate candidate{0, 0.0, i};
+            for (const auto& entry : slots_[i].row) {
+                candidate.visits += entry.visit_count;
+                candidate.magnitude = std::max(candidate.magnitude, std::abs(entry.q_value));
+            }
+            candidates.push_back(candidate);
+        }
+        auto lower_value = [](const Candidate& a, const Candidate& b) {
+            return a.visits != b.visits ? a.visits < b.visits : a.magnitude < b.magnitude;
+        };
+        std::nth_element(candidates.begin(), candidates.begin() + (count - 1), candidates.end(), lower_value);
+
+        for (size_t i = 0; i < count; ++i) {
+            Slot& slot = slots_[candidates[i].index];
+            on_evict(slot.key, slot.row);
+            slot.key = EMPTY_KEY;
+        }
+        size_ -= count;
+        // 線形探索の連なりが途切れるので詰め直す
+        rehash(slots_.size());
+        return count;
+    }
+
+    static uint64_t mix64(uint64_t value) {
+        value ^= value >> 30;
+        value *= 0xBF58476D1CE4E5B9ULL;
+        value ^= value >> 27;
+        value *= 0x94D049BB133111EBULL;
+        value ^= value >> 31;
+        return value;
+    }
+
+    // 全状態の走査（保存用）
+    template <typename Function>
+    void for_each(Function function) const {
+        for (const auto& slot : slots_) {
+            if (slot.key != EMPTY_KEY) {
+                function(slot.key, slot.row);
+            }
+        }
+    }
+
+private:
+    std::vector<Slot> slots_;
+    size_t size_;
+
+    static size_t round_up_capacity(size_t capacity) {
+        size_t result = 16;
+        while (result < capacity) result <<= 1;
+        return result;
+    }
+
+    // keyのスロット、無ければ挿入位置（空きスロット）
+    size_t probe(uint64_t key) const {
+        size_t mask = slots_.size() - 1;
+        size_t index = static_cast<size_t>(mix64(key)) & mask;
+        while (slots_[index].key != key && slots_[index].key != EMPTY_KEY) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<Slot> old_slots(round_up_capacity(new_capacity));
+        old_slots.swap(slots_);
+        for (const auto& slot : old_slots) {
+            if (slot.key != EMPTY_KEY) {
+                slots_[probe(slot.key)] = slot;
+            }
+        }
+    }
+};
+
+static_assert(sizeof(QTable::Slot) == sizeof(uint64_t) + sizeof(QRow), "QTable::Slot must not be padded");
+
+} // namespace ai
+} // namespace puyo
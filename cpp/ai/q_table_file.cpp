@@ -0,0 +1,290 @@
+#include "q_table_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace puyo {
+namespace ai {
+
+namespace {
+
+constexpr char TABLE_MAGIC[8] = {'P', 'U', 'Y', 'O', 'Q', 'T', 'B', 'L'};
+constexpr char LEGACY_MAGIC[8] = {'P', 'U', 'Y', 'O', 'Q', 'T', '0', '1'};
+constexpr size_t WRITE_CHUNK_SLOTS = 4096;
+
+void set_error(std::string* error, const std::string& message) {
+    if (error) *error = message;
+}
+
+// 32バイトブロック単位のストリーミングチェックサム
+class Checksum {
+public:
+    Checksum() : lanes_{0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0x27D4EB2F165667C5ULL},
+                 buffer_{}, buffered_(0), total_(0) {}
+
+    void update(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        total_ += size;
+        if (buffered_ > 0) {
+            size_t take = std::min(size, BLOCK - buffered_);
+            std::memcpy(buffer_ + buffered_, bytes, take);
+            buffered_ += take;
+            bytes += take;
+            size -= take;
+            if (buffered_ < BLOCK) return;
+            process(buffer_);
+            buffered_ = 0;
+        }
+        for (; size >= BLOCK; bytes += BLOCK, size -= BLOCK) {
+            process(bytes);
+        }
+        std::memcpy(buffer_, bytes, size);
+        buffered_ = size;
+    }
+
+    uint64_t finish() {
+        if (buffered_ > 0) {
+            std::memset(buffer_ + buffered_, 0, BLOCK - buffered_);
+            process(buffer_);
+            buffered_ = 0;
+        }
+        uint64_t hash = total_;
+        for (uint64_t lane : lanes_) {
+            hash = QTable::mix64(hash ^ lane);
+        }
+        return hash;
+    }
+
+private:
+    static constexpr size_t BLOCK = 32;
+
+    void process(const uint8_t* block) {
+        for (int i = 0; i < 4; ++i) {
+            uint64_t word;
+            std::memcpy(&word, block + i * 8, sizeof(word));
+            lanes_[i] = (lanes_[i] ^ word) * 0x9FB21C651E98DF25ULL;
+            lanes_[i] ^= lanes_[i] >> 29;
+        }
+    }
+
+    uint64_t lanes_[4];
+    uint8_t buffer_[BLOCK];
+    size_t buffered_;
+    uint64_t total_;
+};
+
+// ヘッダーの妥当性チェック
+bool validate_header(const QTableFile::Header& header, size_t file_size, std::string* error) {
+    if (std::memcmp(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0) {
+        set_error(error, "not a Q-table file");
+        return false;
+    }
+    if (header.version != QTableFile::FORMAT_VERSION) {
+        set_error(error, "unsupported Q-table version " + std::to_string(header.version));
+        return false;
+    }
+    if (header.key_schema != QTableFile::KEY_SCHEMA) {
+        set_error(error, "unsupported state key schema " + std::to_string(header.key_schema));
+        return false;
+    }
+    if (header.slot_size != sizeof(QTable::Slot) || header.row_size != static_cast<uint32_t>(PLACEMENT_COUNT)) {
+        set_error(error, "Q-table slot layout mismatch");
+        return false;
+    }
+    uint64_t slot_count = header.slot_count;
+    if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0 || header.entry_count >= slot_count) {
+        set_error(error, "invalid Q-table slot count");
+        return false;
+    }
+    if (slot_count > (file_size - sizeof(QTableFile::Header)) / sizeof(QTable::Slot) ||
+        file_size != sizeof(QTableFile::Header) + slot_count * sizeof(QTable::Slot)) {
+        set_error(error, "Q-table file is truncated or has trailing data");
+        return false;
+    }
+    return true;
+}
+
+// バージョン1（キーと行を1件ずつ書いた形式）の読み込み
+bool read_legacy(std::ifstream& file, QTable& table, std::string* error) {
+    uint64_t table_size = 0;
+    if (!file.read(reinterpret_cast<char*>(&table_size), sizeof(table_size))) {
+        set_error(error, "Q-table file is truncated");
+        return false;
+    }
+
+    QTable loaded;
+    loaded.reserve(table_size);
+    for (uint64_t i = 0; i < table_size; ++i) {
+        uint64_t key = 0;
+        QRow row;
+        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+        for (auto& entry : row) {
+            file.read(reinterpret_cast<char*>(&entry.q_value), sizeof(entry.q_value));
+            file.read(reinterpret_cast<char*>(&entry.visit_count), sizeof(entry.visit_count));
+        }
+        if (!file) {
+            set_error(error, "Q-table file is truncated");
+            return false;
+        }
+        loaded.get_or_insert(key) = row;
+    }
+    table = std::move(loaded);
+    return true;
+}
+
+} // namespace
+
+uint64_t QTableFile::checksum(const void* data, size_t size) {
+    Checksum checksum;
+    checksum.update(data, size);
+    return checksum.finish();
+}
+
+bool QTableFile::write(const std::string& path, const QTable& table, std::string* error) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        set_error(error, "failed to open " + path);
+        return false;
+    }
+
+    const std::vector<QTable::Slot>& slots = table.slots();
+    Header header{};
+    std::memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.key_schema = KEY_SCHEMA;
+    header.entry_count = table.size();
+    header.slot_count = slots.size();
+    header.slot_size = sizeof(QTable::Slot);
+    header.row_size = PLACEMENT_COUNT;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // 空きスロットは古い行が残っていることがあるので0で埋め直してから書く
+    Checksum checksum;
+    std::vector<QTable::Slot> chunk;
+    chunk.reserve(WRITE_CHUNK_SLOTS);
+    auto flush = [&]() {
+        size_t bytes = chunk.size() * sizeof(QTable::Slot);
+        checksum.update(chunk.data(), bytes);
+        file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(bytes));
+        chunk.clear();
+    };
+    for (const auto& slot : slots) {
+        chunk.push_back(slot.key == QTable::EMPTY_KEY ? QTable::Slot() : slot);
+        if (chunk.size() == WRITE_CHUNK_SLOTS) flush();
+    }
+    flush();
+
+    header.checksum = checksum.finish();
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!file) {
+        set_error(error, "failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+bool QTableFile::read(const std::string& path, QTable& table, std::string* error) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        set_error(error, "failed to open " + path);
+        return false;
+    }
+    size_t file_size = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    char magic[8];
+    if (file_size < sizeof(magic) || !file.read(magic, sizeof(magic))) {
+        set_error(error, "Q-table file is truncated");
+        return false;
+    }
+    if (std::memcmp(magic, LEGACY_MAGIC, sizeof(LEGACY_MAGIC)) == 0) {
+        return read_legacy(file, table, error);
+    }
+
+    Header header;
+    file.seekg(0);
+    if (file_size < sizeof(Header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        set_error(error, "Q-table file is truncated");
+        return false;
+    }
+    if (!validate_header(header, file_size, error)) return false;
+
+    std::vector<QTable::Slot> slots(header.slot_count);
+    size_t bytes = slots.size() * sizeof(QTable::Slot);
+    if (!file.read(reinterpret_cast<char*>(slots.data()), static_cast<std::streamsize>(bytes))) {
+        set_error(error, "Q-table file is truncated");
+        return false;
+    }
+    if (checksum(slots.data(), bytes) != header.checksum) {
+        set_error(error, "Q-table checksum mismatch");
+        return false;
+    }
+
+    table.assign_slots(std::move(slots), header.entry_count);
+    return true;
+}
+
+MappedQTable::MappedQTable() : slots_(nullptr), slot_count_(0), entry_count_(0) {}
+
+MappedQTable::~MappedQTable() {
+    close();
+}
+
+bool MappedQTable::open(const std::string& path, bool verify_checksum, std::string* error) {
+    close();
+
+    if (!file_.open(path)) {
+        set_error(error, "failed to open " + path);
+        return false;
+    }
+
+    QTableFile::Header header;
+    if (file_.size() < sizeof(header)) {
+        file_.close();
+        set_error(error, "Q-table file is truncated");
+        return false;
+    }
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (!validate_header(header, file_.size(), error)) {
+        file_.close();
+        return false;
+    }
+
+    const QTable::Slot* slots = reinterpret_cast<const QTable::Slot*>(file_.data() + sizeof(header));
+    if (verify_checksum && QTableFile::checksum(slots, header.slot_count * sizeof(QTable::Slot)) != header.checksum) {
+        file_.close();
+        set_error(error, "Q-table checksum mismatch");
+        return false;
+    }
+
+    slots_ = slots;
+    slot_count_ = header.slot_count;
+    entry_count_ = header.entry_count;
+    return true;
+}
+
+void MappedQTable::close() {
+    file_.close();
+    slots_ = nullptr;
+    slot_count_ = 0;
+    entry_count_ = 0;
+}
+
+const QRow* MappedQTable::find(uint64_t key) const {
+    if (!slots_ || key == QTable::EMPTY_KEY) return nullptr;
+
+    // QTableと同じ探索（壊れたファイルでも止まるよう全スロット分で打ち切る）
+    size_t mask = slot_count_ - 1;
+    size_t index = static_cast<size_t>(QTable::mix64(key)) & mask;
+    for (size_t probes = 0; probes < slot_count_; ++probes) {
+        const QTable::Slot& slot = slots_[index];
+        if (slot.key == key) return &slot.row;
+        if (slot.key == QTable::EMPTY_KEY) return nullptr;
+        index = (index + 1) & mask;
+    }
+    return nullptr;
+}
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "q_table.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// Q表のモデルファイル
+// スロット配列はQTableのメモリ上の配置（2の冪の容量、mix64 + 線形探索）をそのまま書き出すので、
+// 読み込みは1回の一括読み込みで済み、mmapしてその場で探索することもできる。
+//
+// ファイル形式（リトルエンディアン）:
+//   Header（64バイト） + QTable::Slot × slot_count
+//   空きスロットはkey = QTable::EMPTY_KEY、行は0で埋める。
+//   checksumはスロット配列全体のchecksum()。
+class QTableFile {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+    static constexpr uint32_t KEY_SCHEMA = 1;   // make_state_key（列の高さ4ビット × 6 + 軸色 + 子色）
+
+    struct Header {
+        char magic[8];          // "PUYOQTBL"
+        uint32_t version;
+        uint32_t key_schema;
+        uint64_t entry_count;   // 使用中のスロット数
+        uint64_t slot_count;    // 2の冪
+        uint32_t slot_size;     // sizeof(QTable::Slot)
+        uint32_t row_size;      // PLACEMENT_COUNT
+        uint64_t checksum;
+        uint32_t reserved[4];
+    };
+    static_assert(sizeof(Header) == 64, "QTableFile::Header must be 64 bytes");
+
+    static bool write(const std::string& path, const QTable& table, std::string* error = nullptr);
+
+    // 一括読み込み（チェックサムを検証する）
+    // バージョン1の形式（"PUYOQT01" + 状態数 + (キー + 22配置の(Q値, 訪問回数))の並び）も読める
+    static bool read(const std::string& path, QTable& table, std::string* error = nullptr);
+
+    // 64ビットのチェックサム（8バイト単位の4レーンで処理）
+    static uint64_t checksum(const void* data, size_t size);
+};
+
+// mmapしたQ表（読み取り専用）
+// 推論サーバーの起動時に巨大な表を読み込まず、必要なページだけを参照する。
+class MappedQTable {
+public:
+    MappedQTable();
+    ~MappedQTable();
+
+    MappedQTable(const MappedQTable&) = delete;
+    MappedQTable& operator=(const MappedQTable&) = delete;
+
+    // ファイルを開く（形式不正・存在しない場合はfalse）
+    // verify_checksumなら全体を読んで検証する（開く時間はファイルサイズに比例する）
+    bool open(const std::string& path, bool verify_checksum = false, std::string* error = nullptr);
+    void close();
+
+    bool is_open() const { return slots_ != nullptr; }
+    size_t size() const { return entry_count_; }
+    size_t capacity() const { return slot_count_; }
+
+    // 行の検索（無ければnullptr）
+    const QRow* find(uint64_t key) const;
+
+    // 行動価値（未知の状態・行動は0）
+    double get(uint64_t key, int action) const {
+        if (action < 0 || action >= PLACEMENT_COUNT) return 0.0;
+        const QRow* row = find(key);
+        return row ? (*row)[action].q_value : 0.0;
+    }
+
+    // 全状態の走査
+    template <typename Function>
+    void for_each(Function function) const {
+        for (size_t i = 0; i < slot_count_; ++i) {
+            if (slots_[i].key != QTable::EMPTY_KEY) {
+                function(slots_[i].key, slots_[i].row);
+            }
+        }
+    }
+
+private:
+    MappedFile file_;
+    const QTable::Slot* slots_;
+    size_t slot_count_;
+    size_t entry_count_;
+};
+
+} // namespace ai
+} // namespace puyo
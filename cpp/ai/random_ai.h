@@ -66,7 +66,7 @@ public:
             return AIDecision(-1, 0, {}, 0.0, "No valid positions available");
         }
         
-        // ランダムに1つ選択
+        // ランダムに1つ選択（一瞬で終わるため中止要求・締め切りは確認しない）
         std::uniform_int_distribution<> dis(0, valid_positions.size() - 1);
         int selected_index = dis(gen_);
         auto selected_position = valid_positions[selected_index];
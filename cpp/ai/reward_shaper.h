@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ai_utils.h"
+#include "rl_features.h"
+#include "core/bit_field.h"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <map>
+#include <string>
+
+namespace puyo {
+namespace ai {
+
+// 強化学習の報酬の整形（rl_player.yamlのrewardsセクション）
+// 1手の報酬を、連鎖の結果（BitChainResult）と手の前後の盤面の集計（RLFieldSummary）だけから求める。
+// 手の後の集計は次の手の「前」としてそのまま使うので、盤面の集計は1手につき1回で済む。
+// 線形価値関数の貪欲な配置（RLPlayerAI::greedy_linear_placement）では集計を特徴抽出と同じ走査で得るので、
+// 報酬のために盤面を別に走査しない。Q表の方策やVecEnvでは集計のためにRLFeatureExtractor::summarizeを1回呼ぶ。
+//
+//   連鎖した手:   chain_rewards[連鎖数] + 得点 × score_multiplier
+//   連鎖しない手: 増えた同色隣接の組 × color_grouping + 増えた3連結 × chain_building
+//                （同色隣接が増えなければ waste_move も加える）
+//   共通:         puyo_placement、最大の高さ > high_field_height なら high_field、窒息なら game_over
+class RewardShaper {
+public:
+    static constexpr int MAX_CHAIN = 19;
+
+    struct Weights {
+        std::map<int, double> chain_rewards;   // 連鎖数 → 報酬（設定の無い連鎖数は、それ以下で最大の設定値）
+        double score_multiplier;
+        double puyo_placement;
+        double color_grouping;
+        double chain_building;
+        double game_over;
+        double high_field;
+        int high_field_height;
+        double waste_move;
+
+        Weights() : score_multiplier(0.001), puyo_placement(0.1), color_grouping(2.0), chain_building(5.0),
+                    game_over(-100.0), high_field(-5.0), high_field_height(10), waste_move(-1.0) {
+            chain_rewards[1] = 5.0;
+            chain_rewards[2] = 15.0;
+            chain_rewards[3] = 50.0;
+            chain_rewards[4] = 100.0;
+            chain_rewards[5] = 200.0;
+        }
+    };
+
+    explicit RewardShaper(const Weights& weights = Weights()) : weights_(weights) {
+        // 連鎖数で引く表にしておく
+        chain_table_.fill(0.0);
+        for (int chain = 1; chain <= MAX_CHAIN; ++chain) {
+            auto it = weights_.chain_rewards.upper_bound(chain);
+            chain_table_[chain] = it == weights_.chain_rewards.begin() ? 0.0 : std::prev(it)->second;
+        }
+    }
+
+    // YAML設定（ConfigLoader::load_configの結果）のrewardsセクションから
+    static RewardShaper from_config(const std::map<std::string, std::string>& yaml_config) {
+        Weights weights;
+        for (int chain = 1; chain <= MAX_CHAIN; ++chain) {
+            std::string key = "rewards.chain_rewards." + std::to_string(chain);
+            if (yaml_config.count(key)) {
+                weights.chain_rewards[chain] = ConfigLoader::get_double(yaml_config, key, 0.0);
+            }
+        }
+        weights.score_multiplier = ConfigLoader::get_double(yaml_config, "rewards.score_multiplier", 0.001);
+        weights.puyo_placement = ConfigLoader::get_double(yaml_config, "rewards.puyo_placement", 0.1);
+        weights.color_grouping = ConfigLoader::get_double(yaml_config, "rewards.color_grouping", 2.0);
+        weights.chain_building = ConfigLoader::get_double(yaml_config, "rewards.chain_building", 5.0);
+        weights.game_over = ConfigLoader::get_double(yaml_config, "rewards.game_over", -100.0);
+        weights.high_field = ConfigLoader::get_double(yaml_config, "rewards.high_field", -5.0);
+        weights.high_field_height = ConfigLoader::get_int(yaml_config, "rewards.high_field_height", 10);
+        weights.waste_move = ConfigLoader::get_double(yaml_config, "rewards.waste_move", -1.0);
+        return RewardShaper(weights);
+    }
+
+    static RewardShaper from_file(const std::string& config_path) {
+        return from_config(ConfigLoader::load_config(config_path));
+    }
+
+    const Weights& weights() const { return weights_; }
+
+    // 連鎖の報酬（chain_rewards + 得点 × score_multiplier）
+    double chain_reward(int chain_count, int score) const {
+        if (chain_count <= 0) return 0.0;
+        return chain_table_[std::min(chain_count, MAX_CHAIN)] + score * weights_.score_multiplier;
+    }
+
+    double game_over_reward() const { return weights_.game_over; }
+
+    // 1手の報酬（before / after: 手の前後の盤面の集計、afterは連鎖が終わった後）
+    double shape(const RLFieldSummary& before, const RLFieldSummary& after, const BitChainResult& result,
+                 bool game_over) const {
+        double reward = weights_.puyo_placement;
+        if (result.chain_count > 0) {
+            reward += chain_reward(result.chain_count, result.score);
+        } else {
+            int pair_gain = after.adjacent_pairs - before.adjacent_pairs;
+            reward += pair_gain * weights_.color_grouping + (after.groups_3 - before.groups_3) * weights_.chain_building;
+            if (pair_gain <= 0) reward += weights_.waste_move;
+        }
+        if (after.max_height > weights_.high_field_height) reward += weights_.high_field;
+        if (game_over) reward += weights_.game_over;
+        return reward;
+    }
+
+private:
+    Weights weights_;
+    std::array<double, MAX_CHAIN + 1> chain_table_;
+};
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "experience_replay.h"
+#include "core/bit_field.h"
+#include "core/puyo_types.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace puyo {
+namespace ai {
+
+// 線形価値関数の特徴ベクトル（SIMDで4要素ずつ処理できるよう16バイト境界・4の倍数）
+struct alignas(16) RLFeatureVector {
+    static constexpr int SIZE = 24;
+    std::array<float, SIZE> values;
+
+    RLFeatureVector() : values{} {}
+
+    float& operator[](int index) { return values[index]; }
+    float operator[](int index) const { return values[index]; }
+    const float* data() const { return values.data(); }
+};
+
+// 報酬の整形に使う盤面の集計（特徴抽出と同じ走査で求まる）
+struct RLFieldSummary {
+    int adjacent_pairs;     // 上下左右に隣接する同色の組
+    int groups_3;           // 連結数3のグループ（あと1個で消える）
+    int max_height;
+
+    RLFieldSummary() : adjacent_pairs(0), groups_3(0), max_height(0) {}
+};
+
+// ビットボードからの特徴抽出
+// 色は入れ替えても意味が変わらないので、色ごとではなく全色の合計で数える。
+// 値はおおむね0〜1に正規化する。
+class RLFeatureExtractor {
+public:
+    enum Feature {
+        BIAS = 0,
+        HEIGHT = 1,                 // 列の高さ × 6
+        HEIGHT_DIFF = 7,            // 隣接列の高さの差 × 5
+        MAX_HEIGHT = 12,
+        DANGER = 13,                // 3列目（窒息点）の高さ
+        PUYO_COUNT = 14,
+        HORIZONTAL_PAIRS = 15,      // 横に隣接する同色の組
+        VERTICAL_PAIRS = 16,        // 縦に隣接する同色の組
+        SINGLES = 17,               // 連結数1のぷよ
+        GROUPS_2 = 18,              // 連結数2のグループ
+        GROUPS_3 = 19,              // 連結数3のグループ
+        GARBAGE = 20,               // 盤面のおじゃまぷよ
+        POTENTIAL_CHAIN = 21,       // 連鎖ポテンシャル（連鎖数）
+        POTENTIAL_SCORE = 22,       // 連鎖ポテンシャル（得点の対数）
+        PENDING_GARBAGE = 23        // 予告おじゃまぷよ
+    };
+
+    // use_chain_potential = falseなら連鎖ポテンシャル（シミュレーションを伴う）を0にする
+    explicit RLFeatureExtractor(bool use_chain_potential = true, int potential_max_added = 2)
+        : use_chain_potential_(use_chain_potential), potential_max_added_(potential_max_added) {}
+
+    // summaryを渡すと報酬の整形用の集計も同時に書く
+    void extract(const BitField& field, int pending_garbage, RLFeatureVector& out,
+                 RLFieldSummary* summary = nullptr) const {
+        constexpr float HEIGHT_SCALE = 1.0f / FIELD_HEIGHT;
+        constexpr float CELL_SCALE = 1.0f / (FIELD_WIDTH * (FIELD_HEIGHT - 1));
+
+        out = RLFeatureVector();
+        out[BIAS] = 1.0f;
+
+        int max_height = 0;
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            int height = field.height(x);
+            out[HEIGHT + x] = height * HEIGHT_SCALE;
+            max_height = std::max(max_height, height);
+            if (x + 1 < FIELD_WIDTH) {
+                out[HEIGHT_DIFF + x] = std::abs(height - field.height(x + 1)) * HEIGHT_SCALE;
+            }
+        }
+        out[MAX_HEIGHT] = max_height * HEIGHT_SCALE;
+        out[DANGER] = std::max(0, field.height(2) - 8) / 4.0f;
+        out[PUYO_COUNT] = field.count_puyos() * CELL_SCALE;
+
+        int horizontal = 0, vertical = 0;
+        int groups[4] = {0, 0, 0, 0};
+        count_connections(field, horizontal, vertical, groups);
+        out[HORIZONTAL_PAIRS] = horizontal * CELL_SCALE * 2.0f;
+        out[VERTICAL_PAIRS] = vertical * CELL_SCALE * 2.0f;
+        out[SINGLES] = groups[1] * CELL_SCALE;
+        out[GROUPS_2] = groups[2] * CELL_SCALE * 2.0f;
+        out[GROUPS_3] = groups[3] * CELL_SCALE * 3.0f;
+        out[GARBAGE] = field.count_color(PuyoColor::GARBAGE) * CELL_SCALE;
+
+        if (use_chain_potential_) {
+            ChainPotential potential = field.chain_potential(potential_max_added_);
+            out[POTENTIAL_CHAIN] = potential.chain_count / 10.0f;
+            out[POTENTIAL_SCORE] = static_cast<float>(std::log1p(static_cast<double>(potential.score)) / 12.0);
+        }
+        out[PENDING_GARBAGE] = std::min(pending_garbage, 30) / 30.0f;
+
+        if (summary) {
+            summary->adjacent_pairs = horizontal + vertical;
+            summary->groups_3 = groups[3];
+            summary->max_height = max_height;
+        }
+    }
+
+    // 報酬の整形用の集計だけを求める
+    static RLFieldSummary summarize(const BitField& field) {
+        RLFieldSummary summary;
+        int horizontal = 0, vertical = 0;
+        int groups[4] = {0, 0, 0, 0};
+        count_connections(field, horizontal, vertical, groups);
+        summary.adjacent_pairs = horizontal + vertical;
+        summary.groups_3 = groups[3];
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            summary.max_height = std::max(summary.max_height, field.height(x));
+        }
+        return summary;
+    }
+
+    // 経験リプレイのスナップショットから盤面を復元
+    static BitField field_from_packed(const PackedRLState& packed) {
+        BitField field;
+        for (int y = 0; y < FIELD_HEIGHT; ++y) {
+            for (int x = 0; x < FIELD_WIDTH; ++x) {
+                uint8_t color = packed.cell(y * FIELD_WIDTH + x);
+                if (color != 0) field.set_puyo(x, y, static_cast<PuyoColor>(color));
+            }
+        }
+        return field;
+    }
+
+private:
+    bool use_chain_potential_;
+    int potential_max_added_;
+
+    // 連結: 隣接ペアはシフトとAND、グループは色ごとに塗りつぶして大きさを数える（groups[3]は3以上）
+    static void count_connections(const BitField& field, int& horizontal, int& vertical, int groups[4]) {
+        for (int c = 1; c <= 5; ++c) {
+            BitBoard128 bits = field.get_color_bits(static_cast<PuyoColor>(c));
+            if (bits == 0) continue;
+            horizontal += popcount(bits & (bits >> BitField::COLUMN_STRIDE));
+            vertical += popcount(bits & (bits >> 1));
+
+            BitBoard128 remaining = bits;
+            while (remaining != 0) {
+                BitBoard128 group = flood(remaining & (~remaining + 1), bits);
+                remaining &= ~group;
+                groups[std::min(3, popcount(group))]++;
+            }
+        }
+    }
+
+    static int popcount(BitBoard128 bits) {
+        return __builtin_popcountll(static_cast<uint64_t>(bits)) +
+               __builtin_popcountll(static_cast<uint64_t>(bits >> 64));
+    }
+
+    // seedから上下左右にregion内を広げた連結成分
+    static BitBoard128 flood(BitBoard128 seed, BitBoard128 region) {
+        BitBoard128 group = seed;
+        for (;;) {
+            BitBoard128 grown = group | (group << 1) | (group >> 1) |
+                                (group << BitField::COLUMN_STRIDE) | (group >> BitField::COLUMN_STRIDE);
+            grown &= region;
+            if (grown == group) return group;
+            group = grown;
+        }
+    }
+};
+
+} // namespace ai
+} // namespace puyo
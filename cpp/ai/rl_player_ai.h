@@ -2,14 +2,24 @@
 
 #include "ai_base.h"
 #include "ai_utils.h"
+#include "q_table.h"
+#include "q_table_file.h"
+#include "concurrent_q_table.h"
+#include "q_cold_store.h"
+#include "experience_replay.h"
+#include "linear_value_model.h"
+#include "rl_features.h"
+#include "reward_shaper.h"
+#include "core/bit_field.h"
 #include "core/field.h"
+#include "core/garbage_system.h"
 #include <vector>
 #include <memory>
 #include <random>
 #include <map>
+#include <cstdio>
 #include <fstream>
-#include <deque>
-#include <chrono>
+#include <iterator>
 
 namespace puyo {
 namespace ai {
@@ -21,60 +31,59 @@ struct RLState {
     std::vector<int> next_colors;  // ネクスト情報（最大4個）
     int turn_count;                // ターン数
     int last_chain_count;          // 最後の連鎖数
+    int pending_garbage;           // 予告おじゃまぷよ数（経験ではpackとは別に持つ）
     double field_stability;        // フィールド安定性スコア
     
     RLState() : field_state(FIELD_WIDTH * FIELD_HEIGHT, 0), next_colors(4, 0),
-               turn_count(0), last_chain_count(0), field_stability(0.0) {
+               turn_count(0), last_chain_count(0), pending_garbage(0), field_stability(0.0) {
         current_colors[0] = 0;
         current_colors[1] = 0;
     }
     
-    // 状態のハッシュ値計算（Q-table用）
-    std::string to_hash() const {
-        std::string hash_str = "";
-        // フィールド状態の簡略化（高さ情報のみ）
+    // Q値テーブル用の状態キー
+    // 各列の高さ4ビット × 6列（0〜23ビット）+ 軸ぷよの色3ビット（24〜26）+ 子ぷよの色3ビット（27〜29）
+    uint64_t pack_key() const {
+        std::array<int, FIELD_WIDTH> heights{};
         for (int x = 0; x < FIELD_WIDTH; ++x) {
-            int height = 0;
-            for (int y = 0; y < FIELD_HEIGHT; ++y) {
+            for (int y = FIELD_HEIGHT - 1; y >= 0; --y) {
                 if (field_state[y * FIELD_WIDTH + x] != 0) {
-                    height = FIELD_HEIGHT - y;
+                    heights[x] = y + 1;
                     break;
                 }
             }
-            hash_str += std::to_string(height) + ",";
         }
-        hash_str += std::to_string(current_colors[0]) + "," + std::to_string(current_colors[1]);
-        return hash_str;
+        return make_state_key(heights, current_colors[0], current_colors[1]);
     }
-};
-
-// Q値テーブルのエントリ
-struct QEntry {
-    double q_value;
-    int visit_count;
     
-    QEntry() : q_value(0.0), visit_count(0) {}
-    QEntry(double q, int count) : q_value(q), visit_count(count) {}
-};
-
-// 改良された経験データ
-struct Experience {
-    RLState state;
-    std::pair<int, int> action;  // (x, r)
-    double immediate_reward;     // 即座の報酬
-    double chain_bonus;          // 連鎖ボーナス
-    double total_reward;         // 総報酬
-    RLState next_state;
-    bool is_terminal;
-    long timestamp;              // タイムスタンプ
-    
-    Experience(const RLState& s, const std::pair<int, int>& a, double immediate, 
-               double chain, const RLState& next_s, bool terminal)
-        : state(s), action(a), immediate_reward(immediate), chain_bonus(chain),
-          next_state(next_s), is_terminal(terminal) {
-        total_reward = immediate + chain;
-        timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
+    // 経験リプレイ用の48バイトのスナップショット（field_stabilityは格納しない）
+    PackedRLState pack() const {
+        PackedRLState packed;
+        for (int i = 0; i < FIELD_WIDTH * FIELD_HEIGHT; ++i) {
+            packed.set_cell(i, static_cast<uint8_t>(field_state[i]));
+        }
+        packed.current_pair = static_cast<uint8_t>((current_colors[0] & 0xF) | (current_colors[1] & 0xF) << 4);
+        for (int i = 0; i < 2; ++i) {
+            packed.next_pairs[i] = static_cast<uint8_t>((next_colors[i * 2] & 0xF) | (next_colors[i * 2 + 1] & 0xF) << 4);
+        }
+        packed.last_chain_count = static_cast<uint8_t>(std::max(0, std::min(255, last_chain_count)));
+        packed.turn_count = static_cast<uint16_t>(std::max(0, std::min(65535, turn_count)));
+        return packed;
+    }
+    
+    static RLState unpack(const PackedRLState& packed) {
+        RLState state;
+        for (int i = 0; i < FIELD_WIDTH * FIELD_HEIGHT; ++i) {
+            state.field_state[i] = packed.cell(i);
+        }
+        state.current_colors[0] = packed.current_pair & 0xF;
+        state.current_colors[1] = packed.current_pair >> 4;
+        for (int i = 0; i < 2; ++i) {
+            state.next_colors[i * 2] = packed.next_pairs[i] & 0xF;
+            state.next_colors[i * 2 + 1] = packed.next_pairs[i] >> 4;
+        }
+        state.last_chain_count = packed.last_chain_count;
+        state.turn_count = packed.turn_count;
+        return state;
     }
 };
 
@@ -91,38 +100,31 @@ private:
         int buffer_size;
         int batch_size;
         int min_experiences;
+        bool prioritized_replay;               // 優先度付き経験リプレイを使うか
+        PrioritizedReplay::Config prioritized;
+        bool linear_backend;                   // backend: "linear"（特徴量の線形価値関数）なら真
+        double linear_learning_rate;
+        bool linear_chain_potential;           // 特徴量に連鎖ポテンシャルを含めるか
+        int max_states;                        // メモリ上のQ表の状態数の上限（0なら無制限）
+        double evict_fraction;                 // 上限を超えたときに追い出す割合
+        std::string cold_tier_path;            // 追い出した状態の退避先（空なら捨てる）
+        bool cold_tier_half;                   // 退避先のQ値をfloat16で保存するか
         
         LearningConfig() : learning_rate(0.001), discount_factor(0.95),
                           epsilon_start(1.0), epsilon_end(0.01), epsilon_decay(0.995),
-                          buffer_size(10000), batch_size(32), min_experiences(1000) {}
+                          buffer_size(10000), batch_size(32), min_experiences(1000),
+                          prioritized_replay(false), linear_backend(false),
+                          linear_learning_rate(0.01), linear_chain_potential(true),
+                          max_states(0), evict_fraction(0.1), cold_tier_half(true) {}
     } config_;
     
-    // 報酬設定
-    struct RewardConfig {
-        std::map<int, double> chain_rewards;
-        double score_multiplier;
-        double puyo_placement;
-        double color_grouping;
-        double chain_building;
-        double game_over;
-        double high_field;
-        double waste_move;
-        
-        RewardConfig() {
-            chain_rewards[1] = 5.0;
-            chain_rewards[2] = 15.0;
-            chain_rewards[3] = 50.0;
-            chain_rewards[4] = 100.0;
-            chain_rewards[5] = 200.0;
-            score_multiplier = 0.001;
-            puyo_placement = 0.1;
-            color_grouping = 2.0;
-            chain_building = 5.0;
-            game_over = -100.0;
-            high_field = -5.0;
-            waste_move = -1.0;
-        }
-    } rewards_;
+    // 報酬の整形（rewardsセクション）
+    RewardShaper reward_shaper_;
+    
+    // ランダム生成器
+    std::random_device rd_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<> uniform_dist_;
     
     // 学習状態管理
     double current_epsilon_;
@@ -131,16 +133,21 @@ private:
     std::pair<int, int> last_action_;
     bool learning_mode_;
     
-    // Q値テーブル（改良版）
-    std::map<std::string, std::map<std::pair<int, int>, QEntry>> q_table_;
+    // Q値テーブル（状態キー → 22配置の行動価値）
+    QTable q_table_;
+
+    // 線形価値関数（linearバックエンド時はQ表の代わりに使う）
+    LinearValueModel value_model_;
+    RLFeatureExtractor feature_extractor_;
     
-    // 経験リプレイバッファ（循環バッファ）
-    std::deque<Experience> experience_buffer_;
+    // 経験リプレイバッファ（容量分を事前確保したリングバッファ）
+    ExperienceReplay replay_;
+    std::vector<const CompactExperience*> replay_batch_;
     
-    // ランダム生成器
-    std::random_device rd_;
-    std::mt19937 gen_;
-    std::uniform_real_distribution<> uniform_dist_;
+    // 優先度付き経験リプレイ（prioritized_replay有効時はreplay_の代わりに使う）
+    PrioritizedReplay prioritized_replay_;
+    std::vector<PrioritizedReplay::Sample> prioritized_batch_;
+    std::vector<double> td_errors_;
     
     // 学習統計と性能監視
     struct LearningStats {
@@ -151,10 +158,24 @@ private:
         double best_episode_reward;
         int best_chain_count;
         
+        double episode_reward;        // 進行中のエピソードの累積報酬
+        
         LearningStats() : total_episodes(0), cumulative_reward(0.0),
-                         best_episode_reward(-999999), best_chain_count(0) {}
+                         best_episode_reward(-999999), best_chain_count(0), episode_reward(0.0) {}
     } stats_;
     
+    // mmapしたモデル（mmap_model有効時、読み取り専用。学習した分はq_table_に重ねる）
+    MappedQTable mapped_model_;
+    bool mmap_model_;
+    
+    // Q表から追い出した状態の退避先（読み込みは参照用の関数からも行うのでmutable）
+    mutable QColdStore cold_store_;
+    mutable QRow cold_row_;            // 退避先から読んだ行の作業領域
+    size_t evicted_states_;
+    
+    // 更新したQ表の行のキーの記録先（RLTrainerが変わった行だけをactorへ公開するため、nullptrなら記録しない）
+    std::vector<uint64_t>* updated_keys_;
+    
     // モデル管理
     std::string model_save_path_;
     std::string checkpoint_dir_;
@@ -163,7 +184,8 @@ private:
 public:
     RLPlayerAI(const AIParameters& params = {}) 
         : AIBase("RLPlayerAI"), gen_(rd_()), uniform_dist_(0.0, 1.0),
-          current_epsilon_(1.0), episode_count_(0), learning_mode_(true),
+          current_epsilon_(1.0), episode_count_(0), learning_mode_(true), mmap_model_(false), evicted_states_(0),
+          updated_keys_(nullptr),
           model_save_path_("models/rl_best.pth"), checkpoint_dir_("models/rl_checkpoints"),
           save_interval_(100) {
         
@@ -178,6 +200,21 @@ public:
         // 初期化
         current_epsilon_ = config_.epsilon_start;
         last_action_ = {-1, -1};
+        feature_extractor_ = RLFeatureExtractor(config_.linear_chain_potential);
+        if (!config_.cold_tier_path.empty()) {
+            cold_store_.open(config_.cold_tier_path, config_.cold_tier_half);
+        }
+        size_t buffer_size = static_cast<size_t>(std::max(1, config_.buffer_size));
+        size_t batch_size = static_cast<size_t>(std::max(0, config_.batch_size));
+        if (config_.prioritized_replay) {
+            prioritized_replay_.set_config(config_.prioritized);
+            prioritized_replay_.reset(buffer_size);
+            prioritized_batch_.reserve(batch_size);
+            td_errors_.reserve(batch_size);
+        } else {
+            replay_.reset(buffer_size);
+            replay_batch_.reserve(batch_size);
+        }
     }
     
     // YAML設定読み込み
@@ -191,31 +228,35 @@ public:
         config_.epsilon_start = ConfigLoader::get_double(yaml_config, "learning.epsilon_start", 1.0);
         config_.epsilon_end = ConfigLoader::get_double(yaml_config, "learning.epsilon_end", 0.01);
         config_.epsilon_decay = ConfigLoader::get_double(yaml_config, "learning.epsilon_decay", 0.995);
+        config_.linear_backend = ConfigLoader::get_string(yaml_config, "learning.backend", "tabular") == "linear";
+        config_.linear_learning_rate = ConfigLoader::get_double(yaml_config, "learning.linear_learning_rate", 0.01);
+        config_.linear_chain_potential = ConfigLoader::get_bool(yaml_config, "learning.linear_chain_potential", true);
         
         // 経験リプレイ
         config_.buffer_size = ConfigLoader::get_int(yaml_config, "experience_replay.buffer_size", 10000);
         config_.batch_size = ConfigLoader::get_int(yaml_config, "experience_replay.batch_size", 32);
         config_.min_experiences = ConfigLoader::get_int(yaml_config, "experience_replay.min_experiences", 1000);
+        config_.prioritized_replay = ConfigLoader::get_bool(yaml_config, "prioritized_replay.enabled", false);
+        config_.prioritized.alpha = ConfigLoader::get_double(yaml_config, "prioritized_replay.alpha", 0.6);
+        config_.prioritized.beta_start = ConfigLoader::get_double(yaml_config, "prioritized_replay.beta_start", 0.4);
+        config_.prioritized.beta_end = ConfigLoader::get_double(yaml_config, "prioritized_replay.beta_end", 1.0);
+        config_.prioritized.beta_steps = ConfigLoader::get_int(yaml_config, "prioritized_replay.beta_steps", 100000);
+        config_.prioritized.epsilon = ConfigLoader::get_double(yaml_config, "prioritized_replay.epsilon", 0.01);
         
-        // 報酬設定
-        rewards_.chain_rewards[1] = ConfigLoader::get_double(yaml_config, "rewards.chain_rewards.1", 5.0);
-        rewards_.chain_rewards[2] = ConfigLoader::get_double(yaml_config, "rewards.chain_rewards.2", 15.0);
-        rewards_.chain_rewards[3] = ConfigLoader::get_double(yaml_config, "rewards.chain_rewards.3", 50.0);
-        rewards_.chain_rewards[4] = ConfigLoader::get_double(yaml_config, "rewards.chain_rewards.4", 100.0);
-        rewards_.chain_rewards[5] = ConfigLoader::get_double(yaml_config, "rewards.chain_rewards.5", 200.0);
-        
-        rewards_.score_multiplier = ConfigLoader::get_double(yaml_config, "rewards.score_multiplier", 0.001);
-        rewards_.puyo_placement = ConfigLoader::get_double(yaml_config, "rewards.puyo_placement", 0.1);
-        rewards_.color_grouping = ConfigLoader::get_double(yaml_config, "rewards.color_grouping", 2.0);
-        rewards_.chain_building = ConfigLoader::get_double(yaml_config, "rewards.chain_building", 5.0);
-        rewards_.game_over = ConfigLoader::get_double(yaml_config, "rewards.game_over", -100.0);
-        rewards_.high_field = ConfigLoader::get_double(yaml_config, "rewards.high_field", -5.0);
-        rewards_.waste_move = ConfigLoader::get_double(yaml_config, "rewards.waste_move", -1.0);
+        // 報酬の整形
+        reward_shaper_ = RewardShaper::from_config(yaml_config);
         
         // モデル管理
         save_interval_ = ConfigLoader::get_int(yaml_config, "model_management.save_interval", 100);
         checkpoint_dir_ = ConfigLoader::get_string(yaml_config, "model_management.checkpoint_dir", "models/rl_checkpoints");
         model_save_path_ = ConfigLoader::get_string(yaml_config, "model_management.best_model_path", "models/rl_best.pth");
+        mmap_model_ = ConfigLoader::get_bool(yaml_config, "model_management.mmap_model", false);
+        
+        // Q表のメモリ上限
+        config_.max_states = ConfigLoader::get_int(yaml_config, "q_table.max_states", 0);
+        config_.evict_fraction = ConfigLoader::get_double(yaml_config, "q_table.evict_fraction", 0.1);
+        config_.cold_tier_path = ConfigLoader::get_string(yaml_config, "q_table.cold_tier_path", "");
+        config_.cold_tier_half = ConfigLoader::get_bool(yaml_config, "q_table.cold_tier_half", true);
     }
     
     bool initialize() override {
@@ -230,7 +271,7 @@ public:
     }
     
     void shutdown() override {
-        // モデルの保存
+        // モデルの保存（失敗しても終了処理は続ける。保存を確かめる場合はsave_model()を直接呼ぶ）
         save_model();
         AIBase::shutdown();
     }
@@ -245,10 +286,11 @@ public:
         }
         
         // 状態をエンコード
-        RLState rl_state = encode_state(*state.own_field, state.current_pair);
+        RLState rl_state = encode_state(*state.own_field, state.current_pair, state.garbage.pending);
         
         // Q学習による行動選択
-        auto action = select_action(rl_state, *state.own_field);
+        // 表引き・22手の1手読みのみで短く一定なので、中止要求・締め切りは確認しない
+        auto action = select_action(rl_state, *state.own_field, state.garbage.pending);
         
         if (action.first == -1 || action.second == -1) {
             return AIDecision(-1, 0, {}, 0.0, "No valid actions available");
@@ -259,10 +301,21 @@ public:
             *state.own_field, action.first, action.second);
         
         // Q値から確信度を計算
-        double confidence = calculate_confidence(rl_state, action);
+        double confidence;
+        std::string value_text;
+        if (config_.linear_backend) {
+            RLFeatureVector features;
+            feature_extractor_.extract(BitField::from_field(*state.own_field), state.garbage.pending, features);
+            double value = value_model_.predict(features);
+            confidence = std::tanh(value / 10.0) * 0.5 + 0.5;
+            value_text = " V=" + std::to_string(value);
+        } else {
+            confidence = calculate_confidence(rl_state, action);
+            value_text = " Q=" + std::to_string(get_q_value(rl_state.pack_key(), action));
+        }
         
-        std::string reason = "RL Q-Learning: epsilon=" + std::to_string(epsilon_) + 
-                           " Q=" + std::to_string(get_q_value(rl_state, action)) +
+        std::string reason = "RL Q-Learning: epsilon=" + std::to_string(current_epsilon_) + 
+                           value_text +
                            " at (" + std::to_string(action.first) + 
                            ", " + rotation_to_string(action.second) + ")";
         
@@ -274,9 +327,15 @@ public:
     }
     
     std::string get_debug_info() const override {
-        return "RLPlayerAI lr=" + std::to_string(learning_rate_) + 
-               " eps=" + std::to_string(epsilon_) + 
-               " games=" + std::to_string(total_games_) +
+        return "RLPlayerAI lr=" + std::to_string(config_.learning_rate) + 
+               " eps=" + std::to_string(current_epsilon_) + 
+               " games=" + std::to_string(stats_.total_episodes) +
+               " states=" + std::to_string(q_table_.size()) +
+               " replay=" + std::to_string(replay_size()) + "/" + std::to_string(replay_capacity()) +
+               (config_.prioritized_replay ? " per" : "") +
+               (config_.linear_backend ? " backend=linear" : "") +
+               (config_.max_states > 0 ? " evicted=" + std::to_string(evicted_states_) : "") +
+               (cold_store_.is_open() ? " cold=" + std::to_string(cold_store_.size()) : "") +
                " avg_reward=" + std::to_string(get_average_reward());
     }
     
@@ -287,26 +346,240 @@ public:
     // 学習用メソッド
     void add_experience(const RLState& state, const std::pair<int, int>& action,
                        double reward, const RLState& next_state, bool is_terminal) {
-        experience_buffer_.emplace_back(state, action, reward, next_state, is_terminal);
+        int action_index = placement_index(action.first, action.second);
+        if (action_index < 0) {
+            // 無効な配置は統計のみ更新
+            record_reward(reward, is_terminal);
+            return;
+        }
         
-        // バッファサイズ制限
-        if (experience_buffer_.size() > static_cast<size_t>(max_buffer_size_)) {
-            experience_buffer_.erase(experience_buffer_.begin());
+        CompactExperience experience;
+        experience.state = state.pack();
+        experience.next_state = next_state.pack();
+        experience.reward = static_cast<float>(reward);
+        experience.action = static_cast<uint8_t>(action_index);
+        experience.terminal = is_terminal ? 1 : 0;
+        experience.pending_garbage = static_cast<uint8_t>(std::max(0, std::min(255, state.pending_garbage)));
+        experience.next_pending_garbage = static_cast<uint8_t>(std::max(0, std::min(255, next_state.pending_garbage)));
+        train_on(experience);
+    }
+    
+    // 詰めた経験1件を格納して学習（RLTrainerの学習スレッドからも使う）
+    void train_on(const CompactExperience& experience) {
+        // 満杯なら最も古い経験を上書き（ヒープ確保なし）
+        if (config_.prioritized_replay) {
+            prioritized_replay_.push(experience);
+        } else {
+            replay_.push(experience);
         }
         
         // 学習実行
         learn_from_experience();
+        enforce_memory_cap();
         
-        // 統計更新
-        total_reward_ += reward;
+        record_reward(experience.reward, experience.terminal != 0);
+    }
+    
+    // 連鎖の報酬（rewards設定のchain_rewards + 得点 × score_multiplier）
+    double chain_reward(int chain_count, int score) const {
+        return reward_shaper_.chain_reward(chain_count, score);
+    }
+    
+    double game_over_reward() const { return reward_shaper_.game_over_reward(); }
+    const RewardShaper& get_reward_shaper() const { return reward_shaper_; }
+    void set_reward_shaper(const RewardShaper& shaper) { reward_shaper_ = shaper; }
+    double get_epsilon() const { return current_epsilon_; }
+    int get_total_episodes() const { return stats_.total_episodes; }
+    const QTable& get_q_table() const { return q_table_; }
+    
+    // Q表の置き換え（RLTrainerのHogwild学習の結果を取り込む）
+    // tableはfor_each_rowで走査した全状態を元にした表とする。mmapしたモデルは開いたままにし、
+    // モデルと同じ値の行（退避先に無いもの）は取り込まないので、save_modelはoverlayに学習分だけを書く
+    void set_q_table(QTable&& table) {
+        if (mapped_model_.is_open()) {
+            QTable changed;
+            table.for_each([&](uint64_t key, const QRow& row) {
+                const QRow* mapped = mapped_model_.find(key);
+                if (mapped && !cold_store_.contains(key) && same_row(*mapped, row)) return;
+                changed.get_or_insert(key) = row;
+            });
+            table = std::move(changed);
+        }
+        q_table_ = std::move(table);
+        enforce_memory_cap();
+    }
+    
+    // メモリ上の表・退避先・mmapしたモデルの全状態を、find_rowと同じ優先順位で1状態1回ずつ走査する
+    template <typename Function>
+    void for_each_row(Function function) const {
+        q_table_.for_each(function);
+        if (cold_store_.is_open()) {
+            cold_store_.for_each([&](uint64_t key, const QRow& row) {
+                if (!q_table_.find(key)) function(key, row);
+            });
+        }
+        if (mapped_model_.is_open()) {
+            mapped_model_.for_each([&](uint64_t key, const QRow& row) {
+                if (!q_table_.find(key) && !cold_store_.contains(key)) function(key, row);
+            });
+        }
+    }
+    
+    // for_each_rowで走査する状態数の上限（重複を除かずに足す）
+    size_t row_count_bound() const {
+        return q_table_.size() + (cold_store_.is_open() ? cold_store_.size() : 0) + mapped_model_.size();
+    }
+    
+    // Q表のメモリ上限（max_states = 0なら無制限）
+    // cold_tier_pathを指定すると追い出した状態をそのファイルへ退避し、表に無い状態の参照時に読む
+    bool set_memory_limit(int max_states, double evict_fraction = 0.1,
+                          const std::string& cold_tier_path = "", bool cold_tier_half = true) {
+        config_.max_states = std::max(0, max_states);
+        config_.evict_fraction = evict_fraction;
+        config_.cold_tier_path = cold_tier_path;
+        config_.cold_tier_half = cold_tier_half;
+        cold_store_.close();
+        bool opened = cold_tier_path.empty() || cold_store_.open(cold_tier_path, cold_tier_half);
+        enforce_memory_cap();
+        return opened;
+    }
+    
+    size_t get_evicted_states() const { return evicted_states_; }
+    const QColdStore& get_cold_store() const { return cold_store_; }
+    
+    // 今からepisodes回エピソードを終えた後のε（record_rewardと同じ減衰）
+    double epsilon_after(int episodes) const {
+        if (current_epsilon_ <= config_.epsilon_end) return current_epsilon_;
+        double epsilon = current_epsilon_ * std::pow(config_.epsilon_decay, episodes);
+        return std::max(std::min(epsilon, current_epsilon_), config_.epsilon_end);
+    }
+    
+    // 共有Q表へのHogwild更新（update_q_valueと同じQ学習の式）
+    // 設定しか参照しないので、複数スレッドから同じ表へ同時に呼んでよい。
+    // 表が満杯で状態を追加できなければfalse
+    bool update_concurrent(ConcurrentQTable& table, const CompactExperience& exp) const {
+        double next_max_q = exp.terminal ? 0.0 : table.max_q(exp.next_state.state_key());
+        ConcurrentQTable::Slot* slot = table.find_or_insert(exp.state.state_key());
+        if (!slot) return false;
+        
+        std::atomic<float>& q_value = slot->q_values[exp.action];
+        double current = q_value.load(std::memory_order_relaxed);
+        double target = exp.reward + config_.discount_factor * next_max_q;
+        q_value.store(static_cast<float>(current + config_.learning_rate * (target - current)),
+                      std::memory_order_relaxed);
+        slot->visit_counts[exp.action].fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    
+    // 以降のQ値の更新で書き換えた行のキーをkeysへ追加する（nullptrで記録をやめる）
+    void set_updated_keys_log(std::vector<uint64_t>* keys) { updated_keys_ = keys; }
+    
+    // keysの行を共有Q表へ書き写す（学習スレッドから、actorが読んでいる表へ書いてよい）
+    // 入りきらなかった行数を返す
+    size_t publish_rows(const std::vector<uint64_t>& keys, ConcurrentQTable& table) const {
+        size_t dropped = 0;
+        for (uint64_t key : keys) {
+            const QRow* row = find_row(key);
+            if (row && !table.store(key, *row)) dropped++;
+        }
+        return dropped;
+    }
+    const LinearValueModel& get_value_model() const { return value_model_; }
+
+    bool is_linear_backend() const { return config_.linear_backend; }
+    void set_linear_backend(bool enabled) { config_.linear_backend = enabled; }
+
+    // 線形価値関数での貪欲な配置（配置のインデックス、置けなければ-1）
+    // 各配置の 即時報酬（RewardShaperで整形） + γ × V(配置・連鎖後の盤面) を比べる。
+    // 報酬の整形に使う配置後の盤面の集計は特徴抽出と同じ走査で求める。
+    // before_summaryに現在の盤面の集計を渡せば求め直さず、best_summaryには選んだ配置の後の集計を書く
+    // （RLTrainerはこれを報酬の整形に使い、盤面を別に走査しない）。
+    // 設定と引数のモデルしか参照しないので、学習中に別スレッドから呼んでもよい。
+    int greedy_linear_placement(const BitField& field, PuyoColor axis, PuyoColor child, int pending_garbage,
+                                const LinearValueModel& model, double* best_value = nullptr,
+                                const RLFieldSummary* before_summary = nullptr,
+                                RLFieldSummary* best_summary = nullptr) const {
+        int best = -1;
+        double best_score = 0.0;
+        RLFeatureVector features;
+        RLFieldSummary before = before_summary ? *before_summary : RLFeatureExtractor::summarize(field);
+        RLFieldSummary after_summary;
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            if (!field.can_place(PLACEMENTS[i].x, PLACEMENTS[i].r)) continue;
+
+            BitField after = field;
+            BitChainResult result = after.place_and_simulate(PLACEMENTS[i].x, PLACEMENTS[i].r, axis, child);
+            double score;
+            if (after.is_game_over()) {
+                after_summary = RLFeatureExtractor::summarize(after);
+                score = reward_shaper_.shape(before, after_summary, result, true);
+            } else {
+                // 予告おじゃまぷよは連鎖の得点で相殺した残りを特徴にする（VecEnv・ChainSearchAIと同じ相殺計算）
+                int remaining_garbage = pending_garbage - GarbageSystem::calculate_offset(result.score, pending_garbage);
+                feature_extractor_.extract(after, remaining_garbage, features, &after_summary);
+                score = reward_shaper_.shape(before, after_summary, result, false) +
+                        config_.discount_factor * model.predict(features);
+            }
+
+            if (best < 0 || score > best_score) {
+                best = i;
+                best_score = score;
+                if (best_summary) *best_summary = after_summary;
+            }
+        }
+        if (best_value) *best_value = best_score;
+        return best;
+    }
+    
+    const std::string& get_model_path() const { return model_save_path_; }
+    void set_model_path(const std::string& path) { model_save_path_ = path; }
+    
+    // モデルの保存（QTableFile形式、linearバックエンドはLinearValueModelの形式）
+    // mmapしたモデルを使っている間は元のファイルを上書きせず、学習した行（メモリ上の表）を
+    // <model>.overlay へ書き出す。表全体を書いたときは古くなるoverlayを消す。
+    bool save_model() {
+        if (config_.linear_backend) return value_model_.save(model_save_path_);
+        if (mapped_model_.is_open()) return QTableFile::write(overlay_path(), q_table_);
+        if (!QTableFile::write(model_save_path_, q_table_)) return false;
+        std::remove(overlay_path().c_str());
+        return true;
+    }
+    
+    // モデルの読み込み（形式不正・チェックサム不一致のファイルは読まない）
+    // mmap_model有効時は一括読み込みせずmmapして参照する。どちらの場合も<model>.overlayがあれば重ねる
+    bool load_model() {
+        if (config_.linear_backend) return value_model_.load(model_save_path_);
+        mapped_model_.close();
+        bool loaded;
+        if (mmap_model_) {
+            q_table_.clear();
+            loaded = mapped_model_.open(model_save_path_);
+        } else {
+            loaded = QTableFile::read(model_save_path_, q_table_);
+        }
+        if (loaded) loaded = load_overlay();
+        enforce_memory_cap();
+        return loaded;
+    }
+    
+    std::string overlay_path() const { return model_save_path_ + ".overlay"; }
+    
+    void set_mmap_model(bool enabled) { mmap_model_ = enabled; }
+    bool is_model_mapped() const { return mapped_model_.is_open(); }
+    
+    // 報酬の統計更新（終端ならエピソードを締めてεを減衰）
+    void record_reward(double reward, bool is_terminal) {
+        stats_.episode_reward += reward;
+        stats_.cumulative_reward += reward;
         if (is_terminal) {
-            total_games_++;
-            reward_history_.push_back(total_reward_);
-            total_reward_ = 0.0; // 次のエピソードのためリセット
+            stats_.total_episodes++;
+            stats_.episode_rewards.push_back(stats_.episode_reward);
+            stats_.best_episode_reward = std::max(stats_.best_episode_reward, stats_.episode_reward);
+            stats_.episode_reward = 0.0; // 次のエピソードのためリセット
             
             // εの減衰
-            if (epsilon_ > min_epsilon_) {
-                epsilon_ *= epsilon_decay_;
+            if (current_epsilon_ > config_.epsilon_end) {
+                current_epsilon_ *= config_.epsilon_decay;
             }
         }
     }
@@ -315,7 +588,7 @@ public:
     void provide_feedback(const GameState& state, const std::pair<int, int>& action, double score) {
         if (!state.own_field) return;
         
-        RLState rl_state = encode_state(*state.own_field, state.current_pair);
+        RLState rl_state = encode_state(*state.own_field, state.current_pair, state.garbage.pending);
         
         // スコアを報酬に変換（正規化）
         double reward = std::min(100.0, score / 10.0); // スコアを10で割って上限100に制限
@@ -327,8 +600,9 @@ public:
 
 private:
     // 状態エンコーディング
-    RLState encode_state(const Field& field, const PuyoPair& current_pair) {
+    RLState encode_state(const Field& field, const PuyoPair& current_pair, int pending_garbage = 0) {
         RLState state;
+        state.pending_garbage = pending_garbage;
         
         // フィールド状態のエンコード（簡易版：各セルの色）
         for (int y = 0; y < FIELD_HEIGHT; ++y) {
@@ -345,31 +619,8 @@ private:
         return state;
     }
     
-    // 状態のハッシュ化（Q値テーブルのキー用）
-    std::string hash_state(const RLState& state) {
-        std::string hash_str;
-        
-        // フィールド状態の圧縮表現（高さのみ）
-        for (int x = 0; x < FIELD_WIDTH; ++x) {
-            int height = 0;
-            for (int y = FIELD_HEIGHT - 1; y >= 0; --y) {
-                if (state.field_state[y * FIELD_WIDTH + x] != 0) {
-                    height = FIELD_HEIGHT - y;
-                    break;
-                }
-            }
-            hash_str += std::to_string(height) + ",";
-        }
-        
-        // 現在のぷよペア色を追加
-        hash_str += std::to_string(state.current_colors[0]) + "," + 
-                   std::to_string(state.current_colors[1]);
-        
-        return hash_str;
-    }
-    
     // 行動選択（ε-greedy戦略）
-    std::pair<int, int> select_action(const RLState& state, const Field& field) {
+    std::pair<int, int> select_action(const RLState& state, const Field& field, int pending_garbage = 0) {
         std::vector<std::pair<int, int>> valid_actions = get_valid_actions(field);
         
         if (valid_actions.empty()) {
@@ -377,17 +628,30 @@ private:
         }
         
         // ε-greedy戦略
-        if (uniform_dist_(gen_) < epsilon_) {
+        if (uniform_dist_(gen_) < current_epsilon_) {
             // 探索：ランダム行動
             std::uniform_int_distribution<> action_dist(0, valid_actions.size() - 1);
             return valid_actions[action_dist(gen_)];
+        } else if (config_.linear_backend) {
+            // 活用：配置後の盤面の価値が最大の行動
+            int best = greedy_linear_placement(BitField::from_field(field),
+                                               static_cast<PuyoColor>(state.current_colors[0]),
+                                               static_cast<PuyoColor>(state.current_colors[1]),
+                                               pending_garbage, value_model_);
+            return best < 0 ? valid_actions[0] : std::make_pair(PLACEMENTS[best].x, PLACEMENTS[best].r);
         } else {
-            // 活用：最良Q値の行動
+            // 活用：最良Q値の行動（状態の行は1回だけ引く）
+            const QRow* row = find_row(state.pack_key());
+            auto q_of = [row](const std::pair<int, int>& action) {
+                int index = placement_index(action.first, action.second);
+                return row && index >= 0 ? (*row)[index].q_value : 0.0;
+            };
+            
             std::pair<int, int> best_action = valid_actions[0];
-            double best_q_value = get_q_value(state, best_action);
+            double best_q_value = q_of(best_action);
             
             for (const auto& action : valid_actions) {
-                double q_value = get_q_value(state, action);
+                double q_value = q_of(action);
                 if (q_value > best_q_value) {
                     best_q_value = q_value;
                     best_action = action;
@@ -413,73 +677,176 @@ private:
         return actions;
     }
     
-    // Q値の取得
-    double get_q_value(const RLState& state, const std::pair<int, int>& action) {
-        std::string state_hash = hash_state(state);
-        
-        auto state_it = q_table_.find(state_hash);
-        if (state_it == q_table_.end()) {
-            return 0.0; // 未知の状態は0で初期化
+    // Q値の取得（未知の状態・行動は0）
+    double get_q_value(uint64_t state_key, const std::pair<int, int>& action) const {
+        int action_index = placement_index(action.first, action.second);
+        const QRow* row = find_row(state_key);
+        return row && action_index >= 0 ? (*row)[action_index].q_value : 0.0;
+    }
+    
+    // 状態の行（学習中の表を優先し、無ければ退避先、mmapしたモデルの順）
+    // 退避先の行は学習中に更新してから追い出したものなので、mmapしたモデルの行より新しい。
+    // 退避先から読んだ行は作業領域を指すので、次の検索までに使い終えること
+    const QRow* find_row(uint64_t state_key) const {
+        const QRow* row = q_table_.find(state_key);
+        if (!row && cold_store_.is_open() && cold_store_.contains(state_key) &&
+            cold_store_.read(state_key, cold_row_)) {
+            row = &cold_row_;
         }
-        
-        auto action_it = state_it->second.find(action);
-        if (action_it == state_it->second.end()) {
-            return 0.0; // 未知の行動は0で初期化
+        if (!row && mapped_model_.is_open()) {
+            row = mapped_model_.find(state_key);
         }
-        
-        return action_it->second.q_value;
+        return row;
     }
     
-    // Q値の更新
-    void update_q_value(const RLState& state, const std::pair<int, int>& action, double new_q_value) {
-        std::string state_hash = hash_state(state);
-        
-        auto& entry = q_table_[state_hash][action];
-        entry.q_value = new_q_value;
-        entry.visit_count++;
+    // 共有Q表（float）を経由して戻ってきた行が元の行と同じ値か
+    static bool same_row(const QRow& original, const QRow& row) {
+        for (int a = 0; a < PLACEMENT_COUNT; ++a) {
+            if (static_cast<float>(original[a].q_value) != static_cast<float>(row[a].q_value) ||
+                original[a].visit_count != row[a].visit_count) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // <model>.overlay（mmapしたモデルで学習して保存した分）があれば表に重ねる
+    bool load_overlay() {
+        if (!std::ifstream(overlay_path()).good()) return true;
+        QTable overlay;
+        if (!QTableFile::read(overlay_path(), overlay)) return false;
+        q_table_.reserve(q_table_.size() + overlay.size());
+        overlay.for_each([this](uint64_t key, const QRow& row) {
+            q_table_.get_or_insert(key) = row;
+        });
+        return true;
+    }
+    
+    // 更新用の行（mmapしたモデル・退避先にある状態は値を写してから更新する）
+    QRow& writable_row(uint64_t state_key) {
+        if (!q_table_.find(state_key)) {
+            if (const QRow* stored = find_row(state_key)) {
+                QRow copy = *stored;
+                return q_table_.get_or_insert(state_key) = copy;
+            }
+        }
+        return q_table_.get_or_insert(state_key);
+    }
+    
+    // メモリ上限を超えたら価値の低い状態を追い出す（退避先があれば書き出す）
+    // 一度にevict_fraction分を追い出し、表の容量は上限に見合う大きさで頭打ちになる
+    void enforce_memory_cap() {
+        size_t max_states = static_cast<size_t>(config_.max_states);
+        if (max_states == 0 || q_table_.size() <= max_states) return;
+        
+        double keep = std::min(1.0, std::max(0.0, 1.0 - config_.evict_fraction));
+        size_t target = std::min(max_states, static_cast<size_t>(max_states * keep));
+        evicted_states_ += q_table_.evict(q_table_.size() - target, [this](uint64_t key, const QRow& row) {
+            if (cold_store_.is_open()) {
+                cold_store_.append(key, row);
+            }
+        });
     }
     
     // 経験からの学習
     void learn_from_experience() {
-        if (experience_buffer_.empty()) return;
+        if (config_.prioritized_replay) {
+            learn_from_prioritized_replay();
+            return;
+        }
+        if (replay_.empty()) return;
         
         // 最新の経験から学習
-        const Experience& exp = experience_buffer_.back();
+        update_q_value(replay_.latest());
         
-        double current_q = get_q_value(exp.state, exp.action);
-        double next_max_q = 0.0;
+        // 十分に溜まったらミニバッチでリプレイ
+        if (replay_.size() >= static_cast<size_t>(config_.min_experiences)) {
+            replay_.sample(static_cast<size_t>(std::max(0, config_.batch_size)), gen_, replay_batch_);
+            for (const CompactExperience* experience : replay_batch_) {
+                update_q_value(*experience);
+            }
+        }
+    }
+    
+    // 優先度付きリプレイからの学習
+    // 重要度重みで更新幅を補正し、TD誤差でバッチの優先度をまとめて更新する
+    void learn_from_prioritized_replay() {
+        if (prioritized_replay_.empty()) return;
         
-        if (!exp.is_terminal) {
-            // 次状態の最大Q値を計算
-            std::vector<std::pair<int, int>> next_actions = {{0,0}, {1,0}, {2,0}, {3,0}, {4,0}, {5,0}}; // 簡易版
-            for (const auto& next_action : next_actions) {
-                double next_q = get_q_value(exp.next_state, next_action);
-                next_max_q = std::max(next_max_q, next_q);
+        update_q_value(prioritized_replay_.latest());
+        
+        if (prioritized_replay_.size() >= static_cast<size_t>(config_.min_experiences)) {
+            prioritized_replay_.sample(static_cast<size_t>(std::max(0, config_.batch_size)), gen_, prioritized_batch_);
+            td_errors_.clear();
+            for (const auto& sample : prioritized_batch_) {
+                td_errors_.push_back(update_q_value(*sample.experience, sample.weight));
+            }
+            prioritized_replay_.update_priorities(prioritized_batch_, td_errors_);
+        }
+    }
+    
+    size_t replay_size() const {
+        return config_.prioritized_replay ? prioritized_replay_.size() : replay_.size();
+    }
+    
+    size_t replay_capacity() const {
+        return config_.prioritized_replay ? prioritized_replay_.capacity() : replay_.capacity();
+    }
+    
+    // 1件の経験によるQ学習の更新（更新前のTD誤差を返す）
+    double update_q_value(const CompactExperience& exp, double weight = 1.0) {
+        if (config_.linear_backend) {
+            return update_linear_value(exp, weight);
+        }
+
+        double next_max_q = 0.0;
+        if (!exp.terminal) {
+            // 次状態の最大Q値（行を1回引いて22配置を走査）
+            if (const QRow* next_row = find_row(exp.next_state.state_key())) {
+                for (const auto& entry : *next_row) {
+                    next_max_q = std::max(next_max_q, entry.q_value);
+                }
             }
         }
         
         // Q学習の更新式
-        double target = exp.reward + discount_factor_ * next_max_q;
-        double new_q = current_q + learning_rate_ * (target - current_q);
-        
-        update_q_value(exp.state, exp.action, new_q);
+        uint64_t state_key = exp.state.state_key();
+        QEntry& entry = writable_row(state_key)[exp.action];
+        if (updated_keys_) updated_keys_->push_back(state_key);
+        double target = exp.reward + config_.discount_factor * next_max_q;
+        double td_error = target - entry.q_value;
+        entry.q_value += config_.learning_rate * weight * td_error;
+        entry.visit_count++;
+        return td_error;
+    }
+
+    // 線形価値関数のTD(0)更新（更新前のTD誤差を返す）
+    // 経験の状態は配置前の盤面なので、V(s) ← r + γV(s') で貪欲方策の価値を近似する。
+    // 予告おじゃまぷよは経験に記録した実際の数を使う（greedy_linear_placementと同じ特徴量で学習する）
+    double update_linear_value(const CompactExperience& exp, double weight) {
+        RLFeatureVector features;
+        double next_value = 0.0;
+        if (!exp.terminal) {
+            feature_extractor_.extract(RLFeatureExtractor::field_from_packed(exp.next_state), exp.next_pending_garbage,
+                                       features);
+            next_value = value_model_.predict(features);
+        }
+        feature_extractor_.extract(RLFeatureExtractor::field_from_packed(exp.state), exp.pending_garbage, features);
+        double target = exp.reward + config_.discount_factor * next_value;
+        return value_model_.update(features, static_cast<float>(target),
+                                   static_cast<float>(config_.linear_learning_rate * weight));
     }
     
     // 確信度計算
     double calculate_confidence(const RLState& state, const std::pair<int, int>& action) {
-        double q_value = get_q_value(state, action);
-        std::string state_hash = hash_state(state);
-        
         // 訪問回数を考慮した確信度
-        auto state_it = q_table_.find(state_hash);
-        if (state_it != q_table_.end()) {
-            auto action_it = state_it->second.find(action);
-            if (action_it != state_it->second.end()) {
-                int visit_count = action_it->second.visit_count;
-                double confidence = std::tanh(q_value / 10.0) * 0.5 + 0.5; // Q値の正規化
-                confidence = std::min(1.0, confidence + visit_count * 0.01); // 訪問回数ボーナス
-                return confidence;
-            }
+        const QRow* row = find_row(state.pack_key());
+        int action_index = placement_index(action.first, action.second);
+        if (row && action_index >= 0 && (*row)[action_index].visit_count > 0) {
+            const QEntry& entry = (*row)[action_index];
+            double confidence = std::tanh(entry.q_value / 10.0) * 0.5 + 0.5; // Q値の正規化
+            confidence = std::min(1.0, confidence + entry.visit_count * 0.01); // 訪問回数ボーナス
+            return confidence;
         }
         
         return 0.1; // デフォルト確信度
@@ -487,91 +854,13 @@ private:
     
     // 平均報酬の計算
     double get_average_reward() const {
-        if (reward_history_.empty()) return 0.0;
+        if (stats_.episode_rewards.empty()) return 0.0;
         
         double sum = 0.0;
-        for (double reward : reward_history_) {
+        for (double reward : stats_.episode_rewards) {
             sum += reward;
         }
-        return sum / reward_history_.size();
-    }
-    
-    // モデルの保存
-    void save_model() {
-        std::ofstream file(model_file_path_, std::ios::binary);
-        if (!file.is_open()) return;
-        
-        // Q値テーブルのサイズ
-        size_t table_size = q_table_.size();
-        file.write(reinterpret_cast<const char*>(&table_size), sizeof(table_size));
-        
-        // 各状態のQ値を保存
-        for (const auto& state_pair : q_table_) {
-            const std::string& state_hash = state_pair.first;
-            const auto& actions = state_pair.second;
-            
-            // 状態ハッシュの長さと内容
-            size_t hash_len = state_hash.length();
-            file.write(reinterpret_cast<const char*>(&hash_len), sizeof(hash_len));
-            file.write(state_hash.c_str(), hash_len);
-            
-            // アクションの数
-            size_t action_count = actions.size();
-            file.write(reinterpret_cast<const char*>(&action_count), sizeof(action_count));
-            
-            // 各アクションのQ値
-            for (const auto& action_pair : actions) {
-                const auto& action = action_pair.first;
-                const QEntry& entry = action_pair.second;
-                
-                file.write(reinterpret_cast<const char*>(&action.first), sizeof(action.first));
-                file.write(reinterpret_cast<const char*>(&action.second), sizeof(action.second));
-                file.write(reinterpret_cast<const char*>(&entry.q_value), sizeof(entry.q_value));
-                file.write(reinterpret_cast<const char*>(&entry.visit_count), sizeof(entry.visit_count));
-            }
-        }
-        
-        file.close();
-    }
-    
-    // モデルの読み込み
-    void load_model() {
-        std::ifstream file(model_file_path_, std::ios::binary);
-        if (!file.is_open()) return;
-        
-        q_table_.clear();
-        
-        // Q値テーブルのサイズ
-        size_t table_size;
-        file.read(reinterpret_cast<char*>(&table_size), sizeof(table_size));
-        
-        for (size_t i = 0; i < table_size; ++i) {
-            // 状態ハッシュ
-            size_t hash_len;
-            file.read(reinterpret_cast<char*>(&hash_len), sizeof(hash_len));
-            
-            std::string state_hash(hash_len, '\0');
-            file.read(&state_hash[0], hash_len);
-            
-            // アクションの数
-            size_t action_count;
-            file.read(reinterpret_cast<char*>(&action_count), sizeof(action_count));
-            
-            // 各アクションのQ値
-            for (size_t j = 0; j < action_count; ++j) {
-                std::pair<int, int> action;
-                QEntry entry;
-                
-                file.read(reinterpret_cast<char*>(&action.first), sizeof(action.first));
-                file.read(reinterpret_cast<char*>(&action.second), sizeof(action.second));
-                file.read(reinterpret_cast<char*>(&entry.q_value), sizeof(entry.q_value));
-                file.read(reinterpret_cast<char*>(&entry.visit_count), sizeof(entry.visit_count));
-                
-                q_table_[state_hash][action] = entry;
-            }
-        }
-        
-        file.close();
+        return sum / stats_.episode_rewards.size();
     }
     
     // 回転状態を文字列に変換
@@ -0,0 +1,413 @@
+#include "rl_trainer.h"
+#include "mpsc_queue.h"
+#include "concurrent_q_table.h"
+#include "core/bit_field.h"
+#include "core/next_generator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+namespace {
+
+// actor → learnerのメッセージ
+struct ActorMessage {
+    CompactExperience experience;
+    int32_t score;
+    uint16_t actor;
+    uint8_t chain_count;
+};
+
+struct TrainingContext {
+    const RLPlayerAI& ai;
+    const RLTrainer::Options& options;
+    MpscQueue<ActorMessage> queue;
+
+    std::mutex snapshot_mutex;
+    std::shared_ptr<const RLTrainer::Snapshot> snapshot;
+
+    // actorが読むQ表（書き込むのはlearnerだけ）と、前回の公開から更新した行のキー
+    std::unique_ptr<ConcurrentQTable> table;
+    std::vector<uint64_t> updated_keys;
+
+    std::atomic<int> episodes_started;
+    std::atomic<int> actors_done;
+    std::atomic<long long> queue_full_waits;
+
+    TrainingContext(const RLPlayerAI& a, const RLTrainer::Options& o)
+        : ai(a), options(o), queue(o.queue_capacity), episodes_started(0), actors_done(0), queue_full_waits(0) {}
+
+    std::shared_ptr<const RLTrainer::Snapshot> latest_snapshot() {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        return snapshot;
+    }
+
+    void publish(const RLPlayerAI& learner) {
+        if (table) {
+            // 同じ行を何度も更新していても書き写すのは1回
+            std::sort(updated_keys.begin(), updated_keys.end());
+            updated_keys.erase(std::unique(updated_keys.begin(), updated_keys.end()), updated_keys.end());
+            learner.publish_rows(updated_keys, *table);
+            updated_keys.clear();
+        }
+        auto next = std::make_shared<const RLTrainer::Snapshot>(learner);
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        snapshot = std::move(next);
+    }
+};
+
+uint8_t pack_pair(const PuyoPair& pair) {
+    return static_cast<uint8_t>((static_cast<int>(pair.axis) & 0xF) | (static_cast<int>(pair.child) & 0xF) << 4);
+}
+
+// ビットボードから経験用のスナップショットを作る（RLState::pack()と同じ配置）
+PackedRLState pack_state(const BitField& field, const NextGenerator& next, int turn, int last_chain) {
+    PackedRLState packed;
+    for (int y = 0; y < FIELD_HEIGHT; ++y) {
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            packed.set_cell(y * FIELD_WIDTH + x, static_cast<uint8_t>(field.get_puyo(x, y)));
+        }
+    }
+    packed.current_pair = pack_pair(next.get_current_pair());
+    packed.next_pairs[0] = pack_pair(next.get_next_pair(1));
+    packed.next_pairs[1] = pack_pair(next.get_next_pair(2));
+    packed.last_chain_count = static_cast<uint8_t>(std::min(255, last_chain));
+    packed.turn_count = static_cast<uint16_t>(std::min(65535, turn));
+    return packed;
+}
+
+// ε-greedy（greedyは有効な配置の中から貪欲な配置を選ぶ）
+template <typename Greedy>
+int select_placement(const BitField& field, double epsilon, std::mt19937& random, Greedy greedy) {
+    int valid[PLACEMENT_COUNT];
+    int valid_count = 0;
+    for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+        if (field.can_place(PLACEMENTS[i].x, PLACEMENTS[i].r)) {
+            valid[valid_count++] = i;
+        }
+    }
+    if (valid_count == 0) return -1;
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    if (uniform(random) < epsilon) {
+        return valid[std::uniform_int_distribution<int>(0, valid_count - 1)(random)];
+    }
+    return greedy(valid, valid_count);
+}
+
+// Q値が最大の配置（q_of(配置)でQ値を引く）
+template <typename QOf>
+int best_placement(const int* valid, int valid_count, QOf q_of) {
+    int best = valid[0];
+    double best_q = q_of(best);
+    for (int i = 1; i < valid_count; ++i) {
+        double q = q_of(valid[i]);
+        if (q > best_q) {
+            best = valid[i];
+            best_q = q;
+        }
+    }
+    return best;
+}
+
+// 1 actor分の自己対戦
+// begin_episode()でエピソードごとのεと貪欲方策を得て、1手ごとにemit(message)を呼ぶ
+// 報酬の整形に使う盤面の集計は1手につき1回（貪欲方策が配置後の盤面を集計していればそれを使う）
+template <typename BeginEpisode, typename Emit>
+void play_episodes(TrainingContext& context, int actor, BeginEpisode begin_episode, Emit emit) {
+    const RLTrainer::Options& options = context.options;
+    NextGenerator next(options.seed + static_cast<unsigned int>(actor));
+    std::seed_seq seeds{options.seed, static_cast<unsigned int>(actor), 0x5EEDu};
+    std::mt19937 random(seeds);
+
+    int episode;
+    while ((episode = context.episodes_started.fetch_add(1)) < options.episodes) {
+        auto policy = begin_episode(episode);
+        BitField field;
+        next.initialize_next_sequence();
+        int last_chain = 0;
+        RLFieldSummary summary;   // 報酬の整形用の盤面の集計（手の後の集計を次の手の前として使う）
+
+        for (int turn = 0; turn < options.max_turns; ++turn) {
+            ActorMessage message;
+            message.actor = static_cast<uint16_t>(actor);
+            message.experience.state = pack_state(field, next, turn, last_chain);
+
+            PuyoPair pair = next.get_current_pair();
+            RLFieldSummary after;
+            bool after_known = false;
+            int action = select_placement(field, policy.epsilon, random, [&](const int* valid, int valid_count) {
+                return policy.greedy(field, pair, message.experience.state, valid, valid_count, summary,
+                                     after, after_known);
+            });
+            BitChainResult result;
+            bool game_over = action < 0;   // 置ける場所が無ければ負け（配置0の経験として送る）
+            double reward = context.ai.game_over_reward();
+            if (!game_over) {
+                result = field.place_and_simulate(PLACEMENTS[action].x, PLACEMENTS[action].r, pair.axis, pair.child);
+                game_over = field.is_game_over();
+                if (!after_known) after = RLFeatureExtractor::summarize(field);
+                reward = context.ai.get_reward_shaper().shape(summary, after, result, game_over);
+                summary = after;
+            }
+            next.advance_to_next();
+            last_chain = result.chain_count;
+
+            bool terminal = game_over || turn + 1 == options.max_turns;
+            message.experience.next_state = pack_state(field, next, turn + 1, last_chain);
+            message.experience.action = static_cast<uint8_t>(std::max(0, action));
+            message.experience.terminal = terminal ? 1 : 0;
+            message.experience.reward = static_cast<float>(reward);
+            // とことんなので予告おじゃまぷよ（pending_garbage）は常に0
+            message.score = result.score;
+            message.chain_count = static_cast<uint8_t>(std::min(255, result.chain_count));
+
+            emit(message);
+            if (terminal) break;
+        }
+    }
+
+    context.actors_done.fetch_add(1, std::memory_order_release);
+}
+
+// 共有Q表の行からQ値が最大の配置（行が無ければ最初の有効な配置）
+int best_shared_placement(const ConcurrentQTable& table, uint64_t key, const int* valid, int valid_count) {
+    const ConcurrentQTable::Slot* slot = table.find(key);
+    if (!slot) return valid[0];
+    return best_placement(valid, valid_count, [slot](int action) {
+        return static_cast<double>(slot->q_values[action].load(std::memory_order_relaxed));
+    });
+}
+
+// learnerのスナップショットで行動し、経験をキューへ送るactor
+// Q表はlearnerが公開した最新の行を読む（エピソードの途中でも公開された行は反映される）
+// 線形モデルの貪欲な配置は、選んだ配置の後の盤面の集計もafterに返す
+struct SnapshotPolicy {
+    const RLPlayerAI& ai;
+    const ConcurrentQTable* table;
+    std::shared_ptr<const RLTrainer::Snapshot> snapshot;
+    double epsilon;
+
+    int greedy(const BitField& field, const PuyoPair& pair, const PackedRLState& state,
+               const int* valid, int valid_count, const RLFieldSummary& before,
+               RLFieldSummary& after, bool& after_known) const {
+        if (ai.is_linear_backend()) {
+            int best = ai.greedy_linear_placement(field, pair.axis, pair.child, 0, snapshot->model, nullptr,
+                                                  &before, &after);
+            after_known = best >= 0;
+            return best;
+        }
+        return best_shared_placement(*table, state.state_key(), valid, valid_count);
+    }
+};
+
+void run_actor(TrainingContext& context, int actor) {
+    play_episodes(context, actor,
+        [&](int) {
+            std::shared_ptr<const RLTrainer::Snapshot> snapshot = context.latest_snapshot();
+            return SnapshotPolicy{context.ai, context.table.get(), snapshot, snapshot->epsilon};
+        },
+        [&](const ActorMessage& message) {
+            // キューが満杯ならlearnerが追いつくまで待つ
+            while (!context.queue.try_push(message)) {
+                context.queue_full_waits.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        });
+}
+
+// 共有Q表を直接読み書きするactor（Hogwild）
+struct HogwildPolicy {
+    const ConcurrentQTable& table;
+    double epsilon;
+
+    int greedy(const BitField&, const PuyoPair&, const PackedRLState& state,
+               const int* valid, int valid_count, const RLFieldSummary&, RLFieldSummary&, bool&) const {
+        return best_shared_placement(table, state.state_key(), valid, valid_count);
+    }
+};
+
+// Hogwild actorの集計（終了後にまとめる）
+struct HogwildResult {
+    long long experiences;
+    long long total_score;
+    long long dropped_updates;
+    int best_chain;
+    std::vector<double> episode_rewards;
+
+    HogwildResult() : experiences(0), total_score(0), dropped_updates(0), best_chain(0) {}
+};
+
+void run_hogwild_actor(TrainingContext& context, int actor, ConcurrentQTable& table, HogwildResult& result) {
+    double episode_reward = 0.0;
+    play_episodes(context, actor,
+        [&](int episode) {
+            // εは開始済みのエピソード数から決める（learnerが居ないため）
+            return HogwildPolicy{table, context.ai.epsilon_after(episode)};
+        },
+        [&](const ActorMessage& message) {
+            if (!context.ai.update_concurrent(table, message.experience)) {
+                result.dropped_updates++;
+            }
+            result.experiences++;
+            result.total_score += message.score;
+            result.best_chain = std::max(result.best_chain, static_cast<int>(message.chain_count));
+            episode_reward += message.experience.reward;
+            if (message.experience.terminal) {
+                result.episode_rewards.push_back(episode_reward);
+                episode_reward = 0.0;
+            }
+        });
+}
+
+// 学習済みの全状態（メモリ上の表・退避先・mmapしたモデル）を取り込んだ共有Q表
+std::unique_ptr<ConcurrentQTable> make_shared_table(const RLPlayerAI& ai, size_t capacity) {
+    std::unique_ptr<ConcurrentQTable> table(new ConcurrentQTable(std::max(
+        capacity, static_cast<size_t>(ai.row_count_bound() / ConcurrentQTable::MAX_LOAD_FACTOR) + 1)));
+    ai.for_each_row([&](uint64_t key, const QRow& row) { table->store(key, row); });
+    return table;
+}
+
+// Hogwild学習: learnerを置かず、全actorが共有Q表を同時に更新する
+void train_hogwild(RLPlayerAI& ai, TrainingContext& context, int actor_count, RLTrainer::Stats& stats) {
+    std::unique_ptr<ConcurrentQTable> shared = make_shared_table(ai, context.options.hogwild_capacity);
+    ConcurrentQTable& table = *shared;
+
+    std::vector<HogwildResult> results(actor_count);
+    std::vector<std::thread> actors;
+    for (int i = 0; i < actor_count; ++i) {
+        actors.emplace_back(run_hogwild_actor, std::ref(context), i, std::ref(table), std::ref(results[i]));
+    }
+    for (auto& actor : actors) {
+        actor.join();
+    }
+
+    ai.set_q_table(table.to_q_table());
+
+    // 報酬統計とεの減衰はエピソードごとに反映する
+    double reward_sum = 0.0;
+    for (const auto& result : results) {
+        stats.experiences += result.experiences;
+        stats.total_score += result.total_score;
+        stats.dropped_updates += result.dropped_updates;
+        stats.best_chain = std::max(stats.best_chain, result.best_chain);
+        for (double reward : result.episode_rewards) {
+            ai.record_reward(reward, true);
+            reward_sum += reward;
+            stats.episodes++;
+        }
+    }
+    stats.average_reward = stats.episodes > 0 ? reward_sum / stats.episodes : 0.0;
+}
+
+// チェックポイントの保存（保存できなかった回数も数える）
+void save_checkpoint(RLPlayerAI& ai, RLTrainer::Stats& stats) {
+    if (ai.save_model()) {
+        stats.checkpoints++;
+    } else {
+        stats.failed_checkpoints++;
+    }
+}
+
+} // namespace
+
+RLTrainer::Snapshot::Snapshot(const RLPlayerAI& learner)
+    : model(learner.is_linear_backend() ? learner.get_value_model() : LinearValueModel()),
+      epsilon(learner.get_epsilon()) {}
+
+RLTrainer::Stats RLTrainer::train(RLPlayerAI& ai, const Options& options) {
+    auto start_time = std::chrono::steady_clock::now();
+    Stats stats;
+
+    int actor_count = options.actors;
+    if (actor_count <= 0) {
+        // learnerのスレッドが要らないHogwildはハードウェア並列数いっぱいまで使う
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        actor_count = std::max(1, options.hogwild ? hardware : hardware - 1);
+    }
+    stats.actors = actor_count;
+    if (options.episodes <= 0 || options.max_turns <= 0) return stats;
+
+    TrainingContext context(ai, options);
+    if (options.hogwild && !ai.is_linear_backend()) {
+        train_hogwild(ai, context, actor_count, stats);
+        if (options.checkpoint_interval >= 0) {
+            save_checkpoint(ai, stats);
+        }
+        stats.elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        stats.experiences_per_sec = stats.elapsed_sec > 0.0 ? stats.experiences / stats.elapsed_sec : 0.0;
+        return stats;
+    }
+
+    if (!ai.is_linear_backend()) {
+        // actorが読む表は学習済みの状態を取り込んでから公開し、以降は更新した行だけを書き写す
+        context.table = make_shared_table(ai, options.hogwild_capacity);
+        ai.set_updated_keys_log(&context.updated_keys);
+    }
+    context.publish(ai);
+
+    std::vector<std::thread> actors;
+    for (int i = 0; i < actor_count; ++i) {
+        actors.emplace_back(run_actor, std::ref(context), i);
+    }
+
+    // learner: キューが空になり、全actorが終わるまで取り出して学習
+    std::vector<double> episode_rewards(actor_count, 0.0);
+    double reward_sum = 0.0;
+    long long updates_since_snapshot = 0;
+    for (;;) {
+        bool actors_finished = context.actors_done.load(std::memory_order_acquire) == actor_count;
+        ActorMessage message;
+        if (!context.queue.try_pop(message)) {
+            if (actors_finished) break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        ai.train_on(message.experience);
+        stats.experiences++;
+        stats.total_score += message.score;
+        stats.best_chain = std::max(stats.best_chain, static_cast<int>(message.chain_count));
+        episode_rewards[message.actor] += message.experience.reward;
+
+        if (message.experience.terminal) {
+            stats.episodes++;
+            reward_sum += episode_rewards[message.actor];
+            episode_rewards[message.actor] = 0.0;
+            if (options.checkpoint_interval > 0 && stats.episodes % options.checkpoint_interval == 0) {
+                save_checkpoint(ai, stats);
+            }
+        }
+
+        if (options.snapshot_interval > 0 && ++updates_since_snapshot >= options.snapshot_interval) {
+            context.publish(ai);
+            stats.snapshots++;
+            updates_since_snapshot = 0;
+        }
+    }
+
+    for (auto& actor : actors) {
+        actor.join();
+    }
+    ai.set_updated_keys_log(nullptr);
+
+    if (options.checkpoint_interval >= 0) {
+        save_checkpoint(ai, stats);
+    }
+
+    stats.queue_full_waits = context.queue_full_waits.load();
+    stats.average_reward = stats.episodes > 0 ? reward_sum / stats.episodes : 0.0;
+    stats.elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    stats.experiences_per_sec = stats.elapsed_sec > 0.0 ? stats.experiences / stats.elapsed_sec : 0.0;
+    return stats;
+}
+
+} // namespace ai
+} // namespace puyo
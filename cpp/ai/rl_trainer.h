@@ -0,0 +1,74 @@
+#pragma once
+
+#include "rl_player_ai.h"
+#include <cstdint>
+#include <string>
+
+namespace puyo {
+namespace ai {
+
+// RLPlayerAIの並列学習ドライバ（actor–learner構成）
+// 各actorスレッドはビットボード上で描画なしの自己対戦（とことん）を行い、
+// 経験をロックフリーのMPSCキューへ送る。learner（train()を呼んだスレッド）は
+// キューから取り出してQ値を更新し、一定回数ごとにQ表（linearバックエンドでは線形モデル）とεのスナップショットを
+// actorへ公開する。Q表は表全体を写さず、前回の公開から更新した行だけをactorが読む共有Q表
+// （ConcurrentQTable）へ書き写す。actorはエピソードの開始時に最新のεと線形モデルを取り込む。
+// チェックポイントはRLPlayerAI::save_model()で保存する。
+//
+// hogwildを有効にするとlearnerを置かず、全actorがConcurrentQTable（ロックなしの共有Q表）を
+// 直接更新する。単一learnerの更新速度が頭打ちになる場合に使う（tabularバックエンドのみ）。
+// どちらの構成でも、共有Q表にはメモリ上の表・退避先・mmapしたモデルの全状態を取り込んでから始める。
+// mmapしたモデルから再開した場合、保存はモデルを書き換えずoverlayへ行う（RLPlayerAI::save_model）。
+class RLTrainer {
+public:
+    struct Options {
+        int actors;                   // actorスレッド数（0ならハードウェア並列数 - 1、最低1）
+        int episodes;                 // 学習するエピソード数
+        int max_turns;                // 1エピソードの最大手数
+        unsigned int seed;            // actor iのNextGeneratorはseed + iから派生
+        int snapshot_interval;        // 何回のQ更新ごとにスナップショットを公開するか
+        int checkpoint_interval;      // 何エピソードごとにsave_model()するか（0なら終了時のみ、負なら保存しない）
+        size_t queue_capacity;        // MPSCキューの容量
+        bool hogwild;                 // actorが共有Q表を直接更新する（途中のチェックポイントは無し、終了時のみ）
+        size_t hogwild_capacity;      // 共有Q表のスロット数（Hogwild、およびactorへ公開するQ表。学習中は拡張しない、
+                                      // 負荷率0.7で新状態の追加を打ち切る）
+
+        Options() : actors(0), episodes(1000), max_turns(200), seed(1), snapshot_interval(2000),
+                    checkpoint_interval(0), queue_capacity(1 << 14), hogwild(false), hogwild_capacity(1 << 18) {}
+    };
+
+    struct Stats {
+        long long episodes;
+        long long experiences;        // learnerが処理した経験数
+        long long snapshots;          // 公開したスナップショット数
+        long long checkpoints;        // 保存できたチェックポイント数
+        long long failed_checkpoints; // save_model()が失敗したチェックポイント数
+        long long queue_full_waits;   // キュー満杯でactorが待った回数
+        long long dropped_updates;    // 共有Q表が満杯で捨てたHogwild更新の数
+        long long total_score;
+        int best_chain;
+        double average_reward;        // 1エピソードあたりの平均報酬
+        int actors;
+        double elapsed_sec;
+        double experiences_per_sec;
+
+        Stats() : episodes(0), experiences(0), snapshots(0), checkpoints(0), failed_checkpoints(0), queue_full_waits(0),
+                  dropped_updates(0), total_score(0), best_chain(0), average_reward(0.0), actors(0),
+                  elapsed_sec(0.0), experiences_per_sec(0.0) {}
+    };
+
+    // learnerがactorへ公開する線形モデル（linearバックエンド時、tabularでは重み0）とε
+    // Q表は毎回写さず、前回の公開から更新した行だけを共有Q表へ書き込む
+    struct Snapshot {
+        LinearValueModel model;
+        double epsilon;
+
+        explicit Snapshot(const RLPlayerAI& learner);
+    };
+
+    // aiを学習させる（aiのQ表・リプレイ・εが更新される）
+    static Stats train(RLPlayerAI& ai, const Options& options = Options());
+};
+
+} // namespace ai
+} // namespace puyo
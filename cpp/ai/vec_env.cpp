@@ -0,0 +1,230 @@
+#include "vec_env.h"
+#include "core/garbage_system.h"
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+namespace puyo {
+namespace ai {
+
+VecEnv::VecEnv(const Config& config)
+    : config_(config), total_steps_(0), total_episodes_(0) {
+    config_.num_envs = std::max(1, config_.num_envs);
+    config_.max_turns = std::max(1, config_.max_turns);
+
+    games_.reserve(config_.num_envs);
+    for (int i = 0; i < config_.num_envs; ++i) {
+        games_.emplace_back(config_.seed + static_cast<unsigned int>(i));
+    }
+    players_.resize(num_agents());
+    for (int i = 0; i < config_.num_envs; ++i) {
+        reset_game(i);
+    }
+
+    if (config_.threads > 1) {
+        pool_.reset(new ThreadPool(config_.threads));
+    }
+}
+
+void VecEnv::reset_game(int game) {
+    games_[game].next.initialize_next_sequence();
+    games_[game].turn = 0;
+    for (int p = 0; p < players_per_game(); ++p) {
+        players_[game * players_per_game() + p] = PlayerState();
+    }
+}
+
+void VecEnv::reset(uint8_t* observations) {
+    // ツモ列もシードから作り直す（自動リセットは同じ乱数列の続きを使う）
+    for (int i = 0; i < config_.num_envs; ++i) {
+        games_[i] = Game(config_.seed + static_cast<unsigned int>(i));
+        reset_game(i);
+    }
+    int size = observation_size();
+    for (int agent = 0; agent < num_agents(); ++agent) {
+        write_observation(agent, observations + static_cast<size_t>(agent) * size);
+    }
+}
+
+namespace {
+
+// 盤面を色番号の配列（y * FIELD_WIDTH + x）に書く（色ごとのビットボードを走査）
+void write_field(const BitField& field, uint8_t* cells) {
+    std::memset(cells, 0, VecEnv::FIELD_OBS);
+    for (int c = 1; c < COLOR_COUNT + 1; ++c) {
+        BitBoard128 bits = field.get_color_bits(static_cast<PuyoColor>(c));
+        while (bits != 0) {
+            uint64_t low = static_cast<uint64_t>(bits);
+            int index = low ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<uint64_t>(bits >> 64));
+            bits &= bits - 1;
+            int x = index / BitField::COLUMN_STRIDE;
+            int y = index % BitField::COLUMN_STRIDE;
+            if (x < FIELD_WIDTH && y < FIELD_HEIGHT) {
+                cells[y * FIELD_WIDTH + x] = static_cast<uint8_t>(c);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void VecEnv::write_observation(int agent, uint8_t* observation) const {
+    int players = players_per_game();
+    int game = agent / players;
+    const PlayerState& self = players_[agent];
+
+    write_field(self.field, observation);
+    uint8_t* pairs = observation + FIELD_OBS;
+    for (int i = 0; i < 3; ++i) {
+        PuyoPair pair = games_[game].next.get_next_pair(i);
+        pairs[i * 2] = static_cast<uint8_t>(pair.axis);
+        pairs[i * 2 + 1] = static_cast<uint8_t>(pair.child);
+    }
+    observation[FIELD_OBS + PAIR_OBS] = static_cast<uint8_t>(std::min(255, self.pending_garbage));
+    observation[FIELD_OBS + PAIR_OBS + 1] = 0;
+
+    if (config_.mode == Mode::VERSUS) {
+        const PlayerState& opponent = players_[game * players + (1 - agent % players)];
+        observation[FIELD_OBS + PAIR_OBS + 1] = static_cast<uint8_t>(std::min(255, opponent.pending_garbage));
+        write_field(opponent.field, observation + BASE_OBS);
+    }
+}
+
+void VecEnv::action_mask(uint8_t* mask) const {
+    for (int agent = 0; agent < num_agents(); ++agent) {
+        const BitField& field = players_[agent].field;
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            mask[agent * PLACEMENT_COUNT + i] = field.can_place(PLACEMENTS[i].x, PLACEMENTS[i].r) ? 1 : 0;
+        }
+    }
+}
+
+bool VecEnv::step_game(int game, const int32_t* actions, uint8_t* observations, float* rewards, bool* dones,
+                       bool* truncated, int32_t* chains) {
+    int players = players_per_game();
+    int first = game * players;
+    Game& state = games_[game];
+    PuyoPair pair = state.next.get_current_pair();
+
+    // 全員が同じツモを置く
+    int sent[2] = {0, 0};
+    bool lost[2] = {false, false};
+    bool placed[2] = {false, false};
+    BitChainResult results[2];
+    for (int p = 0; p < players; ++p) {
+        int agent = first + p;
+        PlayerState& player = players_[agent];
+        int x = actions[agent * 2];
+        int r = actions[agent * 2 + 1];
+        int chain_count = 0;
+
+        if (placement_index(x, r) >= 0 && player.field.can_place(x, r)) {
+            results[p] = player.field.place_and_simulate(x, r, pair.axis, pair.child);
+            placed[p] = true;
+            chain_count = results[p].chain_count;
+            if (!config_.reward_shaping) {
+                rewards[agent] = static_cast<float>(results[p].score * config_.score_scale);
+            }
+            if (results[p].score > 0) {
+                int total = player.accumulated_score + results[p].score;
+                sent[p] = total / GarbageSystem::GARBAGE_RATE;
+                player.accumulated_score = total % GarbageSystem::GARBAGE_RATE;
+            }
+        } else {
+            rewards[agent] = static_cast<float>(config_.invalid_action_reward);
+        }
+        if (chains) chains[agent] = chain_count;
+    }
+
+    // 相殺して相手へ送り、予告分を降らせる
+    if (players == 2) {
+        for (int p = 0; p < 2; ++p) {
+            PlayerState& player = players_[first + p];
+            int offset = std::min(sent[p], player.pending_garbage);
+            player.pending_garbage -= offset;
+            players_[first + 1 - p].pending_garbage += sent[p] - offset;
+        }
+    }
+    for (int p = 0; p < players; ++p) {
+        int agent = first + p;
+        PlayerState& player = players_[agent];
+        bool dropped = player.pending_garbage > 0;
+        if (dropped) {
+            player.field.drop_garbage(player.pending_garbage);
+            player.pending_garbage = 0;
+        }
+        if (config_.reward_shaping && (placed[p] || dropped)) {
+            // 盤面の集計は予告分が降った後に1度だけ求める（高さの項も窒息と同じく降った後の盤面で判定する）
+            // おじゃまぷよは同色の連結に数えないので、連結の増減は降る前の盤面と変わらない
+            RLFieldSummary after = RLFeatureExtractor::summarize(player.field);
+            if (placed[p]) {
+                // 窒息の報酬は下でまとめて加える
+                rewards[agent] = static_cast<float>(config_.shaper.shape(player.summary, after, results[p], false));
+            }
+            player.summary = after;
+        }
+        lost[p] = player.field.is_game_over();
+    }
+
+    state.next.advance_to_next();
+    state.turn++;
+
+    bool any_lost = lost[0] || lost[1];
+    bool time_up = !any_lost && state.turn >= config_.max_turns;
+    double game_over_reward = config_.reward_shaping ? config_.shaper.game_over_reward() : config_.game_over_reward;
+    for (int p = 0; p < players; ++p) {
+        int agent = first + p;
+        if (lost[p]) {
+            rewards[agent] += static_cast<float>(game_over_reward);
+        } else if (any_lost) {
+            rewards[agent] += static_cast<float>(config_.win_reward);
+        }
+        dones[agent] = any_lost || time_up;
+        truncated[agent] = time_up;
+    }
+
+    bool done = any_lost || time_up;
+    if (done) {
+        reset_game(game);
+    }
+    int size = observation_size();
+    for (int p = 0; p < players; ++p) {
+        write_observation(first + p, observations + static_cast<size_t>(first + p) * size);
+    }
+    return done;
+}
+
+void VecEnv::step(const int32_t* actions, uint8_t* observations, float* rewards, bool* dones, bool* truncated,
+                  int32_t* chains) {
+    auto run = [&](int begin, int end) {
+        int finished = 0;
+        for (int game = begin; game < end; ++game) {
+            if (step_game(game, actions, observations, rewards, dones, truncated, chains)) finished++;
+        }
+        return finished;
+    };
+
+    long long finished = 0;
+    if (pool_ && config_.num_envs > 1) {
+        // ゲームを連続した区間に分けて各スレッドへ（書き込み先の区間も重ならない）
+        int chunks = std::min(config_.num_envs, pool_->size());
+        std::vector<std::future<int>> futures;
+        futures.reserve(chunks);
+        for (int c = 0; c < chunks; ++c) {
+            int begin = static_cast<int>(static_cast<long long>(config_.num_envs) * c / chunks);
+            int end = static_cast<int>(static_cast<long long>(config_.num_envs) * (c + 1) / chunks);
+            futures.push_back(pool_->submit([run, begin, end]() { return run(begin, end); }));
+        }
+        for (auto& future : futures) {
+            finished += future.get();
+        }
+    } else {
+        finished = run(0, config_.num_envs);
+    }
+
+    total_steps_ += config_.num_envs;
+    total_episodes_ += finished;
+}
+
+} // namespace ai
+} // namespace puyo
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "thread_pool.h"
+#include "reward_shaper.h"
+#include "core/bit_field.h"
+#include "core/next_generator.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace puyo {
+namespace ai {
+
+// 強化学習用のベクトル化環境
+// N個の独立したゲーム（とことん、または2人対戦）をビットボード上で描画なしに進める。
+// step()は全エージェントの行動をまとめて受け取り、観測・報酬・終了フラグを
+// 呼び出し側の確保したバッファへ書き込む（Pythonバインディングではnumpy配列をそのまま渡す）。
+// 終了したゲームはその場でリセットし、観測には新しいゲームの最初の状態を書く。
+//
+// エージェント番号: とことんはゲームiがエージェントi、対戦はゲームiの2人がエージェント2i, 2i+1。
+// 対戦は両者が同時に1手ずつ置く（同じツモ列）。連鎖の得点は70点で1個のおじゃまぷよになり、
+// まず自分の予告分と相殺して残りを相手に送る。予告分は各手の後に全て降る。
+// reward_shapingを有効にすると、報酬はRewardShaper（rl_player.yamlのrewards）で整形する。
+// 整形に使う盤面の集計は手ごとに1度だけ（予告分が降った後に）求め、次の手の「前」として持ち越す。
+// 高さの項（high_field）も窒息と同じく予告分が降った後の盤面で判定する。
+//
+// 観測（uint8、エージェントごとにobservation_size()バイト）:
+//   [0, 84)    自分の盤面（y * FIELD_WIDTH + x、0=空 1〜5=色 6=おじゃま）
+//   [84, 90)   現在・ネクスト・ネクネクの(軸, 子)の色
+//   [90]       自分への予告おじゃまぷよ（255で飽和）
+//   [91]       相手への予告おじゃまぷよ（とことんは0）
+//   [92, 176)  相手の盤面（対戦のみ）
+class VecEnv {
+public:
+    enum class Mode { TOKOTON, VERSUS };
+
+    static constexpr int FIELD_OBS = FIELD_WIDTH * FIELD_HEIGHT;
+    static constexpr int PAIR_OBS = 6;
+    static constexpr int BASE_OBS = FIELD_OBS + PAIR_OBS + 2;
+
+    struct Config {
+        int num_envs;
+        Mode mode;
+        unsigned int seed;            // ゲームiのツモはseed + iから
+        int max_turns;                // 1ゲームの最大手数（到達したらtruncated）
+        int threads;                  // step()を分担するスレッド数（1以下なら呼び出しスレッドのみ）
+        double score_scale;           // 報酬 = 得点 × score_scale
+        double game_over_reward;      // 窒息した側の報酬
+        double win_reward;            // 対戦で相手が窒息したときの報酬
+        double invalid_action_reward; // 置けない配置を選んだときの報酬（ツモは捨てる）
+        bool reward_shaping;          // trueならscore_scale / game_over_rewardの代わりにshaperで報酬を求める
+        RewardShaper shaper;
+
+        Config() : num_envs(1), mode(Mode::TOKOTON), seed(1), max_turns(1000), threads(1),
+                   score_scale(0.001), game_over_reward(-1.0), win_reward(1.0), invalid_action_reward(-0.1),
+                   reward_shaping(false) {}
+    };
+
+    explicit VecEnv(const Config& config);
+
+    int num_envs() const { return config_.num_envs; }
+    int num_agents() const { return config_.num_envs * players_per_game(); }
+    int players_per_game() const { return config_.mode == Mode::VERSUS ? 2 : 1; }
+    int observation_size() const { return config_.mode == Mode::VERSUS ? BASE_OBS + FIELD_OBS : BASE_OBS; }
+    const Config& config() const { return config_; }
+
+    // 全ゲームを最初（シード直後）の状態に戻して観測を書く（observations: num_agents × observation_size）
+    void reset(uint8_t* observations);
+
+    // 全エージェントの行動（actions: num_agents × 2の(x, r)）で1手進める
+    // rewards / dones / truncated: num_agents、chains: num_agents（この手の連鎖数、不要ならnullptr）
+    // donesはゲームが終わった（窒息・手数上限）エージェントで真、truncatedは手数上限のときだけ真
+    void step(const int32_t* actions, uint8_t* observations, float* rewards, bool* dones, bool* truncated,
+              int32_t* chains = nullptr);
+
+    // 置ける配置のマスク（mask: num_agents × PLACEMENT_COUNT、PLACEMENTSの順）
+    void action_mask(uint8_t* mask) const;
+
+    // 観測の書き出し（1エージェント分）
+    void write_observation(int agent, uint8_t* observation) const;
+
+    // 盤面・予告おじゃまぷよ（テストや盤面の設定用）
+    BitField& field(int agent) { return players_[agent].field; }
+    const BitField& field(int agent) const { return players_[agent].field; }
+    int& pending_garbage(int agent) { return players_[agent].pending_garbage; }
+    int turn(int game) const { return games_[game].turn; }
+    long long total_steps() const { return total_steps_; }
+    long long total_episodes() const { return total_episodes_; }
+
+private:
+    struct PlayerState {
+        BitField field;
+        int pending_garbage;
+        int accumulated_score;     // 70点未満の端数
+        RLFieldSummary summary;    // 報酬の整形用の盤面の集計（reward_shaping時のみ更新）
+
+        PlayerState() : pending_garbage(0), accumulated_score(0) {}
+    };
+
+    struct Game {
+        NextGenerator next;        // 対戦では2人で共有
+        int turn;
+
+        explicit Game(unsigned int seed) : next(seed), turn(0) {}
+    };
+
+    Config config_;
+    std::vector<Game> games_;
+    std::vector<PlayerState> players_;
+    std::unique_ptr<ThreadPool> pool_;
+    long long total_steps_;
+    long long total_episodes_;
+
+    void reset_game(int game);
+    // ゲーム1つを1手進める（終わったらリセットする）。終わったらtrue
+    bool step_game(int game, const int32_t* actions, uint8_t* observations, float* rewards, bool* dones,
+                   bool* truncated, int32_t* chains);
+};
+
+} // namespace ai
+} // namespace puyo
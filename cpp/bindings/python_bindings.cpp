@@ -13,15 +13,79 @@
 #include "core/chain_system.h"
 #include "core/chain_detector.h"
 #include "core/score_calculator.h"
+#include "core/cancellation.h"
 #include "ai/ai_base.h"
 #include "ai/ai_manager.h"
 #include "ai/random_ai.h"
 #include "ai/chain_search_ai.h"
 #include "ai/rl_player_ai.h"
 #include "ai/human_learning_ai.h"
+#include "ai/mcts_ai.h"
+#include "ai/ponderer.h"
+#include "ai/rl_trainer.h"
+#include "ai/vec_env.h"
+
+#include <fstream>
 
 namespace py = pybind11;
 
+namespace {
+
+// VecEnvのnumpyラッパー
+// 観測・報酬・終了フラグの配列を1度だけ確保し、step()のたびに同じ配列へ書き込んで返す
+// （呼び出し側で値を残したい場合はコピーすること）
+class PyVecEnv {
+public:
+    explicit PyVecEnv(const puyo::ai::VecEnv::Config& config)
+        : env_(config),
+          observations_({env_.num_agents(), env_.observation_size()}),
+          rewards_(env_.num_agents()),
+          dones_(env_.num_agents()),
+          truncated_(env_.num_agents()),
+          chains_(env_.num_agents()) {
+        py::gil_scoped_release release;
+        env_.reset(observations_.mutable_data());
+    }
+
+    py::array_t<uint8_t> reset() {
+        {
+            py::gil_scoped_release release;
+            env_.reset(observations_.mutable_data());
+        }
+        return observations_;
+    }
+
+    py::tuple step(py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions) {
+        if (actions.ndim() != 2 || actions.shape(0) != env_.num_agents() || actions.shape(1) != 2) {
+            throw std::invalid_argument("actions must have shape (num_agents, 2)");
+        }
+        {
+            py::gil_scoped_release release;
+            env_.step(actions.data(), observations_.mutable_data(), rewards_.mutable_data(),
+                      dones_.mutable_data(), truncated_.mutable_data(), chains_.mutable_data());
+        }
+        return py::make_tuple(observations_, rewards_, dones_, truncated_, chains_);
+    }
+
+    py::array_t<uint8_t> action_mask() const {
+        py::array_t<uint8_t> mask({env_.num_agents(), static_cast<int>(puyo::PLACEMENT_COUNT)});
+        env_.action_mask(mask.mutable_data());
+        return mask;
+    }
+
+    const puyo::ai::VecEnv& env() const { return env_; }
+
+private:
+    puyo::ai::VecEnv env_;
+    py::array_t<uint8_t> observations_;
+    py::array_t<float> rewards_;
+    py::array_t<bool> dones_;
+    py::array_t<bool> truncated_;
+    py::array_t<int32_t> chains_;
+};
+
+} // namespace
+
 PYBIND11_MODULE(puyo_ai_platform, m) {
     m.doc() = "Puyo Puyo AI Development Platform";
     
@@ -268,6 +332,13 @@ PYBIND11_MODULE(puyo_ai_platform, m) {
         .def("get_chain_info", &puyo::ChainSystem::get_chain_info)
         .def("get_score_calculator", (puyo::ScoreCalculator& (puyo::ChainSystem::*)()) &puyo::ChainSystem::get_score_calculator, py::return_value_policy::reference);
 
+    // GarbageSystem クラス
+    py::class_<puyo::GarbageSystem>(m, "GarbageSystem")
+        .def("get_pending_garbage_count", &puyo::GarbageSystem::get_pending_garbage_count)
+        .def("has_pending_garbage", &puyo::GarbageSystem::has_pending_garbage)
+        .def("get_accumulated_score", &puyo::GarbageSystem::get_accumulated_score)
+        .def("get_garbage_info", &puyo::GarbageSystem::get_garbage_info);
+
     // Player クラス
     py::class_<puyo::Player>(m, "Player")
         .def("get_id", &puyo::Player::get_id)
@@ -278,12 +349,27 @@ PYBIND11_MODULE(puyo_ai_platform, m) {
         .def("get_field", (puyo::Field& (puyo::Player::*)()) &puyo::Player::get_field, py::return_value_policy::reference)
         .def("get_next_generator", (puyo::NextGenerator& (puyo::Player::*)()) &puyo::Player::get_next_generator, py::return_value_policy::reference)
         .def("get_chain_system", (puyo::ChainSystem& (puyo::Player::*)()) &puyo::Player::get_chain_system, py::return_value_policy::reference)
+        .def("get_garbage_system", (puyo::GarbageSystem& (puyo::Player::*)()) &puyo::Player::get_garbage_system, py::return_value_policy::reference)
         .def("get_stats", &puyo::Player::get_stats, py::return_value_policy::reference)
         .def("initialize_game", &puyo::Player::initialize_game)
         .def("reset_game", &puyo::Player::reset_game)
         .def("is_game_over", &puyo::Player::is_game_over)
         .def("get_status", &puyo::Player::get_status);
     
+    // 思考の締め切り・中止要求
+    py::class_<puyo::CancellationToken>(m, "CancellationToken")
+        .def(py::init<>())
+        .def("cancel", &puyo::CancellationToken::cancel)
+        .def("is_cancelled", &puyo::CancellationToken::is_cancelled);
+
+    py::class_<puyo::Deadline>(m, "Deadline")
+        .def(py::init<>())
+        .def_static("none", &puyo::Deadline::none)
+        .def_static("after_ms", &puyo::Deadline::after_ms, py::arg("milliseconds"))
+        .def("is_set", &puyo::Deadline::is_set)
+        .def("expired", &puyo::Deadline::expired)
+        .def("remaining_ms", &puyo::Deadline::remaining_ms);
+
     // GameManager クラス
     py::class_<puyo::GameManager>(m, "GameManager")
         .def(py::init<puyo::GameMode>())
@@ -297,6 +383,7 @@ PYBIND11_MODULE(puyo_ai_platform, m) {
         .def("execute_step", &puyo::GameManager::execute_step)
         .def("execute_full_turn", &puyo::GameManager::execute_full_turn)
         .def("set_input_callback", &puyo::GameManager::set_input_callback)
+        .def("set_turn_end_callback", &puyo::GameManager::set_turn_end_callback)
         .def("get_mode", &puyo::GameManager::get_mode)
         .def("get_state", &puyo::GameManager::get_state)
         .def("get_current_step", &puyo::GameManager::get_current_step)
@@ -304,6 +391,9 @@ PYBIND11_MODULE(puyo_ai_platform, m) {
         .def("get_turn_count", &puyo::GameManager::get_turn_count)
         .def("enable_time_limit", &puyo::GameManager::enable_time_limit)
         .def("disable_time_limit", &puyo::GameManager::disable_time_limit)
+        .def("get_turn_deadline", &puyo::GameManager::get_turn_deadline, py::return_value_policy::copy)
+        .def("get_turn_token", &puyo::GameManager::get_turn_token, py::return_value_policy::copy)
+        .def("begin_turn_timer", &puyo::GameManager::begin_turn_timer)
         .def("is_game_finished", &puyo::GameManager::is_game_finished)
         .def("get_winner", &puyo::GameManager::get_winner)
         .def("get_game_status", &puyo::GameManager::get_game_status);
@@ -345,6 +435,15 @@ PYBIND11_MODULE(puyo_ai_platform, m) {
         .def_readwrite("turn_count", &puyo::ai::GameState::turn_count)
         .def_readwrite("is_versus_mode", &puyo::ai::GameState::is_versus_mode)
         .def_readwrite("current_pair", &puyo::ai::GameState::current_pair)
+        .def_property("pending_garbage",
+            [](const puyo::ai::GameState& state) { return state.garbage.pending; },
+            [](puyo::ai::GameState& state, int count) { state.garbage.pending = count; })
+        .def_property("accumulated_score",
+            [](const puyo::ai::GameState& state) { return state.garbage.accumulated_score; },
+            [](puyo::ai::GameState& state, int score) { state.garbage.accumulated_score = score; })
+        .def_property("opponent_pending_garbage",
+            [](const puyo::ai::GameState& state) { return state.garbage.opponent_pending; },
+            [](puyo::ai::GameState& state, int count) { state.garbage.opponent_pending = count; })
         .def("get_own_field", [](const puyo::ai::GameState& state) {
             return state.own_field;
         }, py::return_value_policy::reference_internal)
@@ -380,8 +479,12 @@ PYBIND11_MODULE(puyo_ai_platform, m) {
         .def("initialize", &puyo::ai::AIBase::initialize)
         .def("shutdown", &puyo::ai::AIBase::shutdown)
         .def("think", &puyo::ai::AIBase::think)
+        .def("think_until", &puyo::ai::AIBase::think_until,
+             py::arg("state"), py::arg("deadline"), py::arg("token") = puyo::CancellationToken(),
+             py::call_guard<py::gil_scoped_release>())
         .def("get_think_time_ms", &puyo::ai::AIBase::get_think_time_ms)
         .def("get_debug_info", &puyo::ai::AIBase::get_debug_info)
+        .def("clear_search_cache", &puyo::ai::AIBase::clear_search_cache)
         .def("get_type", &puyo::ai::AIBase::get_type)
         .def("get_version", &puyo::ai::AIBase::get_version);
     
@@ -389,6 +492,114 @@ PYBIND11_MODULE(puyo_ai_platform, m) {
     py::class_<puyo::ai::RandomAI, puyo::ai::AIBase>(ai_module, "RandomAI")
         .def(py::init<const puyo::ai::AIParameters&>(), py::arg("params") = puyo::ai::AIParameters{});
     
+    // Ponderer（相手の手番中の先読み）
+    py::class_<puyo::ai::Ponderer::Stats>(ai_module, "PonderStats")
+        .def_readonly("started", &puyo::ai::Ponderer::Stats::started)
+        .def_readonly("searched", &puyo::ai::Ponderer::Stats::searched)
+        .def_readonly("hits", &puyo::ai::Ponderer::Stats::hits)
+        .def_readonly("misses", &puyo::ai::Ponderer::Stats::misses)
+        .def_readonly("cancelled", &puyo::ai::Ponderer::Stats::cancelled);
+
+    py::class_<puyo::ai::Ponderer>(ai_module, "Ponderer")
+        .def(py::init<puyo::ai::AIBase&>(), py::arg("ai"), py::keep_alive<1, 2>())
+        .def("start", &puyo::ai::Ponderer::start, py::arg("upcoming"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("cancel", &puyo::ai::Ponderer::cancel, py::call_guard<py::gil_scoped_release>())
+        .def("take", [](puyo::ai::Ponderer& ponderer, const puyo::ai::GameState& actual) -> py::object {
+            puyo::ai::AIDecision decision;
+            bool found;
+            {
+                py::gil_scoped_release release;
+                found = ponderer.take(actual, decision);
+            }
+            return found ? py::cast(decision) : py::none();
+        }, py::arg("actual"))
+        .def("is_pondering", &puyo::ai::Ponderer::is_pondering)
+        .def("get_stats", &puyo::ai::Ponderer::get_stats, py::return_value_policy::copy);
+    
+    // RLPlayerAIの並列学習（actor–learner）
+    py::class_<puyo::ai::RLTrainer::Options>(ai_module, "RLTrainerOptions")
+        .def(py::init<>())
+        .def_readwrite("actors", &puyo::ai::RLTrainer::Options::actors)
+        .def_readwrite("episodes", &puyo::ai::RLTrainer::Options::episodes)
+        .def_readwrite("max_turns", &puyo::ai::RLTrainer::Options::max_turns)
+        .def_readwrite("seed", &puyo::ai::RLTrainer::Options::seed)
+        .def_readwrite("snapshot_interval", &puyo::ai::RLTrainer::Options::snapshot_interval)
+        .def_readwrite("checkpoint_interval", &puyo::ai::RLTrainer::Options::checkpoint_interval)
+        .def_readwrite("queue_capacity", &puyo::ai::RLTrainer::Options::queue_capacity)
+        .def_readwrite("hogwild", &puyo::ai::RLTrainer::Options::hogwild)
+        .def_readwrite("hogwild_capacity", &puyo::ai::RLTrainer::Options::hogwild_capacity);
+
+    py::class_<puyo::ai::RLTrainer::Stats>(ai_module, "RLTrainerStats")
+        .def_readonly("episodes", &puyo::ai::RLTrainer::Stats::episodes)
+        .def_readonly("experiences", &puyo::ai::RLTrainer::Stats::experiences)
+        .def_readonly("snapshots", &puyo::ai::RLTrainer::Stats::snapshots)
+        .def_readonly("checkpoints", &puyo::ai::RLTrainer::Stats::checkpoints)
+        .def_readonly("failed_checkpoints", &puyo::ai::RLTrainer::Stats::failed_checkpoints)
+        .def_readonly("queue_full_waits", &puyo::ai::RLTrainer::Stats::queue_full_waits)
+        .def_readonly("dropped_updates", &puyo::ai::RLTrainer::Stats::dropped_updates)
+        .def_readonly("total_score", &puyo::ai::RLTrainer::Stats::total_score)
+        .def_readonly("best_chain", &puyo::ai::RLTrainer::Stats::best_chain)
+        .def_readonly("average_reward", &puyo::ai::RLTrainer::Stats::average_reward)
+        .def_readonly("actors", &puyo::ai::RLTrainer::Stats::actors)
+        .def_readonly("elapsed_sec", &puyo::ai::RLTrainer::Stats::elapsed_sec)
+        .def_readonly("experiences_per_sec", &puyo::ai::RLTrainer::Stats::experiences_per_sec);
+
+    ai_module.def("train_rl_player", [](const puyo::ai::RLTrainer::Options& options,
+                                        const std::string& model_path, bool resume) {
+        puyo::ai::RLPlayerAI ai;
+        if (!model_path.empty()) {
+            ai.set_model_path(model_path);
+        }
+        if (resume) {
+            ai.load_model();
+        }
+        return puyo::ai::RLTrainer::train(ai, options);
+    }, py::arg("options") = puyo::ai::RLTrainer::Options(), py::arg("model_path") = "", py::arg("resume") = false,
+       py::call_guard<py::gil_scoped_release>());
+    
+    // ベクトル化環境（N個のゲームをまとめてnumpy配列で進める）
+    py::class_<PyVecEnv>(ai_module, "VecEnv")
+        .def(py::init([](int num_envs, const std::string& mode, unsigned int seed, int max_turns, int threads,
+                         double score_scale, double game_over_reward, double win_reward,
+                         double invalid_action_reward, const std::string& reward_config) {
+            puyo::ai::VecEnv::Config config;
+            if (mode == "tokoton") {
+                config.mode = puyo::ai::VecEnv::Mode::TOKOTON;
+            } else if (mode == "versus") {
+                config.mode = puyo::ai::VecEnv::Mode::VERSUS;
+            } else {
+                throw std::invalid_argument("mode must be 'tokoton' or 'versus'");
+            }
+            config.num_envs = num_envs;
+            config.seed = seed;
+            config.max_turns = max_turns;
+            config.threads = threads;
+            config.score_scale = score_scale;
+            config.game_over_reward = game_over_reward;
+            config.win_reward = win_reward;
+            config.invalid_action_reward = invalid_action_reward;
+            // 設定ファイルを渡すとrewardsセクションで報酬を整形する
+            if (!reward_config.empty()) {
+                if (!std::ifstream(reward_config).good()) {
+                    throw std::invalid_argument("reward config not found: " + reward_config);
+                }
+                config.reward_shaping = true;
+                config.shaper = puyo::ai::RewardShaper::from_file(reward_config);
+            }
+            return new PyVecEnv(config);
+        }), py::arg("num_envs") = 1, py::arg("mode") = "tokoton", py::arg("seed") = 1, py::arg("max_turns") = 1000,
+            py::arg("threads") = 1, py::arg("score_scale") = 0.001, py::arg("game_over_reward") = -1.0,
+            py::arg("win_reward") = 1.0, py::arg("invalid_action_reward") = -0.1, py::arg("reward_config") = "")
+        .def("reset", &PyVecEnv::reset)
+        .def("step", &PyVecEnv::step, py::arg("actions"))
+        .def("action_mask", &PyVecEnv::action_mask)
+        .def_property_readonly("num_envs", [](const PyVecEnv& self) { return self.env().num_envs(); })
+        .def_property_readonly("num_agents", [](const PyVecEnv& self) { return self.env().num_agents(); })
+        .def_property_readonly("observation_size", [](const PyVecEnv& self) { return self.env().observation_size(); })
+        .def_property_readonly("total_steps", [](const PyVecEnv& self) { return self.env().total_steps(); })
+        .def_property_readonly("total_episodes", [](const PyVecEnv& self) { return self.env().total_episodes(); });
+    
     // AIInfo構造体
     py::class_<puyo::ai::AIInfo>(ai_module, "AIInfo")
         .def_readwrite("name", &puyo::ai::AIInfo::name)
@@ -0,0 +1,480 @@
+#include "bit_field.h"
+#include "score_calculator.h"
+#include <algorithm>
+
+namespace puyo {
+
+namespace {
+
+// 1列分のマスク
+constexpr uint32_t COLUMN_ALL_ROWS = (1u << FIELD_HEIGHT) - 1;        // 1-14段目
+constexpr uint32_t COLUMN_GRAVITY_ROWS = (1u << (FIELD_HEIGHT - 1)) - 1; // 1-13段目（14段目は落下対象外）
+constexpr uint32_t COLUMN_CLEARABLE_ROWS = COLUMN_GRAVITY_ROWS;         // 全消し判定対象（14段目は除く）
+
+BitBoard128 make_lane_mask(uint32_t lane_bits) {
+    BitBoard128 mask = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        mask |= static_cast<BitBoard128>(lane_bits) << (x * BitField::COLUMN_STRIDE);
+    }
+    return mask;
+}
+
+const BitBoard128 FIELD_MASK = make_lane_mask(COLUMN_ALL_ROWS);
+const BitBoard128 CLEARABLE_MASK = make_lane_mask(COLUMN_CLEARABLE_ROWS);
+
+inline int popcount128(BitBoard128 board) {
+    return __builtin_popcountll(static_cast<uint64_t>(board)) +
+           __builtin_popcountll(static_cast<uint64_t>(board >> 64));
+}
+
+inline uint32_t lane(BitBoard128 board, int x) {
+    return static_cast<uint32_t>(board >> (x * BitField::COLUMN_STRIDE)) & 0xFFFFu;
+}
+
+// 上下左右に1マス広げたビットマップ
+inline BitBoard128 neighbors(BitBoard128 board) {
+    return ((board << 1) | (board >> 1) |
+            (board << BitField::COLUMN_STRIDE) | (board >> BitField::COLUMN_STRIDE)) & FIELD_MASK;
+}
+
+inline uint64_t mix64(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+std::array<Placement, PLACEMENT_COUNT> make_placements() {
+    std::array<Placement, PLACEMENT_COUNT> placements{};
+    int index = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        for (int r = 0; r < 4; ++r) {
+            if ((r == 1 && x == FIELD_WIDTH - 1) || (r == 3 && x == 0)) continue;
+            placements[index++] = Placement{x, r};
+        }
+    }
+    return placements;
+}
+
+} // namespace
+
+const std::array<Placement, PLACEMENT_COUNT> PLACEMENTS = make_placements();
+
+int placement_index(int x, int r) {
+    static const std::array<int, FIELD_WIDTH * 4> table = [] {
+        std::array<int, FIELD_WIDTH * 4> t{};
+        t.fill(-1);
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            t[PLACEMENTS[i].x * 4 + PLACEMENTS[i].r] = i;
+        }
+        return t;
+    }();
+
+    if (x < 0 || x >= FIELD_WIDTH || r < 0 || r >= 4) return -1;
+    return table[x * 4 + r];
+}
+
+BitField::BitField() : heights_{}, row14_used_(0) {
+    for (auto& bits : colors_) {
+        bits = 0;
+    }
+}
+
+BitBoard128 BitField::field_mask() {
+    return FIELD_MASK;
+}
+
+BitField BitField::from_field(const Field& field) {
+    BitField result;
+    const FieldBitBoards& bits = field.get_field_bits();
+
+    // 行優先（y * 6 + x）から列優先へ変換
+    for (int c = 0; c < COLOR_COUNT; ++c) {
+        BitBoard128 board = bits.color_bits[c];
+        while (board != 0) {
+            int index = static_cast<uint64_t>(board) != 0
+                ? __builtin_ctzll(static_cast<uint64_t>(board))
+                : 64 + __builtin_ctzll(static_cast<uint64_t>(board >> 64));
+            board &= board - 1;
+            int x = index % FIELD_WIDTH;
+            int y = index / FIELD_WIDTH;
+            set_bit(result.colors_[c], bit_index(x, y));
+        }
+    }
+
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        if (field.is_row14_used(x)) {
+            result.row14_used_ |= static_cast<uint8_t>(1u << x);
+        }
+        result.update_height(x);
+    }
+
+    return result;
+}
+
+Field BitField::to_field() const {
+    Field field;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        for (int y = 0; y < FIELD_HEIGHT; ++y) {
+            PuyoColor color = get_puyo(x, y);
+            if (color != PuyoColor::EMPTY) {
+                field.set_puyo(Position(x, y), color);
+            }
+        }
+        if ((row14_used_ >> x) & 1) {
+            field.mark_row14_used(x);
+        }
+    }
+    return field;
+}
+
+PuyoColor BitField::get_puyo(int x, int y) const {
+    if (x < 0 || x >= FIELD_WIDTH || y < 0 || y >= FIELD_HEIGHT) return PuyoColor::EMPTY;
+
+    int index = bit_index(x, y);
+    for (int c = 0; c < COLOR_COUNT; ++c) {
+        if (get_bit(colors_[c], index)) {
+            return static_cast<PuyoColor>(c + 1);
+        }
+    }
+    return PuyoColor::EMPTY;
+}
+
+void BitField::set_puyo(int x, int y, PuyoColor color) {
+    if (x < 0 || x >= FIELD_WIDTH || y < 0 || y >= FIELD_HEIGHT) return;
+
+    int index = bit_index(x, y);
+    for (auto& bits : colors_) {
+        clear_bit(bits, index);
+    }
+    if (color != PuyoColor::EMPTY && static_cast<int>(color) <= COLOR_COUNT) {
+        set_bit(colors_[static_cast<int>(color) - 1], index);
+    }
+    update_height(x);
+}
+
+void BitField::update_height(int x) {
+    uint32_t occupied = lane(get_occupied_bits(), x) & COLUMN_ALL_ROWS;
+    // 下から連続して埋まっている段数 = 反転後の末尾0の数
+    heights_[x] = static_cast<uint8_t>(__builtin_ctz(~occupied));
+}
+
+bool BitField::can_place(int x, int r) const {
+    if (x < 0 || x >= FIELD_WIDTH || r < 0 || r >= 4) return false;
+
+    // Field::can_placeと同一の判定（高さ・14段目情報のみを使用）
+    static const int dx[4] = {0, 1, 0, -1};
+    if (heights_[x] + (r == 2) > 12) return false;
+    int child_x = x + dx[r];
+    if (child_x < 0 || child_x >= FIELD_WIDTH) return false;
+    int child_y = heights_[child_x] + (r == 0);
+    if (child_y == 13 && ((row14_used_ >> child_x) & 1)) return false;
+
+    static const int check[6][4] = {
+        {1, 0, -1, -1}, {1, -1, -1, -1}, {-1, -1, -1, -1}, {3, -1, -1, -1}, {3, 4, -1, -1}, {3, 4, 5, -1}
+    };
+    static const int check_12[6][6] = {
+        {1, 2, 3, 4, 5, -1}, {2, 3, 4, 5, -1, -1}, {-1, -1, -1, -1, -1, -1}, {2, 1, 0, -1, -1, -1}, {3, 2, 1, 0, -1, -1}, {4, 3, 2, 1, 0, -1}
+    };
+    int check_x = x;
+    if (r == 1 && x >= 2) check_x += 1;
+    else if (r == 3 && x <= 2) check_x -= 1;
+    int height_12_idx = -1;
+    for (int i = 0; check[check_x][i] != -1; ++i) {
+        if (heights_[check[check_x][i]] > 12) return false;
+        if (heights_[check[check_x][i]] == 12 && height_12_idx == -1) height_12_idx = check[check_x][i];
+    }
+    if (height_12_idx == -1) return true;
+    if (heights_[1] > 11 && heights_[3] > 11) return true;
+    for (int i = 0; check_12[height_12_idx][i] != -1; ++i) {
+        if (heights_[check_12[height_12_idx][i]] > 11) break;
+        if (heights_[check_12[height_12_idx][i]] == 11) return true;
+    }
+    return false;
+}
+
+bool BitField::place_pair(int x, int r, PuyoColor axis, PuyoColor child) {
+    if (!can_place(x, r)) {
+        return false;
+    }
+
+    // 着地位置に配置（14段目を超えたぷよは消滅、14段目に置いたら使用済み）
+    auto drop = [this](int column, int y, PuyoColor color) {
+        if (y >= FIELD_HEIGHT || color == PuyoColor::EMPTY) return;
+        set_bit(colors_[static_cast<int>(color) - 1], bit_index(column, y));
+        if (y == FIELD_HEIGHT - 1) {
+            row14_used_ |= static_cast<uint8_t>(1u << column);
+        }
+    };
+
+    int axis_y = heights_[x];
+    switch (r) {
+        case 0:  // UP
+            drop(x, axis_y, axis);
+            drop(x, axis_y + 1, child);
+            break;
+        case 2:  // DOWN
+            drop(x, axis_y, child);
+            drop(x, axis_y + 1, axis);
+            break;
+        default: {  // RIGHT / LEFT
+            int child_x = (r == 1) ? x + 1 : x - 1;
+            drop(x, axis_y, axis);
+            drop(child_x, heights_[child_x], child);
+            update_height(child_x);
+            break;
+        }
+    }
+    update_height(x);
+
+    return true;
+}
+
+BitBoard128 BitField::expand(BitBoard128 seed, BitBoard128 region) {
+    BitBoard128 group = seed;
+    while (true) {
+        BitBoard128 next = (group | neighbors(group)) & region;
+        if (next == group) return group;
+        group = next;
+    }
+}
+
+bool BitField::clear_step(int chain_level, BitChainResult& result) {
+    BitBoard128 cleared = 0;
+    int total_cleared = 0;
+    int max_group_size = 0;
+    int color_count = 0;
+
+    // おじゃまぷよ以外の各色で4個以上の連結を探索
+    for (int c = 0; c < COLOR_COUNT; ++c) {
+        if (c + 1 == static_cast<int>(PuyoColor::GARBAGE)) continue;
+
+        BitBoard128 board = colors_[c];
+        if (popcount128(board) < 4) continue;
+
+        bool color_cleared = false;
+        BitBoard128 rest = board;
+        while (rest != 0) {
+            BitBoard128 seed = rest & (~rest + 1);
+            BitBoard128 group = expand(seed, board);
+            rest &= ~group;
+
+            int size = popcount128(group);
+            if (size >= 4) {
+                cleared |= group;
+                total_cleared += size;
+                max_group_size = std::max(max_group_size, size);
+                color_cleared = true;
+            }
+        }
+        if (color_cleared) color_count++;
+    }
+
+    if (cleared == 0) {
+        return false;
+    }
+
+    // 隣接するおじゃまぷよを巻き込み消去
+    int garbage_index = static_cast<int>(PuyoColor::GARBAGE) - 1;
+    BitBoard128 removed = cleared | (neighbors(cleared) & colors_[garbage_index]);
+    for (auto& bits : colors_) {
+        bits &= ~removed;
+    }
+
+    result.score += ScoreCalculator::calculate_step_score(chain_level, total_cleared,
+                                                          max_group_size, color_count);
+    result.cleared += total_cleared;
+
+    // 消去のあった列にのみ落下処理
+    uint8_t column_mask = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        if (lane(removed, x) != 0) {
+            column_mask |= static_cast<uint8_t>(1u << x);
+        }
+    }
+    apply_gravity(column_mask);
+
+    return true;
+}
+
+void BitField::apply_gravity(uint8_t column_mask) {
+    BitBoard128 occupied_all = get_occupied_bits();
+
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        if (!((column_mask >> x) & 1)) continue;
+
+        uint32_t occupied = lane(occupied_all, x) & COLUMN_GRAVITY_ROWS;
+
+        // 既に下詰めされている列はスキップ
+        if ((occupied & (occupied + 1)) == 0) {
+            update_height(x);
+            continue;
+        }
+
+        int shift = x * COLUMN_STRIDE;
+        BitBoard128 lane_clear = ~(static_cast<BitBoard128>(COLUMN_GRAVITY_ROWS) << shift);
+
+        for (auto& bits : colors_) {
+            uint32_t color_lane = lane(bits, x) & COLUMN_GRAVITY_ROWS;
+            if (color_lane == 0) continue;
+
+            // 占有ビットの順位に従って色ビットを下詰め（ソフトウェアpext）
+            uint32_t packed = 0;
+            int k = 0;
+            for (uint32_t rest = occupied; rest != 0; rest &= rest - 1, ++k) {
+                uint32_t bit = rest & (~rest + 1);
+                if (color_lane & bit) {
+                    packed |= 1u << k;
+                }
+            }
+            bits = (bits & lane_clear) | (static_cast<BitBoard128>(packed) << shift);
+        }
+
+        update_height(x);
+    }
+}
+
+BitChainResult BitField::simulate() {
+    BitChainResult result;
+
+    int chain_level = 1;
+    while (clear_step(chain_level, result)) {
+        chain_level++;
+    }
+    result.chain_count = chain_level - 1;
+
+    if (result.chain_count > 0) {
+        result.all_clear = (get_occupied_bits() & CLEARABLE_MASK) == 0;
+    }
+
+    return result;
+}
+
+BitChainResult BitField::place_and_simulate(int x, int r, PuyoColor axis, PuyoColor child) {
+    if (!place_pair(x, r, axis, child)) {
+        BitChainResult failed;
+        failed.chain_count = -1;
+        return failed;
+    }
+    return simulate();
+}
+
+bool BitField::is_game_over() const {
+    // 窒息点（3列目12段目）
+    return get_bit(get_occupied_bits(), bit_index(2, 11));
+}
+
+ChainPotential BitField::chain_potential(int max_added, int min_added) const {
+    ChainPotential best;
+
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        BitBoard128 landing = 0;
+        for (int k = 1; k <= max_added; ++k) {
+            // 14段目は消えないため、13段目までに収まる範囲のみ
+            int y = heights_[x] + k - 1;
+            if (y >= FIELD_HEIGHT - 1) break;
+            set_bit(landing, bit_index(x, y));
+            if (k < min_added) continue;
+
+            BitBoard128 adjacent = neighbors(landing);
+            for (int c = static_cast<int>(PuyoColor::RED); c < static_cast<int>(PuyoColor::GARBAGE); ++c) {
+                // 同色に接しない追加では4個以上つながらない
+                if (k < 4 && (adjacent & colors_[c - 1]) == 0) continue;
+
+                BitField trial = *this;
+                trial.colors_[c - 1] |= landing;
+                trial.update_height(x);
+                BitChainResult result = trial.simulate();
+
+                ChainPotential candidate;
+                candidate.chain_count = result.chain_count;
+                candidate.score = result.score;
+                candidate.added = k;
+                candidate.x = x;
+                candidate.color = static_cast<PuyoColor>(c);
+                if (candidate.better(best)) {
+                    best = candidate;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+int BitField::drop_garbage(int count) {
+    if (count <= 0) return 0;
+
+    // 配置開始段は盤面全体の最高段（GarbageSystem::calculate_garbage_positionsと同じ）
+    BitBoard128 occupied = get_occupied_bits();
+    std::array<int, FIELD_WIDTH> tops{};
+    int max_height = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        uint32_t column = lane(occupied, x) & COLUMN_ALL_ROWS;
+        tops[x] = column ? 32 - __builtin_clz(column) : 0;
+        max_height = std::max(max_height, tops[x]);
+    }
+
+    // 14段目には置かない
+    int full_layers = count / FIELD_WIDTH;
+    int remainder = count % FIELD_WIDTH;
+    int layers = std::max(0, std::min(full_layers, FIELD_HEIGHT - 1 - max_height));
+    bool drop_remainder = remainder > 0 && max_height + full_layers < FIELD_HEIGHT - 1;
+
+    std::array<int, FIELD_WIDTH> drops;
+    drops.fill(layers);
+    if (drop_remainder) {
+        // 低い列から、同じ高さなら3列目に近い列から
+        std::array<int, FIELD_WIDTH> order = {2, 3, 1, 4, 0, 5};
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return tops[a] < tops[b]; });
+        for (int i = 0; i < remainder; ++i) {
+            ++drops[order[i]];
+        }
+    }
+
+    int placed = 0;
+    BitBoard128& garbage = colors_[static_cast<int>(PuyoColor::GARBAGE) - 1];
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        if (drops[x] == 0) continue;
+        uint32_t bits = ((1u << drops[x]) - 1) << tops[x];
+        garbage |= static_cast<BitBoard128>(bits) << (x * COLUMN_STRIDE);
+        placed += drops[x];
+        update_height(x);
+    }
+    return placed;
+}
+
+BitBoard128 BitField::get_color_bits(PuyoColor color) const {
+    if (color == PuyoColor::EMPTY || static_cast<int>(color) > COLOR_COUNT) {
+        return 0;
+    }
+    return colors_[static_cast<int>(color) - 1];
+}
+
+BitBoard128 BitField::get_occupied_bits() const {
+    BitBoard128 occupied = 0;
+    for (const auto& bits : colors_) {
+        occupied |= bits;
+    }
+    return occupied;
+}
+
+int BitField::count_puyos() const {
+    return popcount128(get_occupied_bits());
+}
+
+int BitField::count_color(PuyoColor color) const {
+    return popcount128(get_color_bits(color));
+}
+
+uint64_t BitField::hash() const {
+    uint64_t h = mix64(0x9E3779B97F4A7C15ULL ^ row14_used_);
+    for (const auto& bits : colors_) {
+        h = mix64(h ^ static_cast<uint64_t>(bits));
+        h = mix64(h ^ static_cast<uint64_t>(bits >> 64));
+    }
+    return h;
+}
+
+} // namespace puyo
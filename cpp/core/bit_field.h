@@ -0,0 +1,142 @@
+#pragma once
+
+#include "puyo_types.h"
+#include "field.h"
+#include <array>
+#include <cstdint>
+
+namespace puyo {
+
+// 配置パターン（x, r）の総数
+// UP/DOWN: 6列ずつ、RIGHT: 0-4列、LEFT: 1-5列
+static constexpr int PLACEMENT_COUNT = 22;
+
+// 配置パターン
+struct Placement {
+    int x;  // 軸ぷよの列（0-5）
+    int r;  // 回転状態（0:UP, 1:RIGHT, 2:DOWN, 3:LEFT）
+};
+
+// 配置インデックス（0-21）→ (x, r) の変換テーブル
+// 並びは AIBase::get_all_valid_positions と同じ（x昇順、r昇順）
+extern const std::array<Placement, PLACEMENT_COUNT> PLACEMENTS;
+
+// (x, r) → 配置インデックス（不正な組み合わせは-1）
+int placement_index(int x, int r);
+
+// 高速シミュレーションの連鎖結果
+struct BitChainResult {
+    int chain_count;    // 連鎖数
+    int score;          // 連鎖得点（ScoreCalculatorと同じ計算式）
+    int cleared;        // 消去した色ぷよの総数
+    bool all_clear;     // 全消しフラグ
+
+    BitChainResult() : chain_count(0), score(0), cleared(0), all_clear(false) {}
+
+    bool has_chains() const { return chain_count > 0; }
+};
+
+// 連鎖ポテンシャル（同色ぷよを追加して発火できる最大連鎖）
+struct ChainPotential {
+    int chain_count;    // 最大連鎖数（発火不可なら0）
+    int score;          // その連鎖の得点
+    int added;          // 必要な追加ぷよ数
+    int x;              // 追加する列
+    PuyoColor color;    // 追加する色
+
+    ChainPotential() : chain_count(0), score(0), added(0), x(-1), color(PuyoColor::EMPTY) {}
+
+    // 連鎖数 > 得点 > 追加数の少なさで比較
+    bool better(const ChainPotential& other) const {
+        if (chain_count != other.chain_count) return chain_count > other.chain_count;
+        if (score != other.score) return score > other.score;
+        return chain_count > 0 && added < other.added;
+    }
+};
+
+// 探索・プレイアウト用のビットボードフィールド
+// 色ごとのビットボードを列優先レイアウト（bit = x * 16 + y）で保持し、
+// 連結判定・消去・落下を列単位のビット演算で処理する。
+// 連鎖判定・落下の仕様は Field + ChainDetector と同一（14段目は落下対象外）。
+class BitField {
+public:
+    static constexpr int COLUMN_STRIDE = 16;  // 1列あたりのビット幅
+
+    BitField();
+
+    // Fieldとの相互変換
+    static BitField from_field(const Field& field);
+    Field to_field() const;
+
+    // セル操作
+    PuyoColor get_puyo(int x, int y) const;
+    void set_puyo(int x, int y, PuyoColor color);
+
+    // 列の高さ（下から連続して埋まっている段数、Field::can_placeと同じ定義）
+    int height(int x) const { return heights_[x]; }
+
+    // 設置可能性判定（Field::can_placeと同一のアルゴリズム）
+    bool can_place(int x, int r) const;
+
+    // ぷよペアを(x, r)に落下・設置（連鎖処理は行わない）
+    bool place_pair(int x, int r, PuyoColor axis, PuyoColor child);
+
+    // 連鎖を最後まで実行
+    BitChainResult simulate();
+
+    // 設置 + 連鎖実行（設置不可の場合はchain_count=-1）
+    BitChainResult place_and_simulate(int x, int r, PuyoColor axis, PuyoColor child);
+
+    // 敗北判定（窒息点チェック）
+    bool is_game_over() const;
+
+    // 各列に同色ぷよをmin_added〜max_added個落として起こせる最大連鎖
+    // 盤面にある色のうち、落下位置に隣接する色のみ試す（連鎖数 > 得点 > 追加数の少なさで比較）
+    // 追加数を1つずつ増やして調べる場合は min_added = max_added として各段だけを試し、better()で統合する
+    ChainPotential chain_potential(int max_added = 2, int min_added = 1) const;
+
+    // 予告おじゃまぷよを降らせる（GarbageSystemのN段+r個方式、配置した個数を返す）
+    // 余りr個はランダムな列の代わりに低い列から埋める決定的な近似
+    int drop_garbage(int count);
+
+    // ビットボード取得
+    BitBoard128 get_color_bits(PuyoColor color) const;
+    BitBoard128 get_occupied_bits() const;
+
+    // 統計
+    int count_puyos() const;
+    int count_color(PuyoColor color) const;
+
+    // 局面ハッシュ（置換表・重複排除用）
+    uint64_t hash() const;
+
+    bool operator==(const BitField& other) const {
+        return colors_ == other.colors_ && row14_used_ == other.row14_used_;
+    }
+    bool operator!=(const BitField& other) const { return !(*this == other); }
+
+    // ビット位置
+    static int bit_index(int x, int y) { return x * COLUMN_STRIDE + y; }
+
+    // 盤面全体の有効ビットマスク（各列の0-13段）
+    static BitBoard128 field_mask();
+
+private:
+    std::array<BitBoard128, COLOR_COUNT> colors_;  // 色ごとのビットマップ（index = color - 1）
+    std::array<uint8_t, FIELD_WIDTH> heights_;     // 列の高さキャッシュ
+    uint8_t row14_used_;                           // 14段目使用フラグ（bit = 列）
+
+    // 指定列の高さを再計算
+    void update_height(int x);
+
+    // 1連鎖分の消去を実行し、消去があれば結果を加算
+    bool clear_step(int chain_level, BitChainResult& result);
+
+    // 指定列群に落下処理を適用
+    void apply_gravity(uint8_t column_mask);
+
+    // 連結グループ展開
+    static BitBoard128 expand(BitBoard128 seed, BitBoard128 region);
+};
+
+} // namespace puyo
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+namespace puyo {
+
+// 協調的な中止要求
+// コピーしても同じフラグを共有するため、発行側（GameManager・先読みなど）と
+// 思考側（AI）で同じトークンを持ち、発行側からcancel()する。
+class CancellationToken {
+public:
+    CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag_->store(true, std::memory_order_relaxed); }
+    bool is_cancelled() const { return flag_->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+// 思考の締め切り時刻（未設定なら無期限）
+class Deadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Deadline() : enabled_(false) {}
+
+    static Deadline none() { return Deadline(); }
+
+    static Deadline after_ms(double milliseconds) {
+        Deadline deadline;
+        deadline.enabled_ = true;
+        deadline.at_ = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::milli>(milliseconds));
+        return deadline;
+    }
+
+    bool is_set() const { return enabled_; }
+    bool expired() const { return enabled_ && Clock::now() >= at_; }
+
+    // 残り時間（未設定なら無限大、過ぎていれば0）
+    double remaining_ms() const {
+        if (!enabled_) return std::numeric_limits<double>::infinity();
+        double remaining = std::chrono::duration<double, std::milli>(at_ - Clock::now()).count();
+        return remaining > 0.0 ? remaining : 0.0;
+    }
+
+    // 早い方の締め切り
+    Deadline earlier(const Deadline& other) const {
+        if (!enabled_) return other;
+        if (!other.enabled_) return *this;
+        return at_ <= other.at_ ? *this : other;
+    }
+
+    Clock::time_point time_point() const { return enabled_ ? at_ : Clock::time_point::max(); }
+
+private:
+    bool enabled_;
+    Clock::time_point at_;
+};
+
+} // namespace puyo
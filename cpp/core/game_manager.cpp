@@ -6,7 +6,8 @@ namespace puyo {
 
 GameManager::GameManager(GameMode mode) 
     : mode_(mode), state_(GameState::WAITING), current_step_(GameStep::PUYO_SPAWN),
-      current_player_(0), turn_count_(0), time_limit_enabled_(false), time_limit_ms_(0) {}
+      current_player_(0), turn_count_(0), time_limit_enabled_(false), time_limit_ms_(0),
+      paused_remaining_ms_(-1.0) {}
 
 void GameManager::add_player(const std::string& name, PlayerType type) {
     int player_id = static_cast<int>(players_.size());
@@ -44,16 +45,24 @@ void GameManager::start_game() {
 void GameManager::pause_game() {
     if (state_ == GameState::PLAYING) {
         state_ = GameState::PAUSED;
+        paused_remaining_ms_ = turn_deadline_.is_set() ? turn_deadline_.remaining_ms() : -1.0;
+        cancel_turn();
     }
 }
 
 void GameManager::resume_game() {
     if (state_ == GameState::PAUSED) {
         state_ = GameState::PLAYING;
+        
+        // ポーズ前の思考は中止済みなので、新しいトークンと残り時間で手番を続ける
+        turn_token_ = CancellationToken();
+        turn_deadline_ = paused_remaining_ms_ >= 0.0 ? Deadline::after_ms(paused_remaining_ms_) : Deadline::none();
     }
 }
 
 void GameManager::reset_game() {
+    cancel_turn();
+    
     for (auto& player : players_) {
         player->reset_game();
     }
@@ -75,6 +84,7 @@ GameResult GameManager::finish_game() {
     }
     
     state_ = GameState::FINISHED;
+    cancel_turn();
     return result;
 }
 
@@ -204,6 +214,7 @@ bool GameManager::step_puyo_spawn() {
     PuyoPair new_pair = player->get_next_generator().get_current_pair();
     player->get_controller().set_current_pair(new_pair);
     
+    begin_turn_timer();
     current_step_ = GameStep::PLAYER_INPUT;
     return true;
 }
@@ -212,6 +223,14 @@ bool GameManager::step_player_input() {
     Player* player = get_player(current_player_);
     if (!player) return false;
     
+    // 時間切れの場合は思考を打ち切り、その場で落下させる
+    if (turn_deadline_.expired()) {
+        turn_token_.cancel();
+        player->get_controller().execute_command(MoveCommand::DROP);
+        current_step_ = GameStep::PUYO_PLACE;
+        return true;
+    }
+    
     // 入力コールバックがある場合は実行
     if (input_callback_) {
         MoveCommand command = input_callback_(current_player_);
@@ -341,11 +360,25 @@ bool GameManager::step_next_turn() {
 }
 
 void GameManager::switch_to_next_player() {
+    if (turn_end_callback_) {
+        turn_end_callback_(current_player_);
+    }
     if (players_.size() > 1) {
         current_player_ = (current_player_ + 1) % static_cast<int>(players_.size());
     }
 }
 
+void GameManager::begin_turn_timer() {
+    // 前の手番の思考が残っていれば止める
+    turn_token_.cancel();
+    turn_token_ = CancellationToken();
+    turn_deadline_ = time_limit_enabled_ ? Deadline::after_ms(time_limit_ms_) : Deadline::none();
+}
+
+void GameManager::cancel_turn() {
+    turn_token_.cancel();
+}
+
 void GameManager::check_game_over() {
     for (auto& player : players_) {
         if (player->get_field().is_game_over()) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "player.h"
+#include "cancellation.h"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -46,6 +47,10 @@ struct GameResult {
 // 入力インターフェース（将来のAI対応用）
 using InputCallback = std::function<MoveCommand(int player_id)>;
 
+// 手番終了の通知（対戦モードで手番を相手へ渡す直前に、手番を終えたプレイヤーのIDで呼ぶ）
+// NEXTは進めた後なので、そのプレイヤーの次の手番のツモが分かる（先読みの開始に使う）
+using TurnEndCallback = std::function<void(int player_id)>;
+
 class GameManager {
 private:
     GameMode mode_;
@@ -57,8 +62,14 @@ private:
     bool time_limit_enabled_;
     int time_limit_ms_;
     
+    // 現在の手番の締め切りと中止要求（入力側のAIに渡す）
+    Deadline turn_deadline_;
+    CancellationToken turn_token_;
+    double paused_remaining_ms_;    // ポーズ時点の手番の残り時間（締め切りなしなら負）
+    
     // 入力コールバック
     InputCallback input_callback_;
+    TurnEndCallback turn_end_callback_;
     
 public:
     GameManager(GameMode mode);
@@ -82,6 +93,7 @@ public:
     
     // 入力設定
     void set_input_callback(const InputCallback& callback) { input_callback_ = callback; }
+    void set_turn_end_callback(const TurnEndCallback& callback) { turn_end_callback_ = callback; }
     
     // 状態取得
     GameMode get_mode() const { return mode_; }
@@ -97,6 +109,16 @@ public:
     }
     void disable_time_limit() { time_limit_enabled_ = false; }
     
+    // 現在の手番の締め切り・中止要求
+    // 時間制限を超えると強制的に落下させ、ポーズ・リセット・終了時には中止要求を出す
+    // ポーズ中は時間を消費しない（再開時に残り時間で締め切りを設定し直し、新しい中止要求を発行する）
+    const Deadline& get_turn_deadline() const { return turn_deadline_; }
+    const CancellationToken& get_turn_token() const { return turn_token_; }
+    
+    // 手番の締め切り・中止要求を新しくする（前の手番の思考には中止要求を出す）
+    // ぷよ出現のステップで呼ばれる。ステップを使わず自前でツモを進めるループ（Python UI）は新しいツモごとに呼ぶ
+    void begin_turn_timer();
+    
     // ゲーム状態確認
     bool is_game_finished() const;
     int get_winner() const;
@@ -118,6 +140,7 @@ private:
     // ユーティリティ
     void switch_to_next_player();
     void check_game_over();
+    void cancel_turn();
 };
 
 } // namespace puyo
\ No newline at end of file
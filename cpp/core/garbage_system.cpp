@@ -32,8 +32,7 @@ int GarbageSystem::offset_garbage_with_score(int score) {
     if (score <= 0 || total_pending_ <= 0) return 0;
     
     // 得点から相殺可能なおじゃまぷよ数を計算（蓄積スコアは使わない）
-    int offset_count = score / GARBAGE_RATE;
-    int actual_offset = std::min(offset_count, total_pending_);
+    int actual_offset = calculate_offset(score, total_pending_);
     
     // 予告おじゃまぷよから相殺分を減算
     int remaining_offset = actual_offset;
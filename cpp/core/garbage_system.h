@@ -4,6 +4,7 @@
 #include "chain_system.h"
 #include <vector>
 #include <queue>
+#include <algorithm>
 
 namespace puyo {
 
@@ -34,11 +35,17 @@ private:
     int total_pending_;                        // 予告おじゃまぷよ総数
     int accumulated_score_;                    // 蓄積されたスコア（70点未満の端数）
     
+public:
     static constexpr int GARBAGE_RATE = 70;    // 70点につき1個
     
-public:
     explicit GarbageSystem(Field* field);
     
+    // 得点で相殺できるおじゃまぷよ数（蓄積スコアは使わない）
+    static int calculate_offset(int score, int pending) {
+        if (score <= 0 || pending <= 0) return 0;
+        return std::min(score / GARBAGE_RATE, pending);
+    }
+    
     // おじゃまぷよ送信計算（蓄積スコアを考慮）
     int calculate_garbage_to_send(int score);
     
@@ -99,29 +99,35 @@ int ScoreCalculator::calculate_single_chain_score(const ChainResult& chain_resul
         return 0;
     }
     
-    // 基本得点計算式: 消したぷよの個数 × (連鎖ボーナス + 連結ボーナス + 色数ボーナス) × 10
-    int chain_bonus = get_chain_bonus(chain_result.chain_level);
-    int color_bonus = get_color_bonus(chain_result.color_count);
-    
     // 連結ボーナスは各グループの最大連結数を使用
-    int max_connection_bonus = 0;
+    int max_group_size = 0;
     for (const auto& group : chain_result.groups) {
-        int connection_bonus = get_connection_bonus(group.size());
-        max_connection_bonus = std::max(max_connection_bonus, connection_bonus);
+        max_group_size = std::max(max_group_size, group.size());
     }
     
-    int total_bonus = chain_bonus + max_connection_bonus + color_bonus;
+    return calculate_step_score(chain_result.chain_level, chain_result.total_cleared,
+                                max_group_size, chain_result.color_count);
+}
+
+int ScoreCalculator::calculate_step_score(int chain_level, int total_cleared, 
+                                          int max_group_size, int color_count) {
+    // 基本得点計算式: 消したぷよの個数 × (連鎖ボーナス + 連結ボーナス + 色数ボーナス) × 10
+    int chain_bonus = get_chain_bonus(chain_level);
+    int color_bonus = get_color_bonus(color_count);
+    int connection_bonus = get_connection_bonus(max_group_size);
+    
+    int total_bonus = chain_bonus + connection_bonus + color_bonus;
     
     // ボーナス合計が0の場合の特例処理
-    if (total_bonus == 0 && chain_result.total_cleared == 4) {
+    if (total_bonus == 0 && total_cleared == 4) {
         // 1連鎖4個消しの特例：40点
         return 40;
     }
     
-    return chain_result.total_cleared * total_bonus * 10;
+    return total_cleared * total_bonus * 10;
 }
 
-int ScoreCalculator::get_chain_bonus(int chain_level) const {
+int ScoreCalculator::get_chain_bonus(int chain_level) {
     if (chain_level <= 0) {
         return 0;
     }
@@ -134,7 +140,7 @@ int ScoreCalculator::get_chain_bonus(int chain_level) const {
     return 128 + 32 * (chain_level - 7);
 }
 
-int ScoreCalculator::get_connection_bonus(int connection_count) const {
+int ScoreCalculator::get_connection_bonus(int connection_count) {
     if (connection_count == 4) return 0;
     if (connection_count == 5) return 2;
     if (connection_count == 6) return 3;
@@ -147,7 +153,7 @@ int ScoreCalculator::get_connection_bonus(int connection_count) const {
     return 0;  // 4個未満
 }
 
-int ScoreCalculator::get_color_bonus(int color_count) const {
+int ScoreCalculator::get_color_bonus(int color_count) {
     if (color_count <= 0 || color_count > static_cast<int>(COLOR_BONUS_TABLE.size())) {
         return 0;
     }
@@ -45,14 +45,18 @@ public:
     // リセット
     void reset() { pending_all_clear_bonus_ = 0; }
     
+    // 1連鎖分の得点計算（高速シミュレーション用、連結数は最大グループサイズを指定）
+    static int calculate_step_score(int chain_level, int total_cleared, 
+                                    int max_group_size, int color_count);
+    
 private:
     // 単一連鎖のスコア計算
     int calculate_single_chain_score(const ChainResult& chain_result);
     
     // 各種ボーナスの取得
-    int get_chain_bonus(int chain_level) const;
-    int get_connection_bonus(int connection_count) const;
-    int get_color_bonus(int color_count) const;
+    static int get_chain_bonus(int chain_level);
+    static int get_connection_bonus(int connection_count);
+    static int get_color_bonus(int color_count);
 };
 
 } // namespace puyo
\ No newline at end of file
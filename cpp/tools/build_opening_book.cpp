@@ -0,0 +1,274 @@
+// 初手定跡ブック構築ツール
+// 空フィールドから始まる序盤局面（色正規化済み）を全列挙し、見えているツモ3組を全探索して
+// 各局面の最善配置をOpeningBook形式のバイナリに書き出す。
+//
+// 使い方:
+//   build_opening_book [--turns N] [--colors N] [--threads N] [--output PATH]
+//     --turns   収録する手数（既定: 2）
+//     --colors  使用色数（既定: 4）
+//     --threads 並列数（既定: ハードウェア並列数）
+//     --output  出力先（既定: data/opening_book.bin）
+
+#include "ai/opening_book.h"
+#include "ai/move_ordering.h"
+#include "core/bit_field.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+namespace {
+
+using PairList = OpeningBook::PairList;
+
+// 構築設定
+struct BuildConfig {
+    int turns = 2;
+    int colors = 4;
+    int threads = 0;
+    std::string output = "data/opening_book.bin";
+};
+
+// 葉局面の評価重み
+struct LeafWeights {
+    double potential_chain = 100.0;  // 同色2個の追加で起こせる最大連鎖数
+    double potential_score = 0.01;   // その連鎖の得点
+    double connection = 8.0;         // 同色隣接数
+    double bumpiness = 3.0;          // 隣接列の高さ差
+    double choke_height = 6.0;       // 3列目の高さ
+    double fired_chain = 150.0;      // 序盤で連鎖を撃ってしまうペナルティ
+};
+
+// 探索対象の局面
+struct BookState {
+    BitField field;
+    PairList pairs;
+    int turn;
+};
+
+// 探索結果
+struct SolvedState {
+    BookState state;
+    int placement;
+    double value;
+};
+
+int popcount128(BitBoard128 board) {
+    return __builtin_popcountll(static_cast<uint64_t>(board)) +
+           __builtin_popcountll(static_cast<uint64_t>(board >> 64));
+}
+
+// 葉局面評価（連鎖ポテンシャル・形）
+double evaluate_leaf(const BitField& field, int colors, const LeafWeights& weights) {
+    if (field.is_game_over()) {
+        return -std::numeric_limits<double>::max() / 4;
+    }
+
+    // 同色2個を縦に置いたときに起こせる最大連鎖
+    int best_chain = 0;
+    int best_score = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        if (!field.can_place(x, 0)) continue;
+        for (int c = 1; c <= colors; ++c) {
+            BitField trial = field;
+            PuyoColor color = static_cast<PuyoColor>(c);
+            BitChainResult result = trial.place_and_simulate(x, 0, color, color);
+            if (result.chain_count > best_chain ||
+                (result.chain_count == best_chain && result.score > best_score)) {
+                best_chain = result.chain_count;
+                best_score = result.score;
+            }
+        }
+    }
+
+    // 同色の隣接数（上下・左右）
+    int connections = 0;
+    for (int c = 1; c <= colors; ++c) {
+        BitBoard128 bits = field.get_color_bits(static_cast<PuyoColor>(c));
+        connections += popcount128(bits & (bits >> 1));
+        connections += popcount128(bits & (bits >> BitField::COLUMN_STRIDE));
+    }
+
+    int bumpiness = 0;
+    for (int x = 0; x + 1 < FIELD_WIDTH; ++x) {
+        bumpiness += std::abs(field.height(x) - field.height(x + 1));
+    }
+
+    return best_chain * weights.potential_chain +
+           best_score * weights.potential_score +
+           connections * weights.connection -
+           bumpiness * weights.bumpiness -
+           field.height(2) * weights.choke_height;
+}
+
+// 見えているツモを全探索（結果盤面が同一の手・自殺手は除外）
+double search(const BitField& field, const PairList& pairs, size_t depth, int colors,
+              const LeafWeights& weights, MoveOrderer& orderer, int* best_placement) {
+    if (depth >= pairs.size()) {
+        return evaluate_leaf(field, colors, weights);
+    }
+
+    double best_value = -std::numeric_limits<double>::max();
+    auto candidates = orderer.generate(field, pairs[depth].first, pairs[depth].second);
+    for (const auto& candidate : candidates) {
+        double value = search(candidate.field, pairs, depth + 1, colors, weights, orderer, nullptr);
+        if (candidate.chain.has_chains()) {
+            value -= candidate.chain.chain_count * weights.fired_chain;
+        }
+        if (value > best_value) {
+            best_value = value;
+            if (best_placement) *best_placement = candidate.index;
+        }
+    }
+    return best_value;
+}
+
+// 色正規化済みのツモ列を全列挙（色番号は出現順に1から振る）
+void enumerate_pair_sequences(int colors, std::vector<int>& current, int max_used,
+                              std::vector<PairList>& out) {
+    if (current.size() == static_cast<size_t>(OpeningBook::PAIR_COUNT * 2)) {
+        PairList pairs;
+        for (size_t i = 0; i < current.size(); i += 2) {
+            pairs.emplace_back(static_cast<PuyoColor>(current[i]), static_cast<PuyoColor>(current[i + 1]));
+        }
+        out.push_back(pairs);
+        return;
+    }
+
+    int limit = std::min(colors, max_used + 1);
+    for (int c = 1; c <= limit; ++c) {
+        current.push_back(c);
+        enumerate_pair_sequences(colors, current, std::max(max_used, c), out);
+        current.pop_back();
+    }
+}
+
+// 局面群を並列に探索
+std::vector<SolvedState> solve_all(const std::vector<BookState>& states, const BuildConfig& config,
+                                   const LeafWeights& weights) {
+    std::vector<SolvedState> solved(states.size());
+    std::atomic<size_t> next_index{0};
+
+    auto worker = [&]() {
+        MoveOrderer orderer;
+
+        for (size_t i = next_index++; i < states.size(); i = next_index++) {
+            int placement = -1;
+            double value = search(states[i].field, states[i].pairs, 0, config.colors, weights, orderer, &placement);
+            solved[i] = SolvedState{states[i], placement, value};
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < config.threads; ++t) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    return solved;
+}
+
+bool parse_args(int argc, char** argv, BuildConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--turns") config.turns = std::atoi(value.c_str());
+        else if (arg == "--colors") config.colors = std::atoi(value.c_str());
+        else if (arg == "--threads") config.threads = std::atoi(value.c_str());
+        else if (arg == "--output") config.output = value;
+        else return false;
+    }
+    return config.turns >= 1 && config.colors >= 1 && config.colors <= 5;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BuildConfig config;
+    if (!parse_args(argc, argv, config)) {
+        std::cerr << "usage: build_opening_book [--turns N] [--colors N] [--threads N] [--output PATH]" << std::endl;
+        return 1;
+    }
+    if (config.threads <= 0) {
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    LeafWeights weights;
+    auto start_time = std::chrono::steady_clock::now();
+
+    // 初手局面：空フィールド + 正規化済みツモ3組
+    std::vector<PairList> sequences;
+    std::vector<int> current;
+    enumerate_pair_sequences(config.colors, current, 0, sequences);
+
+    std::vector<BookState> states;
+    for (const auto& pairs : sequences) {
+        states.push_back(BookState{BitField(), pairs, 0});
+    }
+
+    std::vector<OpeningBookEntry> entries;
+    for (int turn = 0; turn < config.turns && !states.empty(); ++turn) {
+        auto solved = solve_all(states, config, weights);
+
+        std::vector<BookState> next_states;
+        std::unordered_set<uint64_t> next_keys;
+        for (const auto& result : solved) {
+            if (result.placement < 0) continue;
+
+            OpeningBookEntry entry{};
+            entry.key = OpeningBook::make_key(result.state.field, result.state.pairs);
+            entry.placement = static_cast<uint8_t>(result.placement);
+            entry.turn = static_cast<uint8_t>(turn);
+            entry.value = static_cast<int32_t>(std::max(-1e9, std::min(1e9, result.value)));
+            entries.push_back(entry);
+
+            if (turn + 1 >= config.turns) continue;
+
+            // 定跡手を進め、新しく見えるツモの全組み合わせで次の局面を作る
+            BitField next_field = result.state.field;
+            const Placement& placement = PLACEMENTS[result.placement];
+            next_field.place_and_simulate(placement.x, placement.r,
+                                          result.state.pairs[0].first, result.state.pairs[0].second);
+            if (next_field.is_game_over()) continue;
+
+            for (int a = 1; a <= config.colors; ++a) {
+                for (int b = 1; b <= config.colors; ++b) {
+                    PairList pairs(result.state.pairs.begin() + 1, result.state.pairs.end());
+                    pairs.emplace_back(static_cast<PuyoColor>(a), static_cast<PuyoColor>(b));
+                    if (next_keys.insert(OpeningBook::make_key(next_field, pairs)).second) {
+                        next_states.push_back(BookState{next_field, pairs, turn + 1});
+                    }
+                }
+            }
+        }
+
+        std::cout << "turn " << turn + 1 << ": " << solved.size() << " positions" << std::endl;
+        states = std::move(next_states);
+    }
+
+    std::filesystem::path output_path(config.output);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+    if (!OpeningBook::write(config.output, entries, config.turns, config.colors)) {
+        std::cerr << "failed to write " << config.output << std::endl;
+        return 1;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    std::cout << "wrote " << entries.size() << " entries to " << config.output
+              << " (" << elapsed << "s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,38 @@
+// 連鎖形パターンライブラリのコンパイラ
+// テキスト形式のパターン定義を、照合用マスク表のバイナリに変換する。
+// 出力ファイルはAI設定（chain_patterns.path）で指定でき、実行中に差し替えると次の思考から反映される。
+//
+// 使い方:
+//   compile_patterns <入力.txt> <出力.bin>
+
+#include "ai/pattern_matcher.h"
+#include <iostream>
+#include <string>
+
+using namespace puyo::ai;
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: compile_patterns <input.txt> <output.bin>" << std::endl;
+        return 1;
+    }
+
+    std::vector<ChainPattern> patterns;
+    std::string error;
+    if (!PatternCompiler::load_file(argv[1], patterns, &error)) {
+        std::cerr << "error: " << error << std::endl;
+        return 1;
+    }
+
+    if (!PatternCompiler::write_binary(argv[2], patterns)) {
+        std::cerr << "failed to write " << argv[2] << std::endl;
+        return 1;
+    }
+
+    size_t groups = 0;
+    for (const auto& pattern : patterns) {
+        groups += pattern.groups.size();
+    }
+    std::cout << "compiled " << patterns.size() << " patterns (" << groups << " groups) to " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,375 @@
+// 連鎖形データセット生成ツール
+// ランダム（または連鎖を組むように選んだ）配置で盤面を作り、連鎖ポテンシャルで
+// 発火時の連鎖数・得点をラベル付けして、条件を満たす盤面をシャード単位のバイナリに書き出す。
+// 盤面は色の振り直しと左右反転で正規化したハッシュで重複排除する。
+//
+// 使い方:
+//   generate_chain_dataset [--positions N] [--shard-size N] [--threads N] [--mode random|structured]
+//                          [--min-chain N] [--min-score N] [--max-added N] [--min-pairs N] [--max-pairs N]
+//                          [--colors N] [--seed N] [--output DIR]
+//     --positions   収録する盤面数（既定: 100000）
+//     --shard-size  1シャードあたりの盤面数（既定: 50000）
+//     --threads     並列数（既定: ハードウェア並列数）。シャード内も1000盤面ずつの単位に分けて並列に生成する
+//     --mode        random: ランダム配置, structured: 候補配置から連鎖ポテンシャルが最大のものを選ぶ（既定: structured）
+//     --min-chain   収録する最小連鎖数（既定: 3）
+//     --min-score   収録する最小得点（既定: 0）
+//     --max-added   発火に使う追加ぷよ数の上限（既定: 2）
+//     --min-pairs / --max-pairs  盤面を作るツモ数の範囲（既定: 8〜24）
+//     --colors      使用色数（既定: 4）
+//     --seed        乱数シード（既定: 1）
+//     --output      出力ディレクトリ（既定: data/chain_dataset）
+//
+// 出力: <output>/shard-NNNNN.bin（ChainDataset形式）と <output>/manifest.json
+
+#include "ai/chain_dataset.h"
+#include "core/bit_field.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+namespace {
+
+// 生成設定
+struct GenerateConfig {
+    long long positions = 100000;
+    int shard_size = 50000;
+    int threads = 0;
+    bool structured = true;
+    int min_chain = 3;
+    int min_score = 0;
+    int max_added = 2;
+    int min_pairs = 8;
+    int max_pairs = 24;
+    int colors = 4;
+    uint64_t seed = 1;
+    int structured_samples = 4;   // structuredで1手ごとに比べる候補配置数
+    std::string output = "data/chain_dataset";
+};
+
+// シャードごとの統計
+struct ShardStats {
+    int index = 0;
+    std::string file;
+    int records = 0;
+    long long candidates = 0;   // 生成した盤面数
+    long long duplicates = 0;   // 重複で捨てた盤面数
+    double seconds = 0.0;
+    std::array<long long, 20> chain_histogram{};
+};
+
+// シャード内を分けた生成単位（シャード数がスレッド数より少なくても全スレッドを使う）
+constexpr int CHUNK_SIZE = 1000;
+
+// 生成単位ごとの結果（シャードの全単位が揃ったら順に連結して書き出す）
+struct ChunkResult {
+    std::vector<ChainDatasetRecord> records;
+    long long candidates = 0;
+    long long duplicates = 0;
+    std::array<long long, 20> chain_histogram{};
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point end_time;
+};
+
+// 正規化ハッシュの重複排除表（ロックを分けてスレッド間で共有）
+class DedupSet {
+public:
+    bool insert(uint64_t key) {
+        Stripe& stripe = stripes_[key % STRIPES];
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        return stripe.keys.insert(key).second;
+    }
+
+private:
+    static constexpr size_t STRIPES = 64;
+    struct Stripe {
+        std::mutex mutex;
+        std::unordered_set<uint64_t> keys;
+    };
+    std::array<Stripe, STRIPES> stripes_;
+};
+
+// 連鎖を起こさない配置でツモを1組置く（置けなければfalse）
+bool place_without_chain(BitField& field, PuyoColor axis, PuyoColor child, const GenerateConfig& config,
+                         std::mt19937_64& rng) {
+    std::array<int, PLACEMENT_COUNT> order;
+    for (int i = 0; i < PLACEMENT_COUNT; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    BitField best;
+    int best_value = -1;
+    int tried = 0;
+    int samples = config.structured ? config.structured_samples : 1;
+
+    for (int index : order) {
+        const Placement& placement = PLACEMENTS[index];
+        BitField next = field;
+        BitChainResult result = next.place_and_simulate(placement.x, placement.r, axis, child);
+        if (result.chain_count != 0 || next.is_game_over()) continue;
+
+        // structuredでは1個追加で起こせる連鎖が長い配置を選ぶ
+        int value = 0;
+        if (config.structured) {
+            ChainPotential potential = next.chain_potential(1);
+            value = potential.chain_count * 100000 + potential.score;
+        }
+        if (value > best_value) {
+            best_value = value;
+            best = next;
+        }
+        if (++tried >= samples) break;
+    }
+
+    if (best_value < 0) return false;
+    field = best;
+    return true;
+}
+
+// 盤面を1つ作る
+BitField build_field(const GenerateConfig& config, std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> pair_count(config.min_pairs, config.max_pairs);
+    std::uniform_int_distribution<int> color(1, config.colors);
+
+    BitField field;
+    int pairs = pair_count(rng);
+    for (int i = 0; i < pairs; ++i) {
+        PuyoColor axis = static_cast<PuyoColor>(color(rng));
+        PuyoColor child = static_cast<PuyoColor>(color(rng));
+        if (!place_without_chain(field, axis, child, config, rng)) break;
+    }
+    return field;
+}
+
+std::string shard_name(int index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "shard-%05d.bin", index);
+    return name;
+}
+
+// シャードの1単位分を生成する
+void generate_chunk(int shard, int chunk, int target, const GenerateConfig& config, DedupSet& dedup,
+                    ChunkResult& result) {
+    result.start_time = std::chrono::steady_clock::now();
+    std::mt19937_64 rng(config.seed * 0x9E3779B97F4A7C15ULL + (static_cast<uint64_t>(shard) << 32) +
+                        static_cast<uint64_t>(chunk));
+    result.records.reserve(target);
+
+    // 条件が厳しすぎて見つからない場合に止まらなくならないよう、候補数に上限を設ける
+    long long max_candidates = static_cast<long long>(target) * 10000;
+    while (static_cast<int>(result.records.size()) < target && result.candidates < max_candidates) {
+        BitField field = build_field(config, rng);
+        result.candidates++;
+
+        ChainPotential potential = field.chain_potential(config.max_added);
+        if (potential.chain_count < config.min_chain || potential.score < config.min_score) continue;
+        if (!dedup.insert(ChainDataset::canonical_hash(field))) {
+            result.duplicates++;
+            continue;
+        }
+
+        result.records.push_back(ChainDataset::encode(field, potential));
+        result.chain_histogram[std::min<int>(potential.chain_count, result.chain_histogram.size() - 1)]++;
+    }
+    result.end_time = std::chrono::steady_clock::now();
+}
+
+// 揃ったシャードの単位を順に連結して書き出す
+bool write_shard(int index, std::vector<ChunkResult>& chunks, const GenerateConfig& config, ShardStats& stats) {
+    stats.index = index;
+    stats.file = shard_name(index);
+
+    std::vector<ChainDatasetRecord> records;
+    auto start_time = chunks.front().start_time;
+    auto end_time = chunks.front().end_time;
+    for (ChunkResult& chunk : chunks) {
+        records.insert(records.end(), chunk.records.begin(), chunk.records.end());
+        stats.candidates += chunk.candidates;
+        stats.duplicates += chunk.duplicates;
+        for (size_t i = 0; i < stats.chain_histogram.size(); ++i) stats.chain_histogram[i] += chunk.chain_histogram[i];
+        start_time = std::min(start_time, chunk.start_time);
+        end_time = std::max(end_time, chunk.end_time);
+        std::vector<ChainDatasetRecord>().swap(chunk.records);
+    }
+
+    stats.records = static_cast<int>(records.size());
+    stats.seconds = std::chrono::duration<double>(end_time - start_time).count();
+    return ChainDataset::write_shard((std::filesystem::path(config.output) / stats.file).string(), records);
+}
+
+bool write_manifest(const GenerateConfig& config, const std::vector<ShardStats>& shards, double seconds) {
+    std::ofstream file(std::filesystem::path(config.output) / "manifest.json");
+    if (!file) return false;
+
+    long long total = 0;
+    std::array<long long, 20> histogram{};
+    for (const auto& shard : shards) {
+        total += shard.records;
+        for (size_t i = 0; i < histogram.size(); ++i) histogram[i] += shard.chain_histogram[i];
+    }
+
+    file << "{\n"
+         << "  \"format\": \"PUYOCHDS\",\n"
+         << "  \"version\": " << ChainDataset::FORMAT_VERSION << ",\n"
+         << "  \"record_size\": " << sizeof(ChainDatasetRecord) << ",\n"
+         << "  \"total_records\": " << total << ",\n"
+         << "  \"elapsed_seconds\": " << seconds << ",\n"
+         << "  \"config\": {\"mode\": \"" << (config.structured ? "structured" : "random") << "\""
+         << ", \"min_chain\": " << config.min_chain
+         << ", \"min_score\": " << config.min_score
+         << ", \"max_added\": " << config.max_added
+         << ", \"min_pairs\": " << config.min_pairs
+         << ", \"max_pairs\": " << config.max_pairs
+         << ", \"colors\": " << config.colors
+         << ", \"seed\": " << config.seed << "},\n";
+
+    file << "  \"chain_histogram\": {";
+    bool first = true;
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        if (histogram[i] == 0) continue;
+        file << (first ? "" : ", ") << "\"" << i << "\": " << histogram[i];
+        first = false;
+    }
+    file << "},\n";
+
+    file << "  \"shards\": [\n";
+    for (size_t i = 0; i < shards.size(); ++i) {
+        const auto& shard = shards[i];
+        file << "    {\"file\": \"" << shard.file << "\""
+             << ", \"records\": " << shard.records
+             << ", \"candidates\": " << shard.candidates
+             << ", \"duplicates\": " << shard.duplicates
+             << ", \"seconds\": " << shard.seconds
+             << ", \"positions_per_sec\": " << (shard.seconds > 0.0 ? shard.records / shard.seconds : 0.0)
+             << "}" << (i + 1 < shards.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+bool parse_args(int argc, char** argv, GenerateConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--positions") config.positions = std::atoll(value.c_str());
+        else if (arg == "--shard-size") config.shard_size = std::atoi(value.c_str());
+        else if (arg == "--threads") config.threads = std::atoi(value.c_str());
+        else if (arg == "--mode" && (value == "random" || value == "structured")) config.structured = value == "structured";
+        else if (arg == "--min-chain") config.min_chain = std::atoi(value.c_str());
+        else if (arg == "--min-score") config.min_score = std::atoi(value.c_str());
+        else if (arg == "--max-added") config.max_added = std::atoi(value.c_str());
+        else if (arg == "--min-pairs") config.min_pairs = std::atoi(value.c_str());
+        else if (arg == "--max-pairs") config.max_pairs = std::atoi(value.c_str());
+        else if (arg == "--colors") config.colors = std::atoi(value.c_str());
+        else if (arg == "--seed") config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--output") config.output = value;
+        else return false;
+    }
+    return config.positions >= 1 && config.shard_size >= 1 && config.min_chain >= 1 &&
+           config.max_added >= 1 && config.min_pairs >= 1 && config.max_pairs >= config.min_pairs &&
+           config.colors >= 2 && config.colors <= 5;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    GenerateConfig config;
+    if (!parse_args(argc, argv, config)) {
+        std::cerr << "usage: generate_chain_dataset [--positions N] [--shard-size N] [--threads N] "
+                     "[--mode random|structured] [--min-chain N] [--min-score N] [--max-added N] "
+                     "[--min-pairs N] [--max-pairs N] [--colors N] [--seed N] [--output DIR]" << std::endl;
+        return 1;
+    }
+    if (config.threads <= 0) {
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::filesystem::create_directories(config.output);
+
+    auto start_time = std::chrono::steady_clock::now();
+    int shard_count = static_cast<int>((config.positions + config.shard_size - 1) / config.shard_size);
+    std::vector<ShardStats> shards(shard_count);
+    DedupSet dedup;
+
+    // シャードをCHUNK_SIZEずつの単位に分け、単位ごとにスレッドへ配る
+    struct Task {
+        int shard;
+        int chunk;
+        int target;
+    };
+    std::vector<Task> tasks;
+    std::vector<std::vector<ChunkResult>> chunks(shard_count);
+    std::vector<int> targets(shard_count);
+    for (int i = 0; i < shard_count; ++i) {
+        long long remaining = config.positions - static_cast<long long>(i) * config.shard_size;
+        targets[i] = static_cast<int>(std::min<long long>(config.shard_size, remaining));
+        int chunk_count = (targets[i] + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        chunks[i].resize(chunk_count);
+        for (int c = 0; c < chunk_count; ++c) {
+            tasks.push_back({i, c, std::min(CHUNK_SIZE, targets[i] - c * CHUNK_SIZE)});
+        }
+    }
+    std::vector<std::atomic<int>> pending_chunks(shard_count);
+    for (int i = 0; i < shard_count; ++i) pending_chunks[i] = static_cast<int>(chunks[i].size());
+
+    std::atomic<size_t> next_task{0};
+    std::atomic<bool> failed{false};
+    std::mutex output_mutex;
+
+    auto worker = [&]() {
+        for (size_t t = next_task++; t < tasks.size(); t = next_task++) {
+            const Task& task = tasks[t];
+            generate_chunk(task.shard, task.chunk, task.target, config, dedup, chunks[task.shard][task.chunk]);
+
+            // シャードの最後の単位を終えたスレッドが書き出す
+            if (pending_chunks[task.shard].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+            int i = task.shard;
+            if (!write_shard(i, chunks[i], config, shards[i])) {
+                failed = true;
+            }
+
+            const ShardStats& stats = shards[i];
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << stats.file << ": " << stats.records << " positions"
+                      << " (" << stats.candidates << " candidates, " << stats.duplicates << " duplicates) "
+                      << stats.seconds << "s, "
+                      << static_cast<long long>(stats.seconds > 0.0 ? stats.records / stats.seconds : 0.0)
+                      << " positions/s" << (stats.records < targets[i] ? " (incomplete)" : "") << std::endl;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < std::min<long long>(config.threads, static_cast<long long>(tasks.size())); ++t) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    if (failed || !write_manifest(config, shards, elapsed)) {
+        std::cerr << "failed to write dataset to " << config.output << std::endl;
+        return 1;
+    }
+
+    long long total = 0;
+    for (const auto& shard : shards) total += shard.records;
+    std::cout << "wrote " << total << " positions in " << shard_count << " shards to "
+              << config.output << " (" << elapsed << "s, "
+              << static_cast<long long>(elapsed > 0.0 ? total / elapsed : 0.0) << " positions/s)"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,136 @@
+// なぞぷよソルバー
+// テキスト形式の問題（盤面 + ツモ + 条件）を読み、条件を満たす配置列を並列探索で求める。
+// --verifyを付けると、各解を通常のField/ChainSystemで再生してビットボードの結果と突き合わせる
+// （エンジンの高速経路のストレステストを兼ねる）。
+//
+// 使い方:
+//   solve_nazo [--all] [--threads N] [--max-solutions N] [--verify] (--file PATH | <盤面> <ツモ> <条件>)
+//     --all            全解を求める（既定: 配置順で最初の解）
+//                      同じ盤面・得点になる配置（同色ツモの向き違いなど）は配置順で最初の1つだけを出力する
+//     --threads        並列数（既定: ハードウェア並列数）
+//     --max-solutions  全解モードで出力する解の上限（既定: 10000）
+//     --verify         解を通常の連鎖処理で再生して検証する
+//     --file           1行1問の問題ファイル（#以降はコメント）
+//   例: solve_nazo "R5/RG4/GGB3" BR,BB chain:3
+
+#include "ai/nazo_solver.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+namespace {
+
+struct SolveConfig {
+    NazoSolver::Options options;
+    bool verify = false;
+    std::string file;
+    std::vector<std::string> puzzle_args;
+};
+
+bool parse_args(int argc, char** argv, SolveConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--all") {
+            config.options.find_all = true;
+        } else if (arg == "--verify") {
+            config.verify = true;
+        } else if (arg == "--threads" || arg == "--max-solutions" || arg == "--file") {
+            if (i + 1 >= argc) return false;
+            std::string value = argv[++i];
+            if (arg == "--threads") config.options.threads = std::atoi(value.c_str());
+            else if (arg == "--max-solutions") config.options.max_solutions = std::strtoul(value.c_str(), nullptr, 10);
+            else config.file = value;
+        } else if (arg.size() > 1 && arg[0] == '-' && arg != "-") {
+            return false;
+        } else {
+            config.puzzle_args.push_back(arg);
+        }
+    }
+    return config.file.empty() != config.puzzle_args.empty() && config.options.max_solutions > 0;
+}
+
+// 1問解いて結果を出力（検証に失敗したらfalse）
+bool solve_one(const NazoPuzzle& puzzle, const SolveConfig& config) {
+    NazoSolver::Result result = NazoSolver::solve(puzzle, config.options);
+
+    std::cout << "puzzle: " << puzzle.to_string() << std::endl;
+    bool verified = true;
+    for (size_t i = 0; i < result.solutions.size(); ++i) {
+        const NazoSolution& solution = result.solutions[i];
+        std::cout << "  " << i + 1 << ": " << NazoSolver::format_solution(solution) << std::endl;
+
+        std::string error;
+        if (config.verify && !NazoSolver::verify(puzzle, solution, &error)) {
+            std::cout << "     verify failed: " << error << std::endl;
+            verified = false;
+        }
+    }
+    if (result.solutions.empty()) {
+        std::cout << "  no solution" << std::endl;
+    }
+
+    double seconds = result.elapsed_ms / 1000.0;
+    std::cout << "  solutions=" << result.solutions.size() << (result.truncated ? " (truncated)" : "")
+              << " nodes=" << result.nodes
+              << " pruned=" << result.pruned
+              << " dead_hits=" << result.dead_hits
+              << " duplicate_moves=" << result.duplicate_moves
+              << " threads=" << result.threads
+              << " time=" << result.elapsed_ms << "ms"
+              << " (" << static_cast<long long>(seconds > 0.0 ? result.nodes / seconds : 0.0) << " nodes/s)"
+              << std::endl;
+    return verified;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SolveConfig config;
+    if (!parse_args(argc, argv, config)) {
+        std::cerr << "usage: solve_nazo [--all] [--threads N] [--max-solutions N] [--verify] "
+                     "(--file PATH | <field> <pairs> <goal>)\n"
+                     "  --all lists each distinct sequence once: placements that give the same field and "
+                     "score as an earlier sibling (e.g. flipped same-colour pairs) are merged" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> lines;
+    if (!config.file.empty()) {
+        std::ifstream input(config.file);
+        if (!input) {
+            std::cerr << "failed to open " << config.file << std::endl;
+            return 1;
+        }
+        std::string line;
+        while (std::getline(input, line)) {
+            line = line.substr(0, line.find('#'));
+            if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                lines.push_back(line);
+            }
+        }
+    } else {
+        std::string line;
+        for (const auto& arg : config.puzzle_args) {
+            line += (line.empty() ? "" : " ") + arg;
+        }
+        lines.push_back(line);
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        NazoPuzzle puzzle;
+        std::string error;
+        if (!NazoPuzzle::parse(lines[i], puzzle, &error)) {
+            std::cerr << "puzzle " << i + 1 << ": " << error << std::endl;
+            ok = false;
+            continue;
+        }
+        ok = solve_one(puzzle, config) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// RLPlayerAIの学習ツール
+// actorスレッドが描画なしの自己対戦で経験を集め、learnerがQ値を更新する（RLTrainer）。
+// --hogwildではlearnerを置かず、actorが共有Q表を直接更新する。
+// 学習パラメータ・報酬はconfig/ai_params/rl_player.yamlから読み、モデルはsave_model()の形式で保存する。
+//
+// 使い方:
+//   train_rl [--actors N] [--episodes N] [--max-turns N] [--seed N] [--snapshot-interval N]
+//            [--checkpoint-interval N] [--queue-capacity N] [--hogwild] [--hogwild-capacity N]
+//            [--model PATH] [--resume]
+//     --actors               actorスレッド数（既定: ハードウェア並列数 - 1）
+//     --episodes             学習するエピソード数（既定: 1000）
+//     --max-turns            1エピソードの最大手数（既定: 200）
+//     --seed                 乱数シード（既定: 1）
+//     --snapshot-interval    actorへQ表を公開する間隔（Q更新回数、既定: 2000）
+//     --checkpoint-interval  モデルを保存する間隔（エピソード数、既定: 0 = 終了時のみ）
+//     --queue-capacity       経験キューの容量（既定: 16384）
+//     --hogwild              actorがロックなしの共有Q表を直接更新する（learnerなし）
+//     --hogwild-capacity     共有Q表のスロット数（既定: 262144）
+//     --model                モデルの保存先（既定: rl_player.yamlのbest_model_path）
+//     --resume               保存済みのモデルから学習を再開する
+
+#include "ai/rl_trainer.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+namespace {
+
+struct TrainConfig {
+    RLTrainer::Options options;
+    std::string model_path;
+    bool resume = false;
+};
+
+bool parse_args(int argc, char** argv, TrainConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--resume") {
+            config.resume = true;
+            continue;
+        }
+        if (arg == "--hogwild") {
+            config.options.hogwild = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--actors") config.options.actors = std::atoi(value.c_str());
+        else if (arg == "--episodes") config.options.episodes = std::atoi(value.c_str());
+        else if (arg == "--max-turns") config.options.max_turns = std::atoi(value.c_str());
+        else if (arg == "--seed") config.options.seed = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (arg == "--snapshot-interval") config.options.snapshot_interval = std::atoi(value.c_str());
+        else if (arg == "--checkpoint-interval") config.options.checkpoint_interval = std::atoi(value.c_str());
+        else if (arg == "--queue-capacity") config.options.queue_capacity = std::strtoul(value.c_str(), nullptr, 10);
+        else if (arg == "--hogwild-capacity") config.options.hogwild_capacity = std::strtoul(value.c_str(), nullptr, 10);
+        else if (arg == "--model") config.model_path = value;
+        else return false;
+    }
+    return config.options.episodes >= 1 && config.options.max_turns >= 1 && config.options.queue_capacity >= 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    TrainConfig config;
+    if (!parse_args(argc, argv, config)) {
+        std::cerr << "usage: train_rl [--actors N] [--episodes N] [--max-turns N] [--seed N] "
+                     "[--snapshot-interval N] [--checkpoint-interval N] [--queue-capacity N] "
+                     "[--hogwild] [--hogwild-capacity N] [--model PATH] [--resume]" << std::endl;
+        return 1;
+    }
+
+    RLPlayerAI ai;
+    if (!config.model_path.empty()) {
+        ai.set_model_path(config.model_path);
+    }
+    if (config.resume) {
+        ai.load_model();
+        std::cout << "resumed from " << ai.get_model_path() << " (" << ai.get_q_table().size() << " states)" << std::endl;
+    }
+
+    RLTrainer::Stats stats = RLTrainer::train(ai, config.options);
+
+    std::cout << "episodes=" << stats.episodes
+              << " experiences=" << stats.experiences
+              << " actors=" << stats.actors
+              << " snapshots=" << stats.snapshots
+              << " checkpoints=" << stats.checkpoints
+              << " failed_checkpoints=" << stats.failed_checkpoints
+              << " queue_full_waits=" << stats.queue_full_waits
+              << " dropped_updates=" << stats.dropped_updates << std::endl;
+    std::cout << "average_reward=" << stats.average_reward
+              << " best_chain=" << stats.best_chain
+              << " total_score=" << stats.total_score << std::endl;
+    std::cout << "time=" << stats.elapsed_sec << "s"
+              << " (" << static_cast<long long>(stats.experiences_per_sec) << " experiences/s)" << std::endl;
+    std::cout << ai.get_debug_info() << std::endl;
+    if (stats.failed_checkpoints > 0) {
+        std::cerr << "failed to save model to " << ai.get_model_path() << std::endl;
+        return 1;
+    }
+    if (stats.checkpoints > 0) {
+        std::cout << "saved model to " << ai.get_model_path() << std::endl;
+    }
+    return 0;
+}
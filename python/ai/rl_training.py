@@ -510,6 +510,67 @@ class RLTrainer:
         return avg_reward, std_reward
 
 
+def train_native(episodes=1000, actors=0, max_turns=200, seed=1,
+                 snapshot_interval=2000, checkpoint_interval=0, model_path="", resume=False,
+                 hogwild=False):
+    """C++の並列学習ドライバ（RLTrainer）でRLPlayerAIを学習する
+    
+    actorスレッドの自己対戦とlearnerのQ更新はすべてC++側で行い、
+    モデルはRLPlayerAI::save_model()の形式で保存される。
+    hogwild=Trueならlearnerを置かず、全actorが共有Q表をロックなしで更新する。
+    """
+    options = pap.ai.RLTrainerOptions()
+    options.episodes = episodes
+    options.actors = actors
+    options.max_turns = max_turns
+    options.seed = seed
+    options.snapshot_interval = snapshot_interval
+    options.checkpoint_interval = checkpoint_interval
+    options.hogwild = hogwild
+    
+    print(f"=== RLPlayerAI 並列学習（C++） ===")
+    stats = pap.ai.train_rl_player(options, model_path=model_path, resume=resume)
+    print(f"エピソード: {stats.episodes}, 経験: {stats.experiences}, actor数: {stats.actors}")
+    print(f"平均報酬: {stats.average_reward:.2f}, 最大連鎖: {stats.best_chain}")
+    print(f"時間: {stats.elapsed_sec:.2f}s ({stats.experiences_per_sec:.0f} experiences/s)")
+    if stats.dropped_updates > 0:
+        print(f"共有Q表が満杯で捨てた更新: {stats.dropped_updates}")
+    return stats
+
+
+def benchmark_vec_env(num_envs=64, steps=1000, mode="tokoton", threads=1, seed=1, reward_config=""):
+    """C++のベクトル化環境（VecEnv）をランダムな合法手で回してスループットを測る
+    
+    観測・報酬・終了フラグはC++側が確保したnumpy配列に直接書かれ、
+    終了したゲームはstep()内で自動的にリセットされる。
+    reward_configに設定ファイルを渡すと、報酬はそのrewardsセクションでC++側が整形する。
+    """
+    env = pap.ai.VecEnv(num_envs=num_envs, mode=mode, seed=seed, threads=threads,
+                        reward_config=reward_config)
+    rng = np.random.default_rng(seed)
+    placements = np.array([(x, r) for x in range(pap.FIELD_WIDTH) for r in range(4)
+                           if not (r == 1 and x == pap.FIELD_WIDTH - 1) and not (r == 3 and x == 0)],
+                          dtype=np.int32)
+    
+    env.reset()
+    total_reward = 0.0
+    start = time.time()
+    for _ in range(steps):
+        # 置ける配置から一様に選ぶ（置けなければ0番）
+        mask = env.action_mask().astype(np.float64)
+        scores = rng.random(mask.shape) * mask
+        actions = placements[np.argmax(scores, axis=1)]
+        _, rewards, dones, truncated, chains = env.step(actions)
+        total_reward += float(rewards.sum())
+    elapsed = time.time() - start
+    
+    agent_steps = steps * env.num_agents
+    print(f"=== VecEnv ベンチマーク（{mode}, {num_envs}ゲーム, スレッド{threads}） ===")
+    print(f"ステップ: {agent_steps}, エピソード: {env.total_episodes}, 報酬合計: {total_reward:.2f}")
+    print(f"時間: {elapsed:.2f}s ({agent_steps / max(elapsed, 1e-9):.0f} steps/s)")
+    return agent_steps / max(elapsed, 1e-9)
+
+
 def main():
     """メイン訓練プログラム"""
     import argparse
@@ -519,9 +580,29 @@ def main():
     parser.add_argument('--resume', action='store_true', help='訓練を再開')
     parser.add_argument('--eval', action='store_true', help='評価のみ実行')
     parser.add_argument('--config', default='config/ai_params/rl_player.yaml', help='設定ファイル')
+    parser.add_argument('--native', action='store_true', help='C++の並列学習ドライバを使う')
+    parser.add_argument('--actors', type=int, default=0, help='actorスレッド数（--native時、0で自動）')
+    parser.add_argument('--model', default='', help='モデル保存先（--native時、既定はrl_player.yamlの設定）')
+    parser.add_argument('--hogwild', action='store_true', help='共有Q表をactorが直接更新する（--native時）')
+    parser.add_argument('--vec-env-bench', type=int, default=0, metavar='N',
+                        help='N個のゲームのVecEnvでスループットを測る（--episodesをステップ数に使う）')
+    parser.add_argument('--versus', action='store_true', help='VecEnvを対戦モードにする（--vec-env-bench時）')
+    parser.add_argument('--shaped-rewards', action='store_true',
+                        help='VecEnvの報酬を--configのrewardsセクションで整形する（--vec-env-bench時）')
     
     args = parser.parse_args()
     
+    if args.vec_env_bench > 0:
+        benchmark_vec_env(num_envs=args.vec_env_bench, steps=args.episodes,
+                          mode="versus" if args.versus else "tokoton", threads=max(1, args.actors),
+                          reward_config=args.config if args.shaped_rewards else "")
+        return
+    
+    if args.native:
+        train_native(episodes=args.episodes, actors=args.actors, model_path=args.model, resume=args.resume,
+                     hogwild=args.hogwild)
+        return
+    
     try:
         trainer = RLTrainer(args.config)
         
@@ -17,8 +17,11 @@ from python.ui.player_controller import HumanPlayerController, AIPlayerControlle
 class GameController:
     """メインゲーム制御クラス"""
     
-    def __init__(self, game_mode=pap.GameMode.TOKOTON, player_controller=None):
+    def __init__(self, game_mode=pap.GameMode.TOKOTON, player_controller=None, time_limit_ms=None):
         self.game_manager = pap.GameManager(game_mode)
+        if time_limit_ms:
+            # 1手の持ち時間（GameManagerの締め切りでAIの思考を打ち切り、時間切れなら落下させる）
+            self.game_manager.enable_time_limit(time_limit_ms)
         self.visualizer = GameVisualizer()
         self.player_controller = player_controller  # PlayerController instance
         
@@ -94,6 +97,9 @@ class GameController:
         self.current_pair = self.next_generator.get_current_pair()
         self.pair_placed = False
         
+        # 新しい手番の締め切り・中止要求（時間制限が有効ならAIの思考をここで打ち切る）
+        self.game_manager.begin_turn_timer()
+        
         # C++のPuyoControllerに現在のペアを設定
         if self.puyo_controller:
             self.puyo_controller.set_current_pair(self.current_pair)
@@ -197,6 +203,10 @@ class GameController:
                 self.next_generator.advance_to_next()
                 self._get_current_pair_from_next_generator()
             
+            # 手番の終了を通知（対戦モードでは相手の手番中に次の手番を先読みする）
+            if self.player_controller:
+                self.player_controller.on_turn_end(self._build_game_state())
+            
             if self.debug_mode:
                 print("Pair placed, generated new pair")
             
@@ -296,6 +306,12 @@ class GameController:
         if not self.player_controller or self.pair_placed:
             return
         
+        # 時間切れの場合はその場で落下させる（GameManager::step_player_inputと同じ）
+        if self.game_manager.get_turn_deadline().expired():
+            self._try_move_pair(pap.MoveCommand.DROP)
+            self.player_controller.on_pair_placed(self._build_game_state())
+            return
+        
         # ゲーム状態を構築してPlayerControllerに渡す
         game_state = self._build_game_state()
         
@@ -310,8 +326,15 @@ class GameController:
         current_player_id = self.game_manager.get_current_player()
         current_player = self.game_manager.get_player(current_player_id)
         
+        # 対戦モードでは相手プレイヤーも渡す（予告おじゃまぷよ・盤面の参照用）
+        opponent_player = None
+        if self.game_manager.get_mode() == pap.GameMode.VERSUS:
+            opponent_player = self.game_manager.get_player(1 - current_player_id)
+        
         return {
+            'game_manager': self.game_manager,   # 手番の締め切り・中止要求（AIの思考を打ち切る）
             'current_player': current_player,
+            'opponent_player': opponent_player,
             'current_pair': self.current_pair,
             'turn_count': self.turn_count,
             'pair_placed': self.pair_placed,
@@ -42,6 +42,10 @@ class PlayerController(ABC):
         """コントローラーリセット（抽象メソッド）"""
         pass
     
+    def on_turn_end(self, game_state: Dict[str, Any]) -> None:
+        """自分の手番の終了時（相手へ手番を渡す時）の処理（game_stateは次の手番の局面）"""
+        pass
+    
     def get_type(self) -> str:
         """制御タイプを返す"""
         return self.controller_type
@@ -143,7 +147,7 @@ class HumanPlayerController(PlayerController):
 class AIPlayerController(PlayerController):
     """AIプレイヤー制御クラス"""
     
-    def __init__(self, ai_instance, player_name: str = "AI"):
+    def __init__(self, ai_instance, player_name: str = "AI", ponder: bool = False):
         super().__init__(player_name, "AI")
         self.ai = ai_instance
         self.last_think_time = 0.0
@@ -152,6 +156,10 @@ class AIPlayerController(PlayerController):
         self.command_queue = []
         self.last_command = 'None'  # 最後に実行したコマンドを記録
         
+        # 相手の手番中の先読み（対戦モードのみ、ponder=Trueで有効）
+        self.ponderer = pap.ai.Ponderer(self.ai) if ponder else None
+        self.pondering = False
+        
         # AI初期化
         if hasattr(self.ai, 'initialize'):
             self.ai.initialize()
@@ -179,9 +187,16 @@ class AIPlayerController(PlayerController):
             # GameStateを構築
             ai_game_state = self._build_ai_game_state(game_state)
             
-            # AI思考実行
+            # AI思考実行（先読みの結果が使えればそれを使い、無ければGameManagerの手番の締め切り・中止要求まで思考）
             think_start_time = time.time()
-            decision = self.ai.think(ai_game_state)
+            game_manager = game_state.get('game_manager')
+            decision = self._take_pondered(ai_game_state)
+            if decision is None and game_manager is not None and hasattr(self.ai, 'think_until'):
+                decision = self.ai.think_until(ai_game_state,
+                                               game_manager.get_turn_deadline(),
+                                               game_manager.get_turn_token())
+            elif decision is None:
+                decision = self.ai.think(ai_game_state)
             think_duration = time.time() - think_start_time
             
             # 新しいAIDecision構造体に対応
@@ -241,15 +256,41 @@ class AIPlayerController(PlayerController):
     
     def on_pair_placed(self, game_state: Dict[str, Any]) -> None:
         """ぷよペア設置後の処理"""
+        # 時間切れで落下させた場合、残りのコマンドは次のツモには使えない
+        self.command_queue.clear()
         if self.debug_mode:
             print(f"AI player placed pair")
     
+    def on_turn_end(self, game_state: Dict[str, Any]) -> None:
+        """手番を相手へ渡す時に、次の手番の局面の先読みを始める"""
+        if self.ponderer is None or not game_state.get('opponent_player'):
+            return
+        self.ponderer.start(self._build_ai_game_state(game_state))
+        self.pondering = True
+    
+    def _take_pondered(self, ai_game_state):
+        """先読みを止め、実際の局面に一致する結果があれば返す（無ければNone）"""
+        if not self.pondering:
+            return None
+        self.pondering = False
+        decision = self.ponderer.take(ai_game_state)
+        if decision is not None and self.debug_mode:
+            print(f"AI ponder hit: {self.ponderer.get_stats().hits}")
+        return decision
+    
     def reset(self) -> None:
         """リセット処理"""
+        if self.ponderer is not None:
+            self.ponderer.cancel()
+            self.pondering = False
         self.pending_command = None
         self.command_queue.clear()
         self.last_think_time = 0.0
         self.last_command = 'None'
+        
+        # 前の対局の探索木などを破棄
+        if hasattr(self.ai, 'clear_search_cache'):
+            self.ai.clear_search_cache()
     
     def _build_ai_game_state(self, game_state: Dict[str, Any]):
         """GameControllerの情報からAIのGameStateを構築"""
@@ -271,12 +312,28 @@ class AIPlayerController(PlayerController):
                 ai_state.set_own_field(field)
                 if self.debug_mode:
                     print(f"AI GameState: own_field set successfully via set_own_field()")
+                
+                # 予告おじゃまぷよ（相殺判断用）
+                garbage_system = player.get_garbage_system()
+                ai_state.pending_garbage = garbage_system.get_pending_garbage_count()
+                ai_state.accumulated_score = garbage_system.get_accumulated_score()
             except Exception as e:
                 if self.debug_mode:
                     print(f"Warning: Failed to set own_field: {e}")
                     import traceback
                     traceback.print_exc()
         
+        # 対戦相手の情報（相手への予告おじゃまぷよは相手のGarbageSystemが持つ）
+        if game_state.get('opponent_player'):
+            opponent = game_state['opponent_player']
+            try:
+                ai_state.is_versus_mode = True
+                ai_state.set_opponent_field(opponent.get_field())
+                ai_state.opponent_pending_garbage = opponent.get_garbage_system().get_pending_garbage_count()
+            except Exception as e:
+                if self.debug_mode:
+                    print(f"Warning: Failed to set opponent state: {e}")
+        
         # 現在のぷよペア情報を設定
         if 'current_pair' in game_state and game_state['current_pair']:
             ai_state.current_pair = game_state['current_pair']
@@ -0,0 +1,131 @@
+#include "../cpp/ai/all_clear_finder.h"
+#include "../cpp/ai/chain_search_ai.h"
+#include "../cpp/core/bit_field.h"
+#include "../cpp/core/field.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+void test_color_pruning() {
+    std::cout << "Testing color count pruning..." << std::endl;
+
+    BitField field;
+    field.set_puyo(0, 0, PuyoColor::RED);
+    field.set_puyo(0, 1, PuyoColor::RED);
+
+    std::array<int, 5> none = {0, 0, 0, 0, 0};
+    std::array<int, 5> two_red = {2, 0, 0, 0, 0};
+    std::array<int, 5> one_blue = {0, 0, 1, 0, 0};
+
+    // 赤2個が残るため、ツモが無ければ全消し不可能
+    assert(!AllClearFinder::can_still_clear(field, none, 0));
+    assert(AllClearFinder::can_still_clear(field, none, 1));
+    assert(AllClearFinder::can_still_clear(field, two_red, 0));
+    // 青1個が加わると不足は赤2 + 青3
+    assert(!AllClearFinder::can_still_clear(field, one_blue, 2));
+    assert(AllClearFinder::can_still_clear(field, one_blue, 3));
+    assert(AllClearFinder::can_still_clear(BitField(), none, 0));
+
+    std::cout << "✅ Color count pruning test passed" << std::endl;
+}
+
+void test_visible_all_clear() {
+    std::cout << "Testing all clear within visible queue..." << std::endl;
+
+    BitField field;
+    field.set_puyo(3, 0, PuyoColor::RED);
+    field.set_puyo(3, 1, PuyoColor::RED);
+
+    AllClearFinder finder;
+    AllClearFinder::Result result = finder.find(field, {{PuyoColor::RED, PuyoColor::RED},
+                                                        {PuyoColor::BLUE, PuyoColor::GREEN}});
+    assert(result.found);
+    assert(result.clear_ply == 0);
+    assert(std::abs(result.value - 1.0) < 1e-9);
+    BitField replay = field;
+    assert(replay.place_and_simulate(result.x, result.r, PuyoColor::RED, PuyoColor::RED).all_clear);
+
+    // 置いたぷよが不足する色として残るため、色数の枝刈りで探索が終わる
+    result = finder.find(field, {{PuyoColor::BLUE, PuyoColor::GREEN}, {PuyoColor::RED, PuyoColor::RED}});
+    assert(!result.found);
+    assert(result.pruned > 0);
+    assert(!result.truncated);
+
+    std::cout << "✅ Visible all clear test passed" << std::endl;
+}
+
+void test_expectimax() {
+    std::cout << "Testing expectimax beyond visible queue..." << std::endl;
+
+    // 黄を消した後、残りの赤2個を次の未知ツモ（赤赤：1/16）で消す
+    BitField field;
+    field.set_puyo(0, 0, PuyoColor::RED);
+    field.set_puyo(0, 1, PuyoColor::RED);
+    field.set_puyo(5, 0, PuyoColor::YELLOW);
+    field.set_puyo(5, 1, PuyoColor::YELLOW);
+
+    AllClearFinder::Config config;
+    config.extra_depth = 1;
+    config.decay = 0.95;
+    AllClearFinder finder(config);
+    AllClearFinder::Result result = finder.find(field, {{PuyoColor::YELLOW, PuyoColor::YELLOW}});
+    assert(result.found);
+    assert(result.clear_ply < 0);
+    assert(std::abs(result.value - 0.95 / 16.0) < 1e-9);
+    BitField replay = field;
+    assert(replay.place_and_simulate(result.x, result.r, PuyoColor::YELLOW, PuyoColor::YELLOW).has_chains());
+
+    // 未知ツモを読まなければ全消しは見つからない
+    config.extra_depth = 0;
+    finder.set_config(config);
+    result = finder.find(field, {{PuyoColor::YELLOW, PuyoColor::YELLOW}});
+    assert(!result.found);
+
+    std::cout << "✅ Expectimax test passed" << std::endl;
+}
+
+void test_all_clear_mode() {
+    std::cout << "Testing ChainSearchAI all clear mode..." << std::endl;
+
+    Field field;
+    field.set_puyo(Position(3, 0), PuyoColor::RED);
+    field.set_puyo(Position(3, 1), PuyoColor::RED);
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::RED);
+    state.next_queue = {PuyoPair(PuyoColor::BLUE, PuyoColor::GREEN)};
+
+    AIParameters params;
+    params["all_clear.enabled"] = "true";
+    ChainSearchAI ai(params);
+    assert(ai.initialize());
+
+    AIDecision decision = ai.think(state);
+    assert(decision.reason.find("AllClear[") == 0);
+    assert(decision.x == ai.last_all_clear_result().x);
+    assert(ai.last_all_clear_result().clear_ply == 0);
+
+    // 盤面のぷよ数が上限を超えると探索しない
+    params["all_clear.max_puyos"] = "1";
+    ChainSearchAI limited(params);
+    assert(limited.initialize());
+    decision = limited.think(state);
+    assert(decision.reason.find("AllClear") == std::string::npos);
+
+    std::cout << "✅ ChainSearchAI all clear mode test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== All Clear Finder Tests ===" << std::endl;
+
+    test_color_pruning();
+    test_visible_all_clear();
+    test_expectimax();
+    test_all_clear_mode();
+
+    std::cout << "🎉 All all clear finder tests passed!" << std::endl;
+    return 0;
+}
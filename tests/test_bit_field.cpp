@@ -0,0 +1,175 @@
+#include "../cpp/core/bit_field.h"
+#include "../cpp/core/chain_system.h"
+#include "../cpp/ai/mcts_ai.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+// 重力に従ったランダムな盤面（各列の高さは0-10、色は4色 + おじゃま）
+Field make_random_field(std::mt19937& rng) {
+    Field field;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        int height = static_cast<int>(rng() % 11);
+        for (int y = 0; y < height; ++y) {
+            int c = static_cast<int>(rng() % 9);
+            PuyoColor color = c < 8 ? static_cast<PuyoColor>(1 + c % COLOR_COUNT) : PuyoColor::GARBAGE;
+            field.set_puyo(Position(x, y), color);
+        }
+    }
+    return field;
+}
+
+// 通常のFieldで(x, r)に置く（上空に置いてから落下させる）
+bool place_reference(Field& field, int x, int r, PuyoColor axis, PuyoColor child) {
+    Rotation rotation = static_cast<Rotation>(r);
+    int y = rotation == Rotation::DOWN ? 12 : 11;
+    if (!field.place_puyo_pair(PuyoPair(axis, child, Position(x, y), rotation))) {
+        return false;
+    }
+    field.apply_gravity();
+    return true;
+}
+
+void test_conversion_and_can_place() {
+    std::cout << "Testing BitField conversion and can_place..." << std::endl;
+
+    std::mt19937 rng(27);
+    for (int trial = 0; trial < 200; ++trial) {
+        Field field = make_random_field(rng);
+        BitField bit_field = BitField::from_field(field);
+
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            for (int y = 0; y < FIELD_HEIGHT; ++y) {
+                assert(bit_field.get_puyo(x, y) == field.get_puyo(Position(x, y)));
+            }
+        }
+        assert(BitField::from_field(bit_field.to_field()) == bit_field);
+
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            for (int r = 0; r < 4; ++r) {
+                assert(bit_field.can_place(x, r) == field.can_place(x, r));
+            }
+        }
+    }
+
+    std::cout << "✅ BitField conversion and can_place test passed" << std::endl;
+}
+
+void test_place_and_chain_match_field() {
+    std::cout << "Testing BitField placement and chains against Field..." << std::endl;
+
+    std::mt19937 rng(2700);
+    int chained = 0;
+    for (int trial = 0; trial < 500; ++trial) {
+        Field field = make_random_field(rng);
+        PuyoColor axis = static_cast<PuyoColor>(1 + rng() % COLOR_COUNT);
+        PuyoColor child = static_cast<PuyoColor>(1 + rng() % COLOR_COUNT);
+
+        for (const Placement& placement : PLACEMENTS) {
+            if (!field.can_place(placement.x, placement.r)) continue;
+
+            Field reference = field;
+            assert(place_reference(reference, placement.x, placement.r, axis, child));
+            BitField bit_field = BitField::from_field(field);
+            assert(bit_field.place_pair(placement.x, placement.r, axis, child));
+            assert(BitField::from_field(reference) == bit_field);
+
+            // 連鎖数・得点・連鎖後の盤面が通常の連鎖処理と一致する
+            ChainSystem chain_system(&reference);
+            ChainSystemResult expected = chain_system.execute_chains();
+            BitChainResult result = bit_field.simulate();
+            assert(result.chain_count == expected.total_chains);
+            assert(result.score == expected.score_result.total_score);
+            assert(BitField::from_field(reference) == bit_field);
+            if (result.chain_count > 0) chained++;
+
+            // place_and_simulateは設置 + simulateと同じ
+            BitField combined = BitField::from_field(field);
+            BitChainResult combined_result = combined.place_and_simulate(placement.x, placement.r, axis, child);
+            assert(combined == bit_field);
+            assert(combined_result.chain_count == result.chain_count);
+            assert(combined_result.score == result.score);
+        }
+    }
+    // 連鎖の起きる配置も十分に検査できている
+    assert(chained > 100);
+
+    // 置けない配置はchain_count=-1で盤面を変えない
+    BitField full;
+    for (int y = 0; y < FIELD_HEIGHT - 1; ++y) {
+        full.set_puyo(2, y, static_cast<PuyoColor>(1 + (y / 2) % COLOR_COUNT));
+    }
+    BitField before = full;
+    assert(full.place_and_simulate(2, 0, PuyoColor::RED, PuyoColor::RED).chain_count == -1);
+    assert(full == before);
+
+    std::cout << "✅ BitField placement and chain test passed" << std::endl;
+}
+
+// 3列目だけが高く、3列目に縦置きすると窒息する盤面
+Field make_tall_center_field() {
+    Field field;
+    for (int y = 0; y < 10; ++y) {
+        field.set_puyo(Position(2, y), static_cast<PuyoColor>(1 + (y / 2) % COLOR_COUNT));
+    }
+    return field;
+}
+
+void test_mcts_decision() {
+    std::cout << "Testing MCTS decision..." << std::endl;
+
+    AIParameters params;
+    params["think_time_limit"] = "5000";
+    params["max_iterations"] = "3000";
+    params["parallel.num_threads"] = "1";
+    params["seed"] = "27";
+    params["opening_book.enabled"] = "false";
+    MCTSAI mcts(params);
+    assert(mcts.initialize());
+
+    // 空の盤面では置ける手を返す
+    Field empty;
+    GameState state;
+    state.own_field = &empty;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::BLUE);
+    state.next_queue = {PuyoPair(PuyoColor::GREEN, PuyoColor::YELLOW)};
+    AIDecision decision = mcts.think(state);
+    assert(empty.can_place(decision.x, decision.r));
+    assert(mcts.get_last_playouts() > 0);
+
+    // 窒息する手は選ばない
+    Field field = make_tall_center_field();
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::GREEN);
+    state.next_queue = {PuyoPair(PuyoColor::BLUE, PuyoColor::YELLOW)};
+    BitField dead = BitField::from_field(field);
+    dead.place_and_simulate(2, 0, PuyoColor::RED, PuyoColor::GREEN);
+    assert(dead.is_game_over());
+    decision = mcts.think(state);
+    assert(field.can_place(decision.x, decision.r));
+    BitField after = BitField::from_field(field);
+    after.place_and_simulate(decision.x, decision.r, PuyoColor::RED, PuyoColor::GREEN);
+    assert(!after.is_game_over());
+
+    // 同じシードなら同じ手
+    MCTSAI again(params);
+    assert(again.initialize());
+    AIDecision repeated = again.think(state);
+    assert(repeated.x == decision.x && repeated.r == decision.r);
+
+    std::cout << "✅ MCTS decision test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== BitField Tests ===" << std::endl;
+
+    test_conversion_and_can_place();
+    test_place_and_chain_match_field();
+    test_mcts_decision();
+
+    std::cout << "🎉 All BitField tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "../cpp/core/cancellation.h"
+#include "../cpp/core/game_manager.h"
+#include "../cpp/ai/chain_search_ai.h"
+#include "../cpp/ai/mcts_ai.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void test_token_and_deadline() {
+    std::cout << "Testing cancellation token and deadline..." << std::endl;
+
+    // コピーしたトークンは同じフラグを共有する
+    CancellationToken token;
+    CancellationToken copy = token;
+    assert(!copy.is_cancelled());
+    token.cancel();
+    assert(copy.is_cancelled());
+
+    Deadline none = Deadline::none();
+    assert(!none.is_set());
+    assert(!none.expired());
+
+    Deadline soon = Deadline::after_ms(5);
+    Deadline later = Deadline::after_ms(1000);
+    assert(soon.is_set() && !soon.expired());
+    assert(soon.earlier(later).time_point() == soon.time_point());
+    assert(none.earlier(later).time_point() == later.time_point());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    assert(soon.expired());
+    assert(soon.remaining_ms() == 0.0);
+
+    std::cout << "✅ Cancellation token and deadline test passed" << std::endl;
+}
+
+void test_ai_deadline() {
+    std::cout << "Testing AI think with deadline..." << std::endl;
+
+    Field field;
+    field.set_puyo(Position(2, 0), PuyoColor::RED);
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::GREEN);
+    state.next_queue = {PuyoPair(PuyoColor::BLUE, PuyoColor::BLUE)};
+
+    // 自身の思考時間（1秒）より短い締め切りで打ち切り、最善手を返す
+    AIParameters params;
+    params["think_time_limit"] = "1000";
+    params["threads"] = "2";
+    MCTSAI mcts(params);
+    assert(mcts.initialize());
+
+    auto start = std::chrono::steady_clock::now();
+    AIDecision decision = mcts.think_until(state, Deadline::after_ms(30));
+    assert(elapsed_ms(start) < 500.0);
+    assert(field.can_place(decision.x, decision.r));
+
+    // 中止済みのトークンでも有効な手を返す
+    CancellationToken token;
+    token.cancel();
+    start = std::chrono::steady_clock::now();
+    decision = mcts.think_until(state, Deadline::none(), token);
+    assert(elapsed_ms(start) < 500.0);
+    assert(field.can_place(decision.x, decision.r));
+
+    ChainSearchAI chain_search;
+    assert(chain_search.initialize());
+    decision = chain_search.think_until(state, Deadline::after_ms(0), token);
+    assert(field.can_place(decision.x, decision.r));
+
+    std::cout << "✅ AI think with deadline test passed" << std::endl;
+}
+
+void test_game_manager_time_limit() {
+    std::cout << "Testing GameManager time limit..." << std::endl;
+
+    GameManager manager(GameMode::TOKOTON);
+    manager.add_player("Player", PlayerType::AI);
+    manager.enable_time_limit(1);
+    manager.start_game();
+
+    // 入力がなくても時間切れで設置まで進む
+    assert(manager.execute_step());  // ぷよ出現
+    assert(manager.get_current_step() == GameStep::PLAYER_INPUT);
+    assert(manager.get_turn_deadline().is_set());
+    CancellationToken token = manager.get_turn_token();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    assert(manager.execute_step());
+    assert(manager.get_current_step() == GameStep::PUYO_PLACE);
+    assert(token.is_cancelled());
+
+    // ポーズ中は持ち時間を消費しない（再開時に残り時間で締め切りを設定し直す）
+    manager.enable_time_limit(50);
+    do {
+        assert(manager.execute_step());
+    } while (manager.get_current_step() != GameStep::PLAYER_INPUT);
+    CancellationToken paused_token = manager.get_turn_token();
+    manager.pause_game();
+    assert(paused_token.is_cancelled());
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    manager.resume_game();
+    assert(!manager.get_turn_token().is_cancelled());
+    assert(manager.get_turn_deadline().is_set());
+    assert(!manager.get_turn_deadline().expired());
+    assert(manager.get_turn_deadline().remaining_ms() <= 50.0);
+    manager.execute_step();   // 時間内なので入力待ちのまま
+    assert(manager.get_current_step() == GameStep::PLAYER_INPUT);
+
+    // リセット時は現在の手番に中止要求を出す
+    manager.execute_step();
+    manager.execute_full_turn();
+    CancellationToken next_token = manager.get_turn_token();
+    manager.reset_game();
+    assert(next_token.is_cancelled());
+
+    std::cout << "✅ GameManager time limit test passed" << std::endl;
+}
+
+void test_game_manager_deadline_cuts_think() {
+    std::cout << "Testing GameManager deadline driving an AI..." << std::endl;
+
+    GameManager manager(GameMode::TOKOTON);
+    manager.add_player("AI", PlayerType::AI);
+    manager.enable_time_limit(30);
+    manager.start_game();
+
+    // 入力コールバックからGameManagerの締め切り・中止要求でAIを思考させる
+    // AI自身の思考時間（2秒）ではなく手番の持ち時間（30ms）で打ち切られる
+    AIParameters params;
+    params["think_time_limit"] = "2000";
+    params["threads"] = "1";
+    MCTSAI mcts(params);
+    assert(mcts.initialize());
+
+    double think_ms = -1.0;
+    AIDecision decision;
+    manager.set_input_callback([&](int player_id) {
+        Player* player = manager.get_player(player_id);
+        ai::GameState state;
+        state.own_field = &player->get_field();
+        state.current_pair = player->get_controller().get_current_pair();
+        auto start = std::chrono::steady_clock::now();
+        decision = mcts.think_until(state, manager.get_turn_deadline(), manager.get_turn_token());
+        think_ms = elapsed_ms(start);
+        return MoveCommand::DROP;
+    });
+
+    assert(manager.execute_step());  // ぷよ出現（手番の締め切りを設定）
+    assert(manager.get_current_step() == GameStep::PLAYER_INPUT);
+    assert(manager.execute_step());
+    assert(think_ms >= 0.0 && think_ms < 500.0);
+    assert(manager.get_current_step() == GameStep::PUYO_PLACE);
+    assert(manager.get_player(0)->get_field().can_place(decision.x, decision.r));
+
+    std::cout << "✅ GameManager deadline driving an AI test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Cancellation Tests ===" << std::endl;
+
+    test_token_and_deadline();
+    test_ai_deadline();
+    test_game_manager_time_limit();
+    test_game_manager_deadline_cuts_think();
+
+    std::cout << "\n🎉 All cancellation tests passed!" << std::endl;
+    return 0;
+}
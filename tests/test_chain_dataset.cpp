@@ -0,0 +1,101 @@
+#include "../cpp/ai/chain_dataset.h"
+#include "../cpp/core/bit_field.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+// 赤1個で2連鎖が発火する盤面（緑と赤の色・左右を入れ替えられるよう列を指定）
+BitField make_two_chain_field(PuyoColor outer, PuyoColor inner, bool mirror) {
+    auto column = [mirror](int x) { return mirror ? FIELD_WIDTH - 1 - x : x; };
+    BitField field;
+    for (int y = 0; y < 3; ++y) {
+        field.set_puyo(column(0), y, outer);
+        field.set_puyo(column(1), y, inner);
+    }
+    field.set_puyo(column(1), 3, outer);
+    return field;
+}
+
+void test_record_round_trip() {
+    std::cout << "Testing record encoding..." << std::endl;
+
+    BitField field = make_two_chain_field(PuyoColor::GREEN, PuyoColor::RED, false);
+    field.set_puyo(5, 0, PuyoColor::GARBAGE);
+    ChainPotential potential = field.chain_potential(2);
+    assert(potential.chain_count == 2);
+
+    ChainDatasetRecord record = ChainDataset::encode(field, potential);
+    assert(record.chain_count == 2);
+    assert(record.added == potential.added);
+    assert(record.trigger_x == potential.x);
+    assert(record.score == static_cast<uint32_t>(potential.score));
+
+    // 色は出現順に振り直される（緑→1、赤→2）
+    BitField decoded = ChainDataset::decode_field(record);
+    assert(decoded.get_puyo(0, 0) == static_cast<PuyoColor>(1));
+    assert(decoded.get_puyo(1, 0) == static_cast<PuyoColor>(2));
+    assert(decoded.get_puyo(5, 0) == PuyoColor::GARBAGE);
+    assert(record.trigger_color == 2);
+    assert(decoded.count_puyos() == field.count_puyos());
+    assert(decoded.chain_potential(2).chain_count == 2);
+
+    std::cout << "✅ Record encoding test passed" << std::endl;
+}
+
+void test_canonical_hash() {
+    std::cout << "Testing canonical hash..." << std::endl;
+
+    uint64_t base = ChainDataset::canonical_hash(make_two_chain_field(PuyoColor::GREEN, PuyoColor::RED, false));
+    assert(ChainDataset::canonical_hash(make_two_chain_field(PuyoColor::BLUE, PuyoColor::YELLOW, false)) == base);
+    assert(ChainDataset::canonical_hash(make_two_chain_field(PuyoColor::GREEN, PuyoColor::RED, true)) == base);
+    assert(ChainDataset::canonical_hash(make_two_chain_field(PuyoColor::RED, PuyoColor::GREEN, true)) == base);
+
+    BitField different = make_two_chain_field(PuyoColor::GREEN, PuyoColor::RED, false);
+    different.set_puyo(3, 0, PuyoColor::BLUE);
+    assert(ChainDataset::canonical_hash(different) != base);
+
+    std::cout << "✅ Canonical hash test passed" << std::endl;
+}
+
+void test_shard_io() {
+    std::cout << "Testing shard file I/O..." << std::endl;
+
+    std::vector<ChainDatasetRecord> records;
+    BitField field = make_two_chain_field(PuyoColor::GREEN, PuyoColor::RED, false);
+    records.push_back(ChainDataset::encode(field, field.chain_potential(1)));
+    records.push_back(ChainDataset::encode(BitField(), ChainPotential()));
+
+    std::string path = "/tmp/test_chain_dataset_shard.bin";
+    assert(ChainDataset::write_shard(path, records));
+
+    std::vector<ChainDatasetRecord> loaded;
+    assert(ChainDataset::read_shard(path, loaded));
+    assert(loaded.size() == 2);
+    assert(loaded[0].chain_count == 2);
+    assert(ChainDataset::decode_field(loaded[0]) == ChainDataset::decode_field(records[0]));
+    assert(ChainDataset::decode_field(loaded[1]).count_puyos() == 0);
+
+    // 形式不正
+    FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("not a dataset", file);
+    std::fclose(file);
+    assert(!ChainDataset::read_shard(path, loaded));
+    assert(loaded.empty());
+    std::remove(path.c_str());
+
+    std::cout << "✅ Shard file I/O test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Chain Dataset Tests ===" << std::endl;
+
+    test_record_round_trip();
+    test_canonical_hash();
+    test_shard_io();
+
+    std::cout << "🎉 All chain dataset tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "../cpp/ai/exact_solver.h"
+#include "../cpp/ai/chain_search_ai.h"
+#include "../cpp/core/bit_field.h"
+#include "../cpp/core/field.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <utility>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+// 赤1個で2連鎖が発火する盤面
+//   y3: . G
+//   y2: G R
+//   y1: G R
+//   y0: G R .  ← (2,0)に赤で発火
+Field make_two_chain_field() {
+    Field field;
+    for (int y = 0; y < 3; ++y) {
+        field.set_puyo(Position(0, y), PuyoColor::GREEN);
+        field.set_puyo(Position(1, y), PuyoColor::RED);
+    }
+    field.set_puyo(Position(1, 3), PuyoColor::GREEN);
+    return field;
+}
+
+void test_max_chain() {
+    std::cout << "Testing max chain objective..." << std::endl;
+
+    BitField root = BitField::from_field(make_two_chain_field());
+    ExactSolver::PairList pairs = {{PuyoColor::RED, PuyoColor::BLUE}, {PuyoColor::YELLOW, PuyoColor::BLUE}};
+
+    ExactSolver solver;
+    ExactSolver::Result result = solver.solve(root, pairs, ExactSolver::Objective::MAX_CHAIN);
+    assert(result.found);
+    assert(result.sequence.size() == 2);
+    assert(result.max_chain >= 2);
+    assert(result.total_score > 0);
+
+    // 得られた配置列を再生すると同じ連鎖数になる
+    BitField replay = root;
+    int replay_chain = 0;
+    for (size_t i = 0; i < result.sequence.size(); ++i) {
+        const Placement& placement = PLACEMENTS[result.sequence[i]];
+        BitChainResult chain = replay.place_and_simulate(placement.x, placement.r, pairs[i].first, pairs[i].second);
+        assert(chain.chain_count >= 0);
+        replay_chain = std::max(replay_chain, chain.chain_count);
+    }
+    assert(replay_chain == result.max_chain);
+
+    std::cout << "✅ Max chain objective test passed" << std::endl;
+}
+
+void test_deduplication() {
+    std::cout << "Testing transposition deduplication..." << std::endl;
+
+    // 同色ツモは向きを入れ替えても同じ盤面になるため、重複排除で局面数が減る
+    ExactSolver::PairList pairs = {{PuyoColor::RED, PuyoColor::RED},
+                                   {PuyoColor::BLUE, PuyoColor::BLUE},
+                                   {PuyoColor::GREEN, PuyoColor::YELLOW}};
+    ExactSolver solver;
+    ExactSolver::Result result = solver.solve(BitField(), pairs, ExactSolver::Objective::MAX_SCORE);
+    assert(result.found);
+    assert(result.sequence.size() == 3);
+    assert(result.nodes > 0);
+    assert(result.unique_nodes < result.nodes);
+    assert(result.elapsed_ms >= 0.0);
+
+    std::cout << "✅ Transposition deduplication test passed" << std::endl;
+}
+
+// 全配置列の総当たりでの最良の(最大連鎖数, 合計得点)（最大連鎖の目的関数、重複排除なし）
+void brute_force_max_chain(const BitField& field, const ExactSolver::PairList& pairs, size_t depth,
+                           int max_chain, int total_score, std::pair<int, int>& best) {
+    for (int index = 0; index < PLACEMENT_COUNT; ++index) {
+        BitField next = field;
+        BitChainResult chain = next.place_and_simulate(PLACEMENTS[index].x, PLACEMENTS[index].r,
+                                                       pairs[depth].first, pairs[depth].second);
+        if (chain.chain_count < 0 || next.is_game_over()) continue;
+        int next_chain = std::max(max_chain, chain.chain_count);
+        int next_score = total_score + chain.score;
+        if (depth + 1 < pairs.size()) {
+            brute_force_max_chain(next, pairs, depth + 1, next_chain, next_score, best);
+        } else {
+            best = std::max(best, std::make_pair(next_chain, next_score));
+        }
+    }
+}
+
+void test_transposition_tie_break() {
+    std::cout << "Testing transposition pruning with score tie-break..." << std::endl;
+
+    // 2手目までに同じ盤面へ(連鎖数が多く得点が低い)経路が先に到達し、後から(連鎖数が少なく得点が高い)経路が
+    // 到達する盤面。3手目の2連鎖で連鎖数が並ぶと得点で後者が勝つので、後者を打ち切ってはいけない
+    const char* rows[] = {
+        "...G..",
+        "...Y..",
+        ".Y.Y..",
+        ".G.R..",
+        ".YBG..",
+        ".RBR.G",
+        ".YGR.B",
+        ".RGY.Y",
+    };
+    const int height = static_cast<int>(sizeof(rows) / sizeof(rows[0]));
+    BitField root;
+    for (int i = 0; i < height; ++i) {
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            int color = static_cast<int>(std::string(".RGBY").find(rows[i][x]));
+            if (color > 0) root.set_puyo(x, height - 1 - i, static_cast<PuyoColor>(color));
+        }
+    }
+    ExactSolver::PairList pairs = {{PuyoColor::BLUE, PuyoColor::YELLOW},
+                                   {PuyoColor::YELLOW, PuyoColor::BLUE},
+                                   {PuyoColor::GREEN, PuyoColor::RED}};
+
+    std::pair<int, int> expected(0, 0);
+    brute_force_max_chain(root, pairs, 0, 0, 0, expected);
+    assert(expected.first == 2);
+
+    ExactSolver solver;
+    ExactSolver::Result result = solver.solve(root, pairs, ExactSolver::Objective::MAX_CHAIN);
+    assert(result.found);
+    assert(result.max_chain == expected.first);
+    assert(result.total_score == expected.second);
+    assert(result.unique_nodes < result.nodes);
+
+    std::cout << "✅ Transposition pruning with score tie-break test passed" << std::endl;
+}
+
+void test_all_clear() {
+    std::cout << "Testing all clear objective..." << std::endl;
+
+    Field field;
+    field.set_puyo(Position(3, 0), PuyoColor::RED);
+    field.set_puyo(Position(3, 1), PuyoColor::RED);
+    BitField root = BitField::from_field(field);
+    ExactSolver::PairList pairs = {{PuyoColor::BLUE, PuyoColor::GREEN}, {PuyoColor::RED, PuyoColor::RED}};
+
+    ExactSolver solver;
+    ExactSolver::Result result = solver.solve(root, pairs, ExactSolver::Objective::ALL_CLEAR);
+    assert(result.found);
+    assert(result.all_clear_ply < 0);  // 1手目で余計なぷよを置くため全消しできない
+
+    pairs = {{PuyoColor::RED, PuyoColor::RED}, {PuyoColor::BLUE, PuyoColor::GREEN}};
+    result = solver.solve(root, pairs, ExactSolver::Objective::ALL_CLEAR);
+    assert(result.found);
+    assert(result.all_clear_ply == 0);
+
+    assert(ExactSolver::parse_objective("all_clear") == ExactSolver::Objective::ALL_CLEAR);
+    assert(ExactSolver::parse_objective("unknown") == ExactSolver::Objective::MAX_CHAIN);
+    assert(ExactSolver::objective_name(ExactSolver::Objective::MAX_SCORE) == "max_score");
+
+    std::cout << "✅ All clear objective test passed" << std::endl;
+}
+
+void test_solver_mode() {
+    std::cout << "Testing ChainSearchAI solver mode..." << std::endl;
+
+    Field field = make_two_chain_field();
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::BLUE);
+    state.next_queue = {PuyoPair(PuyoColor::YELLOW, PuyoColor::BLUE),
+                        PuyoPair(PuyoColor::GREEN, PuyoColor::YELLOW)};
+
+    AIParameters params;
+    params["solver.enabled"] = "true";
+    params["solver.objective"] = "max_chain";
+    params["solver.depth"] = "3";
+    ChainSearchAI ai(params);
+    assert(ai.initialize());
+
+    AIDecision decision = ai.think(state);
+    assert(decision.reason.find("ExactSolver[") == 0);
+    assert(decision.reason.find("depth=3") != std::string::npos);
+    assert(ai.last_solver_result().found);
+    assert(ai.last_solver_result().max_chain >= 2);
+    assert(ai.last_solver_result().sequence.size() == 3);
+    assert(decision.x == PLACEMENTS[ai.last_solver_result().sequence.front()].x);
+
+    // 見えているツモでは連鎖しない場合は通常の評価で選ぶ（配置インデックス0の列にしない）
+    Field empty;
+    ai::GameState quiet = state;
+    quiet.own_field = &empty;
+    AIDecision fallback = ai.think(quiet);
+    assert(ai.last_solver_result().found);
+    assert(ai.last_solver_result().max_chain == 0);
+    assert(fallback.reason.find("ExactSolver") == std::string::npos);
+    assert(fallback.reason.find("ChainSearch[") == 0);
+
+    // 無効時は通常の探索
+    ChainSearchAI heuristic;
+    assert(heuristic.initialize());
+    AIDecision normal = heuristic.think(state);
+    assert(normal.reason.find("ExactSolver") == std::string::npos);
+
+    std::cout << "✅ ChainSearchAI solver mode test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Exact Solver Tests ===" << std::endl;
+
+    test_max_chain();
+    test_deduplication();
+    test_transposition_tie_break();
+    test_all_clear();
+    test_solver_mode();
+
+    std::cout << "🎉 All exact solver tests passed!" << std::endl;
+    return 0;
+}
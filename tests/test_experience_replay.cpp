@@ -0,0 +1,235 @@
+#include "../cpp/ai/experience_replay.h"
+#include "../cpp/ai/rl_player_ai.h"
+#include "../cpp/core/field.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+CompactExperience make_experience(int id) {
+    CompactExperience experience;
+    experience.reward = static_cast<float>(id);
+    experience.action = static_cast<uint8_t>(id % PLACEMENT_COUNT);
+    experience.state.turn_count = static_cast<uint16_t>(id);
+    return experience;
+}
+
+void test_pack_round_trip() {
+    std::cout << "Testing packed state round trip..." << std::endl;
+
+    RLState state;
+    for (int i = 0; i < FIELD_WIDTH * FIELD_HEIGHT; ++i) {
+        state.field_state[i] = (i * 7) % 7;  // 0〜6（おじゃま含む）
+    }
+    state.current_colors[0] = static_cast<int>(PuyoColor::GREEN);
+    state.current_colors[1] = static_cast<int>(PuyoColor::PURPLE);
+    state.next_colors = {1, 2, 3, 4};
+    state.turn_count = 321;
+    state.last_chain_count = 7;
+
+    PackedRLState packed = state.pack();
+    RLState restored = RLState::unpack(packed);
+    assert(restored.field_state == state.field_state);
+    assert(restored.current_colors[0] == state.current_colors[0]);
+    assert(restored.current_colors[1] == state.current_colors[1]);
+    assert(restored.next_colors == state.next_colors);
+    assert(restored.turn_count == 321);
+    assert(restored.last_chain_count == 7);
+
+    // スナップショットから直接求めたキーも同じ
+    assert(packed.state_key() == state.pack_key());
+
+    RLState empty;
+    assert(empty.pack().state_key() == 0);
+
+    std::cout << "✅ Packed state round trip test passed" << std::endl;
+}
+
+void test_ring_buffer() {
+    std::cout << "Testing experience ring buffer..." << std::endl;
+
+    ExperienceReplay replay(4);
+    assert(replay.empty());
+    assert(replay.capacity() == 4);
+
+    for (int i = 0; i < 3; ++i) {
+        replay.push(make_experience(i));
+    }
+    assert(replay.size() == 3);
+    assert(!replay.full());
+    assert(replay.at(0).reward == 0.0f);
+    assert(replay.latest().reward == 2.0f);
+
+    // 満杯後は最も古い経験から上書き
+    for (int i = 3; i < 10; ++i) {
+        replay.push(make_experience(i));
+    }
+    assert(replay.size() == 4);
+    assert(replay.full());
+    for (size_t i = 0; i < replay.size(); ++i) {
+        assert(replay.at(i).reward == static_cast<float>(6 + i));
+    }
+    assert(replay.latest().reward == 9.0f);
+
+    replay.clear();
+    assert(replay.empty());
+    assert(replay.capacity() == 4);
+
+    // 容量0では何も保持しない
+    ExperienceReplay disabled;
+    disabled.push(make_experience(1));
+    assert(disabled.empty());
+
+    std::cout << "✅ Experience ring buffer test passed" << std::endl;
+}
+
+void test_sampling() {
+    std::cout << "Testing experience sampling..." << std::endl;
+
+    ExperienceReplay replay(8);
+    for (int i = 0; i < 20; ++i) {
+        replay.push(make_experience(i));
+    }
+
+    std::mt19937 random(1);
+    std::vector<const CompactExperience*> batch;
+    replay.sample(64, random, batch);
+    assert(batch.size() == 64);
+    for (const CompactExperience* experience : batch) {
+        // 残っているのは最新の8件のみ
+        assert(experience->reward >= 12.0f && experience->reward <= 19.0f);
+    }
+
+    ExperienceReplay empty(8);
+    empty.sample(4, random, batch);
+    assert(batch.empty());
+
+    std::cout << "✅ Experience sampling test passed" << std::endl;
+}
+
+void test_sum_tree() {
+    std::cout << "Testing sum tree..." << std::endl;
+
+    SumTree tree(5);
+    assert(tree.total() == 0.0);
+
+    double priorities[] = {1.0, 0.0, 3.0, 2.0, 4.0};
+    for (int i = 0; i < 5; ++i) {
+        tree.update(i, priorities[i]);
+    }
+    assert(tree.total() == 10.0);
+    assert(tree.priority(2) == 3.0);
+
+    // 累積和 [0,1) → 0, [1,4) → 2, [4,6) → 3, [6,10) → 4（優先度0の葉は選ばれない）
+    assert(tree.find(0.0) == 0);
+    assert(tree.find(0.99) == 0);
+    assert(tree.find(1.0) == 2);
+    assert(tree.find(3.99) == 2);
+    assert(tree.find(4.0) == 3);
+    assert(tree.find(6.5) == 4);
+    assert(tree.find(9.99) == 4);
+
+    tree.update(4, 0.5);
+    assert(tree.total() == 6.5);
+    assert(tree.find(6.2) == 4);
+
+    std::cout << "✅ Sum tree test passed" << std::endl;
+}
+
+void test_prioritized_sampling() {
+    std::cout << "Testing prioritized sampling..." << std::endl;
+
+    PrioritizedReplay::Config config;
+    config.alpha = 1.0;
+    config.epsilon = 0.0;
+    config.beta_start = 0.5;
+    config.beta_end = 1.0;
+    config.beta_steps = 4;
+    PrioritizedReplay replay(4, config);
+    for (int i = 0; i < 4; ++i) {
+        replay.push(make_experience(i));
+    }
+    // 追加直後はすべて最大優先度
+    assert(replay.total_priority() == 4.0);
+
+    std::mt19937 random(7);
+    std::vector<PrioritizedReplay::Sample> batch;
+    replay.sample(4, random, batch);
+    assert(batch.size() == 4);
+    std::vector<double> td_errors;
+    for (const auto& sample : batch) {
+        // 優先度が等しければ重みは全て1
+        assert(std::abs(sample.weight - 1.0) < 1e-9);
+        td_errors.push_back(sample.experience->reward == 3.0f ? 9.0 : 1.0);
+    }
+
+    // バッチ単位の優先度更新（TD誤差の大きい経験が選ばれやすくなる）
+    replay.update_priorities(batch, td_errors);
+    for (int i = 0; i < 3; ++i) {
+        replay.update_priority(i, 1.0);
+    }
+    replay.update_priority(3, 9.0);
+    assert(replay.total_priority() == 12.0);
+
+    int counts[4] = {0, 0, 0, 0};
+    for (int round = 0; round < 2000; ++round) {
+        replay.sample(4, random, batch);
+        for (const auto& sample : batch) {
+            counts[static_cast<int>(sample.experience->reward)]++;
+            // 最も選ばれやすい経験の重みが最小
+            if (sample.experience->reward == 3.0f) {
+                assert(sample.weight <= 1.0);
+            }
+        }
+    }
+    double share = counts[3] / 8000.0;
+    assert(share > 0.70 && share < 0.80);   // 9 / 12 = 0.75
+    assert(replay.current_beta() == 1.0);   // βはbeta_endまで焼きなまし済み
+
+    // 容量を超えると古いスロットから上書き（優先度は最大で入る）
+    replay.push(make_experience(10));
+    assert(replay.size() == 4);
+    assert(replay.latest().reward == 10.0f);
+    assert(replay.priority(0) == 9.0);
+
+    std::cout << "✅ Prioritized sampling test passed" << std::endl;
+}
+
+void test_rl_player_replay() {
+    std::cout << "Testing RLPlayerAI replay buffer..." << std::endl;
+
+    RLPlayerAI ai;
+    Field field;
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::BLUE);
+
+    for (int i = 0; i < 5; ++i) {
+        ai.provide_feedback(state, {2, 0}, 100.0);
+    }
+    // 無効な配置は格納しない
+    ai.provide_feedback(state, {0, 3}, 100.0);
+
+    std::string info = ai.get_debug_info();
+    assert(info.find("replay=5/") != std::string::npos);
+    assert(info.find("states=1") != std::string::npos);
+
+    std::cout << "✅ RLPlayerAI replay buffer test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Experience Replay Tests ===" << std::endl;
+
+    test_pack_round_trip();
+    test_ring_buffer();
+    test_sampling();
+    test_sum_tree();
+    test_prioritized_sampling();
+    test_rl_player_replay();
+
+    std::cout << "🎉 All experience replay tests passed!" << std::endl;
+    return 0;
+}
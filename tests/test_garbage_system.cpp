@@ -1,6 +1,7 @@
 #include "../cpp/core/garbage_system.h"
 #include "../cpp/core/chain_system.h"
 #include "../cpp/core/field.h"
+#include "../cpp/core/bit_field.h"
 #include <iostream>
 #include <cassert>
 
@@ -196,6 +197,48 @@ void test_complex_garbage_scenario() {
     std::cout << "Complex garbage scenario: OK" << std::endl;
 }
 
+void test_bit_field_garbage_drop() {
+    std::cout << "Testing BitField garbage drop simulation..." << std::endl;
+    
+    // 相殺数はGarbageSystemと同じ規則
+    assert(GarbageSystem::calculate_offset(280, 10) == 4);
+    assert(GarbageSystem::calculate_offset(980, 10) == 10);
+    assert(GarbageSystem::calculate_offset(69, 10) == 0);
+    
+    // 段単位の降下はGarbageSystemと一致する
+    Field field;
+    field.set_puyo(Position(0, 0), PuyoColor::RED);
+    field.set_puyo(Position(0, 1), PuyoColor::RED);
+    field.set_puyo(Position(3, 0), PuyoColor::BLUE);
+    
+    BitField bits = BitField::from_field(field);
+    GarbageSystem garbage_system(&field);
+    garbage_system.add_pending_garbage(12);
+    garbage_system.drop_pending_garbage();
+    field.apply_gravity();
+    
+    assert(bits.drop_garbage(12) == 12);
+    assert(bits == BitField::from_field(field));
+    
+    // 余りは低い列から埋める
+    BitField remainder;
+    remainder.set_puyo(2, 0, PuyoColor::GREEN);
+    assert(remainder.drop_garbage(3) == 3);
+    assert(remainder.count_color(PuyoColor::GARBAGE) == 3);
+    assert(remainder.height(2) == 1);
+    assert(remainder.height(3) == 1 && remainder.height(1) == 1 && remainder.height(4) == 1);
+    
+    // 14段目には置かない
+    BitField tall;
+    for (int y = 0; y < FIELD_HEIGHT - 2; ++y) {
+        tall.set_puyo(2, y, PuyoColor::YELLOW);
+    }
+    assert(tall.drop_garbage(30) == FIELD_WIDTH);
+    assert(tall.is_game_over());
+    
+    std::cout << "BitField garbage drop simulation: OK" << std::endl;
+}
+
 int main() {
     std::cout << "=== Garbage System Tests ===" << std::endl;
     
@@ -206,6 +249,7 @@ int main() {
         test_garbage_chain_interaction();
         test_garbage_non_chain_property();
         test_complex_garbage_scenario();
+        test_bit_field_garbage_drop();
         
         std::cout << "\n✅ All garbage system tests passed!" << std::endl;
     } catch (const std::exception& e) {
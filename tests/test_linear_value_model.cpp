@@ -0,0 +1,227 @@
+#include "../cpp/ai/linear_value_model.h"
+#include "../cpp/ai/rl_features.h"
+#include "../cpp/ai/rl_player_ai.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+const char* TEST_PATH = "test_linear_value_model.bin";
+constexpr float CELL_SCALE = 1.0f / (FIELD_WIDTH * (FIELD_HEIGHT - 1));
+
+bool near(float a, float b, float tolerance = 1e-4f) {
+    return std::fabs(a - b) <= tolerance;
+}
+
+void test_dot_product() {
+    std::cout << "Testing SIMD dot product..." << std::endl;
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    float a[27], b[27];
+    for (int i = 0; i < 27; ++i) {
+        a[i] = uniform(random);
+        b[i] = uniform(random);
+    }
+    // 4の倍数と端数のある長さの両方でスカラー版と一致する
+    for (int n : {0, 3, 4, 24, 27}) {
+        assert(near(LinearValueModel::dot(a, b, n), LinearValueModel::dot_scalar(a, b, n)));
+    }
+
+    float y[27];
+    for (int i = 0; i < 27; ++i) y[i] = b[i];
+    LinearValueModel::axpy(0.5f, a, y, 27);
+    for (int i = 0; i < 27; ++i) {
+        assert(near(y[i], b[i] + 0.5f * a[i]));
+    }
+
+    std::cout << "✅ SIMD dot product test passed" << std::endl;
+}
+
+void test_update_converges() {
+    std::cout << "Testing linear model update..." << std::endl;
+
+    RLFeatureVector features;
+    features[RLFeatureExtractor::BIAS] = 1.0f;
+    features[RLFeatureExtractor::HEIGHT] = 0.5f;
+    features[RLFeatureExtractor::POTENTIAL_CHAIN] = 0.3f;
+
+    LinearValueModel model;
+    assert(model.predict(features) == 0.0f);
+    float first_error = model.update(features, 10.0f, 0.1f);
+    assert(near(first_error, 10.0f));
+    float error = first_error;
+    for (int i = 0; i < 200; ++i) {
+        float next_error = model.update(features, 10.0f, 0.1f);
+        assert(std::fabs(next_error) <= std::fabs(error) + 1e-5f);
+        error = next_error;
+    }
+    assert(near(model.predict(features), 10.0f, 1e-2f));
+    // 特徴が0の重みは動かない
+    assert(model.weight(RLFeatureExtractor::GARBAGE) == 0.0f);
+
+    std::cout << "✅ Linear model update test passed" << std::endl;
+}
+
+void test_feature_extraction() {
+    std::cout << "Testing bitboard feature extraction..." << std::endl;
+
+    RLFeatureExtractor extractor;
+    RLFeatureVector features;
+    extractor.extract(BitField(), 0, features);
+    assert(features[RLFeatureExtractor::BIAS] == 1.0f);
+    for (int i = 1; i < RLFeatureVector::SIZE; ++i) {
+        assert(features[i] == 0.0f);
+    }
+
+    // 赤の横2連結 + 緑1個 + 青の縦3連結 + おじゃま1個
+    BitField field;
+    field.set_puyo(0, 0, PuyoColor::RED);
+    field.set_puyo(1, 0, PuyoColor::RED);
+    field.set_puyo(0, 1, PuyoColor::GREEN);
+    field.set_puyo(3, 0, PuyoColor::BLUE);
+    field.set_puyo(3, 1, PuyoColor::BLUE);
+    field.set_puyo(3, 2, PuyoColor::BLUE);
+    field.set_puyo(5, 0, PuyoColor::GARBAGE);
+    extractor.extract(field, 12, features);
+
+    assert(near(features[RLFeatureExtractor::HEIGHT + 0], 2.0f / FIELD_HEIGHT));
+    assert(near(features[RLFeatureExtractor::HEIGHT + 3], 3.0f / FIELD_HEIGHT));
+    assert(near(features[RLFeatureExtractor::HEIGHT_DIFF + 2], 3.0f / FIELD_HEIGHT));
+    assert(near(features[RLFeatureExtractor::MAX_HEIGHT], 3.0f / FIELD_HEIGHT));
+    assert(features[RLFeatureExtractor::DANGER] == 0.0f);
+    assert(near(features[RLFeatureExtractor::PUYO_COUNT], 7 * CELL_SCALE));
+    assert(near(features[RLFeatureExtractor::HORIZONTAL_PAIRS], 1 * CELL_SCALE * 2.0f));
+    assert(near(features[RLFeatureExtractor::VERTICAL_PAIRS], 2 * CELL_SCALE * 2.0f));
+    assert(near(features[RLFeatureExtractor::SINGLES], 1 * CELL_SCALE));
+    assert(near(features[RLFeatureExtractor::GROUPS_2], 1 * CELL_SCALE * 2.0f));
+    assert(near(features[RLFeatureExtractor::GROUPS_3], 1 * CELL_SCALE * 3.0f));
+    assert(near(features[RLFeatureExtractor::GARBAGE], 1 * CELL_SCALE));
+    assert(near(features[RLFeatureExtractor::PENDING_GARBAGE], 12.0f / 30.0f));
+    // 青を1個足せば消える
+    assert(near(features[RLFeatureExtractor::POTENTIAL_CHAIN], 0.1f));
+    assert(features[RLFeatureExtractor::POTENTIAL_SCORE] > 0.0f);
+
+    // 連鎖ポテンシャルを切ると0になる
+    RLFeatureExtractor cheap(false);
+    cheap.extract(field, 12, features);
+    assert(features[RLFeatureExtractor::POTENTIAL_CHAIN] == 0.0f);
+
+    // 経験リプレイのスナップショットから同じ盤面を復元できる
+    RLState state;
+    for (int y = 0; y < FIELD_HEIGHT; ++y) {
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            state.field_state[y * FIELD_WIDTH + x] = static_cast<int>(field.get_puyo(x, y));
+        }
+    }
+    BitField restored = RLFeatureExtractor::field_from_packed(state.pack());
+    assert(restored.hash() == field.hash());
+
+    std::cout << "✅ Bitboard feature extraction test passed" << std::endl;
+}
+
+void test_model_file() {
+    std::cout << "Testing linear model file..." << std::endl;
+
+    LinearValueModel model;
+    for (int i = 0; i < LinearValueModel::FEATURE_COUNT; ++i) {
+        model.set_weight(i, 0.25f * i - 1.0f);
+    }
+    assert(model.save(TEST_PATH));
+
+    LinearValueModel loaded;
+    assert(loaded.load(TEST_PATH));
+    for (int i = 0; i < LinearValueModel::FEATURE_COUNT; ++i) {
+        assert(loaded.weight(i) == model.weight(i));
+    }
+
+    // 重みが壊れていれば読まない
+    {
+        std::fstream file(TEST_PATH, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('\x7f');
+    }
+    LinearValueModel rejected;
+    assert(!rejected.load(TEST_PATH));
+    assert(rejected.weight(0) == 0.0f);
+    assert(!rejected.load("no_such_linear_model.bin"));
+
+    std::remove(TEST_PATH);
+    std::cout << "✅ Linear model file test passed" << std::endl;
+}
+
+void test_rl_player_linear_backend() {
+    std::cout << "Testing RLPlayerAI linear backend..." << std::endl;
+
+    RLPlayerAI ai;
+    ai.set_linear_backend(true);
+    ai.set_model_path(TEST_PATH);
+    assert(ai.is_linear_backend());
+    assert(ai.get_debug_info().find("backend=linear") != std::string::npos);
+
+    // 赤3個の縦積みに赤ぷよを置けば消せる。重みが0なら即時報酬の大きい配置を選ぶ
+    BitField field;
+    field.set_puyo(0, 0, PuyoColor::RED);
+    field.set_puyo(0, 1, PuyoColor::RED);
+    field.set_puyo(0, 2, PuyoColor::RED);
+    double value = 0.0;
+    int best = ai.greedy_linear_placement(field, PuyoColor::RED, PuyoColor::GREEN, 0, ai.get_value_model(), &value);
+    assert(best >= 0);
+    BitField after = field;
+    assert(after.place_and_simulate(PLACEMENTS[best].x, PLACEMENTS[best].r, PuyoColor::RED, PuyoColor::GREEN)
+               .chain_count == 1);
+    assert(value > 0.0);
+
+    // 経験で重みが動き、Q表は増えない
+    Field game_field;
+    ai::GameState state;
+    state.own_field = &game_field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::GREEN);
+    for (int i = 0; i < 20; ++i) {
+        ai.provide_feedback(state, {2, 0}, 500.0);
+    }
+    assert(ai.get_q_table().empty());
+    assert(ai.get_value_model().weight(RLFeatureExtractor::BIAS) > 0.0f);
+
+    // 予告おじゃまぷよは実際の数を特徴量にして学習する（0の間は重みが動かない）
+    assert(ai.get_value_model().weight(RLFeatureExtractor::PENDING_GARBAGE) == 0.0f);
+    state.garbage.pending = 30;
+    ai.provide_feedback(state, {2, 0}, 500.0);
+    assert(ai.get_value_model().weight(RLFeatureExtractor::PENDING_GARBAGE) > 0.0f);
+    state.garbage.pending = 0;
+
+    assert(ai.initialize());
+    AIDecision decision = ai.think(state);
+    assert(decision.x >= 0 && decision.x < FIELD_WIDTH);
+    assert(decision.reason.find("V=") != std::string::npos);
+
+    // 保存したモデルを別のインスタンスで読める
+    assert(ai.save_model());
+    RLPlayerAI loaded;
+    loaded.set_linear_backend(true);
+    loaded.set_model_path(TEST_PATH);
+    assert(loaded.load_model());
+    assert(loaded.get_value_model().weight(RLFeatureExtractor::BIAS) ==
+           ai.get_value_model().weight(RLFeatureExtractor::BIAS));
+
+    std::remove(TEST_PATH);
+    std::cout << "✅ RLPlayerAI linear backend test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Linear Value Model Tests ===" << std::endl;
+
+    test_dot_product();
+    test_update_converges();
+    test_feature_extraction();
+    test_model_file();
+    test_rl_player_linear_backend();
+
+    std::cout << "🎉 All linear value model tests passed!" << std::endl;
+    return 0;
+}
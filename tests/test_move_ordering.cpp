@@ -0,0 +1,126 @@
+#include "../cpp/ai/move_ordering.h"
+#include "../cpp/ai/chain_search_ai.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+void test_duplicate_pruning() {
+    std::cout << "Testing duplicate placement pruning..." << std::endl;
+
+    MoveOrderer orderer;
+    BitField empty;
+
+    // 同色ペアは上下反転（UP/DOWN）と左右入れ替え（RIGHT x / LEFT x+1）が同じ盤面になる
+    auto same = orderer.generate(empty, PuyoColor::RED, PuyoColor::RED);
+    assert(orderer.last_stats().generated == PLACEMENT_COUNT);
+    assert(orderer.last_stats().pruned_duplicate == 11);
+    assert(same.size() == PLACEMENT_COUNT - 11);
+
+    // 残した手の盤面は互いに異なり、同じ盤面の中で配置インデックスが最小の手
+    for (size_t i = 0; i < same.size(); ++i) {
+        for (size_t j = i + 1; j < same.size(); ++j) {
+            assert(!(same[i].field == same[j].field));
+        }
+        for (int k = 0; k < same[i].index; ++k) {
+            BitField other = empty;
+            other.place_and_simulate(PLACEMENTS[k].x, PLACEMENTS[k].r, PuyoColor::RED, PuyoColor::RED);
+            assert(!(other == same[i].field));
+        }
+    }
+
+    // 異色ペアは重複しない
+    auto different = orderer.generate(empty, PuyoColor::RED, PuyoColor::BLUE);
+    assert(different.size() == PLACEMENT_COUNT);
+    assert(orderer.last_stats().pruned_duplicate == 0);
+
+    // 無効化すれば全手を返す
+    MoveOrderer::Config config;
+    config.prune_duplicates = false;
+    MoveOrderer keep_all(config);
+    assert(keep_all.generate(empty, PuyoColor::RED, PuyoColor::RED).size() == PLACEMENT_COUNT);
+
+    std::cout << "✅ Duplicate placement pruning test passed" << std::endl;
+}
+
+void test_suicidal_pruning_and_order() {
+    std::cout << "Testing suicidal pruning and ordering..." << std::endl;
+
+    // 3列目が11段：3列目への縦置きは窒息点(2,11)を埋める
+    BitField field;
+    for (int y = 0; y < 10; ++y) {
+        field.set_puyo(2, y, static_cast<PuyoColor>(1 + (y / 2) % COLOR_COUNT));
+    }
+    MoveOrderer orderer;
+    auto candidates = orderer.generate(field, PuyoColor::RED, PuyoColor::BLUE);
+    assert(orderer.last_stats().pruned_suicidal > 0);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        assert(!candidates[i].field.is_game_over());
+        // 事前スコアの降順、同点は配置インデックス順
+        if (i > 0) {
+            assert(candidates[i - 1].pre_score > candidates[i].pre_score ||
+                   (candidates[i - 1].pre_score == candidates[i].pre_score &&
+                    candidates[i - 1].index < candidates[i].index));
+        }
+    }
+
+    std::cout << "✅ Suicidal pruning and ordering test passed" << std::endl;
+}
+
+Field make_random_field(std::mt19937& rng) {
+    Field field;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+        int height = static_cast<int>(rng() % 8);
+        for (int y = 0; y < height; ++y) {
+            field.set_puyo(Position(x, y), static_cast<PuyoColor>(1 + rng() % COLOR_COUNT));
+        }
+    }
+    return field;
+}
+
+void test_ordering_keeps_decisions() {
+    std::cout << "Testing ChainSearchAI decisions under move ordering..." << std::endl;
+
+    // 並べ替えのみ（重複除外なし）なら、配置インデックス順に評価した場合と同じ手を選ぶ
+    AIParameters ordered_params;
+    ordered_params["think_time_limit"] = "60000";
+    ordered_params["move_ordering.prune_duplicates"] = "false";
+    AIParameters index_params = ordered_params;
+    index_params["move_ordering.adjacency_weight"] = "0";
+    index_params["move_ordering.height_weight"] = "0";
+    index_params["move_ordering.chain_weight"] = "0";
+
+    ChainSearchAI ordered(ordered_params);
+    ChainSearchAI by_index(index_params);
+    assert(ordered.initialize() && by_index.initialize());
+
+    std::mt19937 rng(29);
+    for (int trial = 0; trial < 20; ++trial) {
+        Field field = make_random_field(rng);
+        GameState state;
+        state.own_field = &field;
+        state.current_pair = PuyoPair(static_cast<PuyoColor>(1 + rng() % COLOR_COUNT),
+                                      static_cast<PuyoColor>(1 + rng() % COLOR_COUNT));
+        state.next_queue = {PuyoPair(static_cast<PuyoColor>(1 + rng() % COLOR_COUNT),
+                                     static_cast<PuyoColor>(1 + rng() % COLOR_COUNT))};
+
+        AIDecision a = ordered.think(state);
+        AIDecision b = by_index.think(state);
+        assert(a.x == b.x && a.r == b.r);
+    }
+
+    std::cout << "✅ ChainSearchAI move ordering decision test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Move Ordering Tests ===" << std::endl;
+
+    test_duplicate_pruning();
+    test_suicidal_pruning_and_order();
+    test_ordering_keeps_decisions();
+
+    std::cout << "🎉 All move ordering tests passed!" << std::endl;
+    return 0;
+}
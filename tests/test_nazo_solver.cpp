@@ -0,0 +1,147 @@
+#include "../cpp/ai/nazo_solver.h"
+#include "../cpp/core/bit_field.h"
+#include <iostream>
+#include <cassert>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+// 赤1個で2連鎖が発火する盤面
+//   y3: . G
+//   y2: G R
+//   y1: G R
+//   y0: G R .  ← (2,0)に赤で発火
+const char* TWO_CHAIN_PUZZLE = "1G4/GR4/GR4/GR4 RB,YY chain:2";
+
+void test_parse() {
+    std::cout << "Testing puzzle text encoding..." << std::endl;
+
+    NazoPuzzle puzzle;
+    std::string error;
+    assert(NazoPuzzle::parse(TWO_CHAIN_PUZZLE, puzzle, &error));
+    assert(puzzle.field.get_puyo(0, 0) == PuyoColor::GREEN);
+    assert(puzzle.field.get_puyo(1, 2) == PuyoColor::RED);
+    assert(puzzle.field.get_puyo(1, 3) == PuyoColor::GREEN);
+    assert(puzzle.field.count_puyos() == 7);
+    assert(puzzle.pairs.size() == 2);
+    assert(puzzle.pairs[0].first == PuyoColor::RED && puzzle.pairs[0].second == PuyoColor::BLUE);
+    assert(puzzle.goal == NazoPuzzle::Goal::CHAIN && puzzle.target == 2);
+    assert(puzzle.to_string() == TWO_CHAIN_PUZZLE);
+
+    assert(NazoPuzzle::parse("- RG clear", puzzle));
+    assert(puzzle.goal == NazoPuzzle::Goal::ALL_CLEAR);
+    assert(puzzle.to_string() == "- RG clear");
+    assert(NazoPuzzle::parse("OOOOOO RR score:500", puzzle));
+    assert(puzzle.field.count_color(PuyoColor::GARBAGE) == 6);
+
+    // 不正な形式
+    assert(!NazoPuzzle::parse("R4 RG chain:1", puzzle, &error));
+    assert(!NazoPuzzle::parse("R5/6 RG chain:1", puzzle, &error));
+    assert(error.find("floating") != std::string::npos);
+    assert(!NazoPuzzle::parse("X5 RG chain:1", puzzle, &error));
+    assert(!NazoPuzzle::parse("RGBYRG/RGBYRGB RG chain:1", puzzle, &error));
+    assert(error.find("more than 6") != std::string::npos);
+    assert(!NazoPuzzle::parse("R5R RG chain:1", puzzle, &error));
+    assert(!NazoPuzzle::parse("- RO chain:1", puzzle, &error));
+    assert(!NazoPuzzle::parse("- RG chain:x", puzzle, &error));
+    assert(!NazoPuzzle::parse("- RG", puzzle, &error));
+
+    std::cout << "✅ Puzzle text encoding test passed" << std::endl;
+}
+
+void test_first_and_all_solutions() {
+    std::cout << "Testing first and all solutions..." << std::endl;
+
+    NazoPuzzle puzzle;
+    assert(NazoPuzzle::parse(TWO_CHAIN_PUZZLE, puzzle));
+
+    NazoSolver::Options options;
+    options.threads = 2;
+    NazoSolver::Result first = NazoSolver::solve(puzzle, options);
+    assert(first.solutions.size() == 1);
+    assert(first.solutions[0].placements.size() == 1);
+    assert(first.solutions[0].chain_count == 2);
+    assert(NazoSolver::verify(puzzle, first.solutions[0]));
+
+    options.find_all = true;
+    NazoSolver::Result all = NazoSolver::solve(puzzle, options);
+    assert(all.solutions.size() == 3);
+    assert(all.solutions[0].placements == first.solutions[0].placements);
+    for (const auto& solution : all.solutions) {
+        std::string error;
+        assert(NazoSolver::verify(puzzle, solution, &error));
+        assert(PLACEMENTS[solution.placements[0]].x == 2);
+    }
+    assert(NazoSolver::format_placement(all.solutions[0].placements[0]) == "3:UP");
+
+    std::cout << "✅ First and all solutions test passed" << std::endl;
+}
+
+void test_all_clear_goal() {
+    std::cout << "Testing all clear goal and pruning..." << std::endl;
+
+    NazoPuzzle puzzle;
+    assert(NazoPuzzle::parse("- RG,RG,RG,RG clear", puzzle));
+    NazoSolver::Result result = NazoSolver::solve(puzzle);
+    assert(result.solutions.size() == 1);
+    assert(result.solutions[0].all_clear);
+    assert(NazoSolver::verify(puzzle, result.solutions[0]));
+
+    // 青が2個しかないため、探索前に枝刈りされる
+    assert(NazoPuzzle::parse("- RG,RG,RG,RG,BB clear", puzzle));
+    result = NazoSolver::solve(puzzle);
+    assert(result.solutions.empty());
+    assert(result.pruned > 0);
+    assert(result.nodes == 0);
+
+    // 3連鎖には12個以上のぷよが必要
+    assert(NazoPuzzle::parse("- RG,BY,RG,BY,RR chain:3", puzzle));
+    result = NazoSolver::solve(puzzle);
+    assert(result.solutions.empty());
+    assert(result.nodes == 0);
+
+    std::cout << "✅ All clear goal test passed" << std::endl;
+}
+
+void test_parallel_determinism() {
+    std::cout << "Testing parallel determinism..." << std::endl;
+
+    NazoPuzzle puzzle;
+    assert(NazoPuzzle::parse("- RG,RG,GR,GR,RG clear", puzzle));
+
+    NazoSolver::Options options;
+    options.find_all = true;
+    options.max_solutions = 200;
+    options.threads = 1;
+    NazoSolver::Result serial = NazoSolver::solve(puzzle, options);
+    options.threads = 4;
+    NazoSolver::Result parallel = NazoSolver::solve(puzzle, options);
+
+    assert(serial.solutions.size() == 200);
+    assert(serial.truncated);
+    assert(parallel.solutions.size() == serial.solutions.size());
+
+    // 最初の解はスレッド数に依らず配置順で最初のもの
+    options.find_all = false;
+    options.threads = 1;
+    NazoSolver::Result first_serial = NazoSolver::solve(puzzle, options);
+    options.threads = 4;
+    NazoSolver::Result first_parallel = NazoSolver::solve(puzzle, options);
+    assert(first_serial.solutions.size() == 1);
+    assert(first_serial.solutions[0].placements == first_parallel.solutions[0].placements);
+    assert(first_serial.solutions[0].placements == serial.solutions[0].placements);
+
+    std::cout << "✅ Parallel determinism test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Nazo Solver Tests ===" << std::endl;
+
+    test_parse();
+    test_first_and_all_solutions();
+    test_all_clear_goal();
+    test_parallel_determinism();
+
+    std::cout << "🎉 All nazo solver tests passed!" << std::endl;
+    return 0;
+}
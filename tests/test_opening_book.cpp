@@ -0,0 +1,122 @@
+#include "../cpp/ai/opening_book.h"
+#include "../cpp/core/bit_field.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+static const char* BOOK_PATH = "test_opening_book.bin";
+
+void test_color_normalized_key() {
+    std::cout << "Testing color-normalized key..." << std::endl;
+
+    // 色を入れ替えただけの局面は同じキーになる
+    OpeningBook::PairList pairs_a = {{PuyoColor::RED, PuyoColor::RED},
+                                     {PuyoColor::GREEN, PuyoColor::RED},
+                                     {PuyoColor::BLUE, PuyoColor::YELLOW}};
+    OpeningBook::PairList pairs_b = {{PuyoColor::YELLOW, PuyoColor::YELLOW},
+                                     {PuyoColor::BLUE, PuyoColor::YELLOW},
+                                     {PuyoColor::RED, PuyoColor::GREEN}};
+    BitField empty;
+    assert(OpeningBook::make_key(empty, pairs_a) == OpeningBook::make_key(empty, pairs_b));
+
+    // 盤面の色も含めて正規化される
+    BitField field_a, field_b;
+    field_a.place_pair(2, 0, PuyoColor::RED, PuyoColor::GREEN);
+    field_b.place_pair(2, 0, PuyoColor::BLUE, PuyoColor::RED);
+    OpeningBook::PairList next_a = {{PuyoColor::GREEN, PuyoColor::RED},
+                                    {PuyoColor::RED, PuyoColor::RED},
+                                    {PuyoColor::YELLOW, PuyoColor::GREEN}};
+    OpeningBook::PairList next_b = {{PuyoColor::RED, PuyoColor::BLUE},
+                                    {PuyoColor::BLUE, PuyoColor::BLUE},
+                                    {PuyoColor::GREEN, PuyoColor::RED}};
+    assert(OpeningBook::make_key(field_a, next_a) == OpeningBook::make_key(field_b, next_b));
+
+    // 異なる局面は異なるキー
+    OpeningBook::PairList pairs_c = {{PuyoColor::RED, PuyoColor::GREEN},
+                                     {PuyoColor::GREEN, PuyoColor::RED},
+                                     {PuyoColor::BLUE, PuyoColor::YELLOW}};
+    assert(OpeningBook::make_key(empty, pairs_a) != OpeningBook::make_key(empty, pairs_c));
+
+    std::cout << "✅ Color-normalized key test passed" << std::endl;
+}
+
+void test_write_and_lookup() {
+    std::cout << "Testing book write and lookup..." << std::endl;
+
+    OpeningBook::PairList pairs = {{PuyoColor::RED, PuyoColor::RED},
+                                   {PuyoColor::GREEN, PuyoColor::GREEN},
+                                   {PuyoColor::RED, PuyoColor::BLUE}};
+    BitField empty;
+
+    OpeningBookEntry entry{};
+    entry.key = OpeningBook::make_key(empty, pairs);
+    entry.placement = static_cast<uint8_t>(placement_index(0, 0));
+    entry.turn = 0;
+    assert(OpeningBook::write(BOOK_PATH, {entry}, 1, 4));
+
+    OpeningBook book;
+    assert(book.open(BOOK_PATH));
+    assert(book.size() == 1);
+    assert(book.max_turns() == 1);
+
+    // 色を入れ替えた局面でも引ける
+    OpeningBook::PairList swapped = {{PuyoColor::BLUE, PuyoColor::BLUE},
+                                     {PuyoColor::YELLOW, PuyoColor::YELLOW},
+                                     {PuyoColor::BLUE, PuyoColor::GREEN}};
+    assert(book.lookup(empty, swapped) == placement_index(0, 0));
+
+    // Field + GameState形式でも同じ結果
+    Field field;
+    std::vector<PuyoPair> next_queue = {PuyoPair(PuyoColor::GREEN, PuyoColor::GREEN),
+                                        PuyoPair(PuyoColor::RED, PuyoColor::BLUE)};
+    assert(book.lookup(field, PuyoPair(PuyoColor::RED, PuyoColor::RED), next_queue) == placement_index(0, 0));
+
+    // 未収録局面・ツモ不足
+    OpeningBook::PairList other = {{PuyoColor::RED, PuyoColor::GREEN},
+                                   {PuyoColor::GREEN, PuyoColor::GREEN},
+                                   {PuyoColor::RED, PuyoColor::BLUE}};
+    assert(book.lookup(empty, other) == -1);
+    assert(book.lookup(empty, OpeningBook::PairList(pairs.begin(), pairs.begin() + 2)) == -1);
+
+    // 収録手数を超えて置かれた盤面は参照しない
+    BitField filled;
+    filled.place_pair(0, 0, PuyoColor::RED, PuyoColor::GREEN);
+    filled.place_pair(1, 0, PuyoColor::BLUE, PuyoColor::YELLOW);
+    assert(book.lookup(filled, pairs) == -1);
+
+    std::cout << "✅ Book write and lookup test passed" << std::endl;
+}
+
+void test_invalid_file() {
+    std::cout << "Testing invalid book file..." << std::endl;
+
+    OpeningBook book;
+    assert(!book.open("nonexistent_opening_book.bin"));
+    assert(!book.is_open());
+
+    {
+        std::ofstream file(BOOK_PATH, std::ios::binary | std::ios::trunc);
+        file << "NOT A BOOK FILE, JUST SOME BYTES THAT ARE LONG ENOUGH";
+    }
+    assert(!book.open(BOOK_PATH));
+    assert(book.lookup(BitField(), {}) == -1);
+
+    std::cout << "✅ Invalid book file test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== OpeningBook Tests ===" << std::endl;
+
+    test_color_normalized_key();
+    test_write_and_lookup();
+    test_invalid_file();
+
+    std::remove(BOOK_PATH);
+
+    std::cout << "\n🎉 All opening book tests passed!" << std::endl;
+    return 0;
+}
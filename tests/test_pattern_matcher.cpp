@@ -0,0 +1,153 @@
+#include "../cpp/ai/pattern_matcher.h"
+#include "../cpp/core/bit_field.h"
+#include "../cpp/core/field.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <chrono>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+static const char* GTR_TEXT =
+    "# test library\n"
+    "pattern GTR\n"
+    "weight 30\n"
+    "mirror true\n"
+    "AB.\n"
+    "AAB\n"
+    "BBC\n"
+    "end\n";
+
+// GTRの土台を置く（A=赤, B=緑, C=青）
+BitField make_gtr(bool mirrored) {
+    BitField field;
+    auto put = [&](int x, int y, PuyoColor color) {
+        field.set_puyo(mirrored ? FIELD_WIDTH - 1 - x : x, y, color);
+    };
+    put(0, 0, PuyoColor::GREEN); put(1, 0, PuyoColor::GREEN); put(2, 0, PuyoColor::BLUE);
+    put(0, 1, PuyoColor::RED);   put(1, 1, PuyoColor::RED);   put(2, 1, PuyoColor::GREEN);
+    put(0, 2, PuyoColor::RED);   put(1, 2, PuyoColor::GREEN);
+    return field;
+}
+
+void test_compile() {
+    std::cout << "Testing pattern compile..." << std::endl;
+
+    std::vector<ChainPattern> patterns;
+    std::string error;
+    assert(PatternCompiler::compile_text(GTR_TEXT, patterns, &error));
+    assert(patterns.size() == 2);  // 通常 + 左右反転
+    assert(patterns[0].groups.size() == 3);
+    assert(patterns[0].total_cells == 8);
+    assert(!patterns[0].different.empty());
+
+    // 不正な定義
+    assert(!PatternCompiler::compile_text("pattern X\nA1\nend\n", patterns, &error));
+    assert(!PatternCompiler::compile_text("pattern X\nAAAAAAA\nend\n", patterns, &error));
+    assert(!PatternCompiler::compile_text("pattern X\nAA\n", patterns, &error));
+
+    std::cout << "✅ Pattern compile test passed" << std::endl;
+}
+
+void test_match() {
+    std::cout << "Testing pattern match..." << std::endl;
+
+    std::vector<ChainPattern> patterns;
+    assert(PatternCompiler::compile_text(GTR_TEXT, patterns));
+    PatternMatcher matcher;
+    matcher.set_patterns(patterns);
+
+    // 完全一致（BitField・FieldBitBoardsの両方）
+    BitField gtr = make_gtr(false);
+    PatternMatch match = matcher.match(gtr);
+    assert(match.pattern == 0);
+    assert(match.coverage == 1.0);
+    assert(match.score == 30.0);
+
+    Field field = gtr.to_field();
+    assert(matcher.score(field.get_field_bits()) == 30.0);
+
+    // 左右反転
+    PatternMatch mirrored = matcher.match(make_gtr(true));
+    assert(matcher.pattern_name(mirrored.pattern) == "GTR(mirror)");
+    assert(mirrored.coverage == 1.0);
+
+    // 部分一致（8個中4個）
+    BitField partial;
+    partial.set_puyo(0, 0, PuyoColor::YELLOW);
+    partial.set_puyo(1, 0, PuyoColor::YELLOW);
+    partial.set_puyo(0, 1, PuyoColor::BLUE);
+    partial.set_puyo(1, 1, PuyoColor::BLUE);
+    match = matcher.match(partial);
+    assert(match.coverage == 0.5);
+    assert(match.score == 30.0 * 0.25);
+
+    // 同グループに2色、隣接グループが同色、おじゃま混入は不一致
+    BitField broken = gtr;
+    broken.set_puyo(2, 1, PuyoColor::RED);
+    assert(matcher.score(broken) == 0.0);
+
+    BitField same_color;
+    same_color.set_puyo(0, 0, PuyoColor::RED);
+    same_color.set_puyo(0, 1, PuyoColor::RED);
+    assert(matcher.score(same_color) == 0.0);
+
+    BitField garbage = gtr;
+    garbage.set_puyo(2, 0, PuyoColor::GARBAGE);
+    assert(matcher.score(garbage) == 0.0);
+
+    std::cout << "✅ Pattern match test passed" << std::endl;
+}
+
+void test_binary_and_reload() {
+    std::cout << "Testing compiled library and hot reload..." << std::endl;
+
+    const char* text_path = "test_patterns.txt";
+    const char* binary_path = "test_patterns.bin";
+    {
+        std::ofstream file(text_path);
+        file << GTR_TEXT;
+    }
+
+    std::vector<ChainPattern> patterns;
+    assert(PatternCompiler::load_file(text_path, patterns));
+    assert(PatternCompiler::write_binary(binary_path, patterns));
+
+    PatternMatcher matcher;
+    assert(matcher.load(binary_path));
+    assert(matcher.size() == 2);
+    assert(matcher.score(make_gtr(false)) == 30.0);
+
+    // 未更新なら読み直さない
+    assert(!matcher.reload_if_changed());
+
+    // テキストを書き換えて差し替え
+    assert(matcher.load(text_path));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    {
+        std::ofstream file(text_path);
+        file << "pattern GTR\nweight 60\nAB.\nAAB\nBBC\nend\n";
+    }
+    assert(matcher.reload_if_changed());
+    assert(matcher.size() == 1);
+    assert(matcher.score(make_gtr(false)) == 60.0);
+
+    std::remove(text_path);
+    std::remove(binary_path);
+
+    std::cout << "✅ Compiled library and hot reload test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Pattern Matcher Tests ===" << std::endl;
+
+    test_compile();
+    test_match();
+    test_binary_and_reload();
+
+    std::cout << "\n🎉 All pattern matcher tests passed!" << std::endl;
+    return 0;
+}
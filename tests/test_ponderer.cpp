@@ -0,0 +1,295 @@
+#include "../cpp/ai/ponderer.h"
+#include "../cpp/ai/chain_search_ai.h"
+#include "../cpp/ai/mcts_ai.h"
+#include "../cpp/core/game_manager.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+// 相手は赤1個で2連鎖を撃てる盤面
+Field make_opponent_field() {
+    Field field;
+    for (int y = 0; y < 3; ++y) {
+        field.set_puyo(Position(0, y), PuyoColor::GREEN);
+        field.set_puyo(Position(1, y), PuyoColor::RED);
+    }
+    field.set_puyo(Position(1, 3), PuyoColor::GREEN);
+    return field;
+}
+
+// 相手の手番が終わるまでに先読みが全局面を思考し終えた状況を作る
+void wait_until_pondered(const Ponderer& ponderer) {
+    while (ponderer.is_pondering()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+ai::GameState make_upcoming(const Field& own, const Field& opponent) {
+    ai::GameState state;
+    state.own_field = &own;
+    state.opponent_field = &opponent;
+    state.is_versus_mode = true;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::BLUE);
+    state.next_queue = {PuyoPair(PuyoColor::GREEN, PuyoColor::GREEN),
+                        PuyoPair(PuyoColor::YELLOW, PuyoColor::RED)};
+    return state;
+}
+
+void test_pending_outcomes() {
+    std::cout << "Testing pending garbage outcomes..." << std::endl;
+
+    Field own;
+    Field opponent = make_opponent_field();
+    ai::GameState upcoming = make_upcoming(own, opponent);
+    upcoming.garbage.pending = 2;
+
+    std::vector<int> outcomes = Ponderer::predict_pending_outcomes(upcoming);
+    assert(outcomes.size() == 2);
+    assert(outcomes[0] == 2);
+    assert(outcomes[1] > 2);
+
+    // 相手が撃てなければ予告おじゃまは変わらない
+    Field calm;
+    upcoming.opponent_field = &calm;
+    assert(Ponderer::predict_pending_outcomes(upcoming).size() == 1);
+
+    std::cout << "✅ Pending garbage outcomes test passed" << std::endl;
+}
+
+void test_ponder_hit() {
+    std::cout << "Testing ponder hit..." << std::endl;
+
+    ChainSearchAI ai;
+    assert(ai.initialize());
+
+    Field own;
+    own.set_puyo(Position(2, 0), PuyoColor::BLUE);
+    Field opponent = make_opponent_field();
+    ai::GameState upcoming = make_upcoming(own, opponent);
+
+    AIDecision expected = ai.think(upcoming);
+
+    Ponderer ponderer(ai);
+    ponderer.start(upcoming);
+    wait_until_pondered(ponderer);
+
+    // 相手が動いた後も自分の盤面・ツモが同じなら先読み結果を使う
+    Field opponent_after = opponent;
+    opponent_after.set_puyo(Position(3, 0), PuyoColor::YELLOW);
+    ai::GameState actual = make_upcoming(own, opponent_after);
+
+    AIDecision decision;
+    assert(ponderer.take(actual, decision));
+    assert(decision.x == expected.x && decision.r == expected.r);
+    assert(decision.reason.find("Ponder: ") == 0);
+    assert(ponderer.get_stats().hits == 1);
+    assert(!ponderer.is_pondering());
+
+    std::cout << "✅ Ponder hit test passed" << std::endl;
+}
+
+void test_ponder_miss() {
+    std::cout << "Testing ponder miss..." << std::endl;
+
+    ChainSearchAI ai;
+    assert(ai.initialize());
+
+    Field own;
+    Field opponent = make_opponent_field();
+    ai::GameState upcoming = make_upcoming(own, opponent);
+
+    Ponderer ponderer(ai);
+    ponderer.start(upcoming);
+
+    // 予想していない予告おじゃま数では使わない
+    ai::GameState actual = make_upcoming(own, opponent);
+    actual.garbage.pending = 99;
+
+    AIDecision decision;
+    assert(!ponderer.take(actual, decision));
+    assert(ponderer.get_stats().misses == 1);
+
+    // 中止後は通常どおり思考できる
+    decision = ai.think(actual);
+    assert(decision.x >= 0);
+
+    // 開始直後の中止
+    ponderer.start(upcoming);
+    ponderer.cancel();
+    assert(!ponderer.is_pondering());
+
+    std::cout << "✅ Ponder miss test passed" << std::endl;
+}
+
+// 反復回数とシードを固定したMCTS（同じ探索情報から同じ手を返す）
+AIParameters deterministic_mcts_params() {
+    AIParameters params;
+    params["think_time_limit"] = "10000";
+    params["max_iterations"] = "2000";
+    params["parallel.num_threads"] = "1";
+    params["seed"] = "34";
+    params["opening_book.enabled"] = "false";
+    return params;
+}
+
+void test_ponder_matches_foreground() {
+    std::cout << "Testing ponder hit against foreground search..." << std::endl;
+
+    // 前の手番の思考で探索木を保持した状態から、次の手番を先読みする場合と手番中に思考する場合を比べる
+    MCTSAI foreground(deterministic_mcts_params());
+    MCTSAI pondering(deterministic_mcts_params());
+    assert(foreground.initialize() && pondering.initialize());
+
+    Field before;
+    Field opponent = make_opponent_field();
+    ai::GameState previous = make_upcoming(before, opponent);
+    AIDecision first = foreground.think(previous);
+    AIDecision first_again = pondering.think(previous);
+    assert(first.x == first_again.x && first.r == first_again.r);
+
+    // 前の手番の手を置いた盤面・ツモが1つ進んだ状態
+    BitField placed = BitField::from_field(before);
+    placed.place_and_simulate(first.x, first.r, previous.current_pair.axis, previous.current_pair.child);
+    Field own = placed.to_field();
+    ai::GameState upcoming = make_upcoming(own, opponent);
+    upcoming.current_pair = previous.next_queue[0];
+    upcoming.next_queue = {previous.next_queue[1], PuyoPair(PuyoColor::BLUE, PuyoColor::GREEN)};
+
+    AIDecision expected = foreground.think(upcoming);
+    size_t expected_reused = foreground.get_last_reused_nodes();
+    assert(expected_reused > 0);
+
+    AIDecision decision;
+    {
+        Ponderer ponderer(pondering);
+        ponderer.start(upcoming);
+        wait_until_pondered(ponderer);
+        assert(ponderer.take(upcoming, decision));
+        assert(decision.x == expected.x && decision.r == expected.r);
+        assert(ponderer.get_stats().searched >= 1);
+    }
+
+    // 一致した局面の思考後の探索木がAIに戻るので、次の手番も同じ手になる
+    BitField next_placed = BitField::from_field(own);
+    next_placed.place_and_simulate(expected.x, expected.r, upcoming.current_pair.axis, upcoming.current_pair.child);
+    Field next_own = next_placed.to_field();
+    ai::GameState next = make_upcoming(next_own, opponent);
+    next.current_pair = upcoming.next_queue[0];
+    next.next_queue = {upcoming.next_queue[1], PuyoPair(PuyoColor::RED, PuyoColor::RED)};
+    AIDecision next_expected = foreground.think(next);
+    AIDecision next_decision = pondering.think(next);
+    assert(next_decision.x == next_expected.x && next_decision.r == next_expected.r);
+    assert(pondering.get_last_reused_nodes() == foreground.get_last_reused_nodes());
+
+    // 外れた場合は退避した探索木が戻り、手番中の思考は先読みしなかった場合と同じになる
+    MCTSAI missed(deterministic_mcts_params());
+    assert(missed.initialize());
+    missed.think(previous);
+    {
+        Ponderer ponderer(missed);
+        ai::GameState wrong = upcoming;
+        wrong.garbage.pending = 99;
+        ponderer.start(wrong);
+        assert(!ponderer.take(upcoming, decision));
+    }
+    AIDecision after_miss = missed.think(upcoming);
+    assert(after_miss.x == expected.x && after_miss.r == expected.r);
+    assert(missed.get_last_reused_nodes() == expected_reused);
+
+    std::cout << "✅ Ponder hit against foreground search test passed" << std::endl;
+}
+
+// GameManagerのプレイヤーの次の手番の局面（ツモはNextGeneratorから取る）
+ai::GameState make_player_state(GameManager& manager, int player_id) {
+    Player* player = manager.get_player(player_id);
+    Player* opponent = manager.get_player(1 - player_id);
+    ai::GameState state;
+    state.player_id = player_id;
+    state.is_versus_mode = true;
+    state.own_field = &player->get_field();
+    state.opponent_field = &opponent->get_field();
+    state.current_pair = player->get_next_generator().get_current_pair();
+    state.next_queue = {player->get_next_generator().get_next_pair(1),
+                        player->get_next_generator().get_next_pair(2)};
+    state.garbage.pending = player->get_garbage_system().get_pending_garbage_count();
+    return state;
+}
+
+void test_ponder_game_manager_turns() {
+    std::cout << "Testing ponder driven by GameManager turns..." << std::endl;
+
+    GameManager manager(GameMode::VERSUS);
+    manager.add_player("Ponder", PlayerType::AI);
+    manager.add_player("Plain", PlayerType::AI);
+    manager.start_game();
+
+    ChainSearchAI ais[2];
+    assert(ais[0].initialize() && ais[1].initialize());
+    Ponderer ponderer(ais[0]);
+
+    // 手番を相手へ渡す時に先読みを始め、次の手番の入力の前に結果を受け取る
+    bool pondering = false;
+    std::deque<MoveCommand> commands[2];
+    manager.set_turn_end_callback([&](int player_id) {
+        commands[player_id].clear();
+        if (player_id != 0) return;
+        ponderer.start(make_player_state(manager, 0));
+        pondering = true;
+    });
+
+    manager.set_input_callback([&](int player_id) {
+        if (commands[player_id].empty()) {
+            ai::GameState state = make_player_state(manager, player_id);
+            AIDecision decision;
+            bool hit = false;
+            if (player_id == 0 && pondering) {
+                // 相手の手番の間に先読みが終わっている状況を作る
+                wait_until_pondered(ponderer);
+                hit = ponderer.take(state, decision);
+                pondering = false;
+            }
+            if (!hit) {
+                decision = ais[player_id].think(state);
+            }
+            assert(state.own_field->can_place(decision.x, decision.r));
+            commands[player_id].assign(decision.move_commands.begin(), decision.move_commands.end());
+            if (commands[player_id].empty()) commands[player_id].push_back(MoveCommand::DROP);
+        }
+        // DROPは1段ずつ落とすので、設置されるまで返し続ける
+        MoveCommand command = commands[player_id].front();
+        if (command != MoveCommand::DROP) commands[player_id].pop_front();
+        return command;
+    });
+
+    // 入力は毎回コマンドを返すので、各ステップは入力待ちで止まらない
+    while (manager.get_state() == puyo::GameState::PLAYING && manager.get_turn_count() < 10) {
+        manager.execute_step();
+    }
+    assert(manager.get_turn_count() >= 10);
+
+    // 自分の手番ごとに先読みし、相手が連鎖していなければ結果をそのまま使える
+    Ponderer::Stats stats = ponderer.get_stats();
+    assert(stats.started >= 4);
+    assert(stats.hits + stats.misses == stats.started || stats.hits + stats.misses == stats.started - 1);
+    assert(stats.hits > 0);
+
+    std::cout << "✅ Ponder driven by GameManager turns test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Ponderer Tests ===" << std::endl;
+
+    test_pending_outcomes();
+    test_ponder_hit();
+    test_ponder_miss();
+    test_ponder_matches_foreground();
+    test_ponder_game_manager_turns();
+
+    std::cout << "\n🎉 All ponderer tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "../cpp/ai/portfolio_ai.h"
+#include "../cpp/ai/chain_search_ai.h"
+#include "../cpp/ai/mcts_ai.h"
+#include "../cpp/ai/random_ai.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+// テスト用の子AI生成（AIManagerの代わり）
+std::unique_ptr<AIBase> create_member(const std::string& name, const AIParameters& params) {
+    if (name == "chain_search") return std::make_unique<ChainSearchAI>(params);
+    if (name == "mcts") return std::make_unique<MCTSAI>(params);
+    if (name == "random") return std::make_unique<RandomAI>(params);
+    return nullptr;
+}
+
+AIParameters make_params(const std::string& policy) {
+    AIParameters params;
+    params["policy"] = policy;
+    params["think_time_limit"] = "150";
+    params["members"] = "chain_a, chain_b, tree, unknown";
+    params["chain_a.type"] = "chain_search";
+    params["chain_b.type"] = "chain_search";
+    params["chain_b.params"] = "evaluation_weights.chain_trigger=40.0; think_time_limit=1000";
+    params["tree.type"] = "mcts";
+    params["tree.weight"] = "0.5";
+    params["tree.params"] = "think_time_limit=1000; parallel.num_threads=2";
+    params["unknown.type"] = "no_such_ai";
+    return params;
+}
+
+void test_policies() {
+    std::cout << "Testing portfolio policies..." << std::endl;
+
+    Field field;
+    field.set_puyo(Position(0, 0), PuyoColor::RED);
+    field.set_puyo(Position(0, 1), PuyoColor::RED);
+    field.set_puyo(Position(0, 2), PuyoColor::RED);
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::GREEN);
+    state.next_queue = {PuyoPair(PuyoColor::BLUE, PuyoColor::BLUE)};
+
+    for (const std::string policy : {"vote", "max_confidence", "arbiter"}) {
+        PortfolioAI portfolio(make_params(policy), create_member);
+        assert(portfolio.member_count() == 3);  // 未知のAIは除外
+        assert(portfolio.initialize());
+
+        // 子AIの思考時間（1秒）ではなく全体の締め切りで打ち切る
+        auto start = std::chrono::steady_clock::now();
+        AIDecision decision = portfolio.think(state);
+        double elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        assert(field.can_place(decision.x, decision.r));
+        assert(elapsed_ms < 600.0);
+        assert(decision.reason.find("Portfolio[policy=" + policy) == 0);
+        assert(portfolio.get_debug_info().find("unknown=skipped") != std::string::npos);
+        portfolio.shutdown();
+    }
+
+    std::cout << "✅ Portfolio policies test passed" << std::endl;
+}
+
+void test_cancellation() {
+    std::cout << "Testing portfolio cancellation..." << std::endl;
+
+    Field field;
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::YELLOW, PuyoColor::GREEN);
+
+    PortfolioAI portfolio(make_params("vote"), create_member);
+    assert(portfolio.initialize());
+
+    // 中止要求は子AIへ伝わり、すぐに有効な手を返す
+    CancellationToken token;
+    token.cancel();
+    auto start = std::chrono::steady_clock::now();
+    AIDecision decision = portfolio.think_until(state, Deadline::none(), token);
+    double elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    assert(field.can_place(decision.x, decision.r));
+    assert(elapsed_ms < 100.0);
+
+    std::cout << "✅ Portfolio cancellation test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== PortfolioAI Tests ===" << std::endl;
+
+    test_policies();
+    test_cancellation();
+
+    std::cout << "\n🎉 All portfolio AI tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "../cpp/ai/q_table.h"
+#include "../cpp/ai/rl_player_ai.h"
+#include "../cpp/core/field.h"
+#include <iostream>
+#include <cassert>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+void test_insert_and_find() {
+    std::cout << "Testing Q-table insert and find..." << std::endl;
+
+    QTable table(16);
+    assert(table.empty());
+    assert(table.find(42) == nullptr);
+    assert(table.get(42, 0) == 0.0);
+
+    QRow& row = table.get_or_insert(42);
+    row[3].q_value = 1.5;
+    row[3].visit_count = 2;
+    assert(table.size() == 1);
+    assert(table.get(42, 3) == 1.5);
+    assert(table.get(42, 4) == 0.0);
+    assert(table.get(42, -1) == 0.0);
+    assert(table.get(42, PLACEMENT_COUNT) == 0.0);
+
+    // 同じキーは同じ行
+    assert(&table.get_or_insert(42) == table.find(42));
+    assert(table.size() == 1);
+
+    std::cout << "✅ Q-table insert and find test passed" << std::endl;
+}
+
+void test_growth() {
+    std::cout << "Testing Q-table growth..." << std::endl;
+
+    QTable table(16);
+    const uint64_t count = 5000;
+    for (uint64_t key = 0; key < count; ++key) {
+        table.get_or_insert(key * 7919)[key % PLACEMENT_COUNT].q_value = static_cast<double>(key);
+    }
+    assert(table.size() == count);
+    assert(table.size() <= table.capacity() * QTable::MAX_LOAD_FACTOR);
+
+    // 拡張後も全ての行が残っている
+    for (uint64_t key = 0; key < count; ++key) {
+        assert(table.get(key * 7919, static_cast<int>(key % PLACEMENT_COUNT)) == static_cast<double>(key));
+    }
+
+    size_t visited = 0;
+    table.for_each([&visited](uint64_t, const QRow&) { visited++; });
+    assert(visited == count);
+
+    table.clear();
+    assert(table.empty());
+    assert(table.find(7919) == nullptr);
+
+    std::cout << "✅ Q-table growth test passed" << std::endl;
+}
+
+void test_state_key() {
+    std::cout << "Testing packed state key..." << std::endl;
+
+    RLState state;
+    assert(state.pack_key() == 0);
+
+    // 列2に高さ3、列5に高さ1
+    for (int y = 0; y < 3; ++y) {
+        state.field_state[y * FIELD_WIDTH + 2] = static_cast<int>(PuyoColor::RED);
+    }
+    state.field_state[0 * FIELD_WIDTH + 5] = static_cast<int>(PuyoColor::BLUE);
+    state.current_colors[0] = static_cast<int>(PuyoColor::GREEN);
+    state.current_colors[1] = static_cast<int>(PuyoColor::YELLOW);
+
+    uint64_t key = state.pack_key();
+    assert(((key >> (2 * 4)) & 0xF) == 3);
+    assert(((key >> (5 * 4)) & 0xF) == 1);
+    assert(((key >> 24) & 0x7) == static_cast<uint64_t>(PuyoColor::GREEN));
+    assert(((key >> 27) & 0x7) == static_cast<uint64_t>(PuyoColor::YELLOW));
+    assert(key != QTable::EMPTY_KEY);
+
+    // 高さと色が同じなら色の配置が違っても同じキー
+    RLState other = state;
+    other.field_state[1 * FIELD_WIDTH + 2] = static_cast<int>(PuyoColor::BLUE);
+    assert(other.pack_key() == key);
+
+    std::cout << "✅ Packed state key test passed" << std::endl;
+}
+
+void test_rl_player_learning() {
+    std::cout << "Testing RLPlayerAI Q updates..." << std::endl;
+
+    RLPlayerAI ai;
+    Field field;
+    field.set_puyo(Position(0, 0), PuyoColor::RED);
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::RED);
+
+    // 高い報酬を与えた配置のQ値が上がる
+    for (int i = 0; i < 10; ++i) {
+        ai.provide_feedback(state, {0, 0}, 1000.0);
+    }
+    assert(ai.get_debug_info().find("states=1") != std::string::npos);
+    assert(ai.get_debug_info().find("games=10") != std::string::npos);
+
+    std::cout << "✅ RLPlayerAI Q update test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Q-Table Tests ===" << std::endl;
+
+    test_insert_and_find();
+    test_growth();
+    test_state_key();
+    test_rl_player_learning();
+
+    std::cout << "🎉 All Q-table tests passed!" << std::endl;
+    return 0;
+}
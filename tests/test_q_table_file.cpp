@@ -0,0 +1,237 @@
+#include "../cpp/ai/q_table_file.h"
+#include "../cpp/ai/rl_player_ai.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+const char* TEST_PATH = "test_q_table_file.bin";
+
+QTable make_table(uint64_t count) {
+    QTable table(16);
+    for (uint64_t key = 1; key <= count; ++key) {
+        QRow& row = table.get_or_insert(key * 2654435761ULL);
+        row[key % PLACEMENT_COUNT] = QEntry(static_cast<double>(key) * 0.5, static_cast<int>(key));
+    }
+    return table;
+}
+
+long file_size(const char* path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return static_cast<long>(file.tellg());
+}
+
+void test_round_trip() {
+    std::cout << "Testing Q-table file round trip..." << std::endl;
+
+    QTable table = make_table(3000);
+    // 削除済みの古い行が残っても同じファイルになる
+    QTable cleared = make_table(50);
+    cleared.clear();
+
+    std::string error;
+    assert(QTableFile::write(TEST_PATH, table, &error));
+    assert(file_size(TEST_PATH) ==
+           static_cast<long>(sizeof(QTableFile::Header) + table.capacity() * sizeof(QTable::Slot)));
+
+    QTable loaded;
+    assert(QTableFile::read(TEST_PATH, loaded, &error));
+    assert(loaded.size() == table.size());
+    assert(loaded.capacity() == table.capacity());
+    for (uint64_t key = 1; key <= 3000; ++key) {
+        const QRow* row = loaded.find(key * 2654435761ULL);
+        assert(row);
+        assert((*row)[key % PLACEMENT_COUNT].q_value == static_cast<double>(key) * 0.5);
+        assert((*row)[key % PLACEMENT_COUNT].visit_count == static_cast<int>(key));
+    }
+    // 読み込んだ表にもそのまま追加できる
+    loaded.get_or_insert(7)[0].q_value = 1.0;
+    assert(loaded.get(7, 0) == 1.0);
+
+    assert(QTableFile::write(TEST_PATH, cleared, &error));
+    assert(QTableFile::read(TEST_PATH, loaded, &error));
+    assert(loaded.empty());
+
+    std::cout << "✅ Q-table file round trip test passed" << std::endl;
+}
+
+void test_mapped_lookup() {
+    std::cout << "Testing memory-mapped Q-table..." << std::endl;
+
+    QTable table = make_table(1000);
+    assert(QTableFile::write(TEST_PATH, table));
+
+    MappedQTable mapped;
+    std::string error;
+    assert(mapped.open(TEST_PATH, true, &error));
+    assert(mapped.is_open());
+    assert(mapped.size() == 1000);
+    assert(mapped.capacity() == table.capacity());
+    for (uint64_t key = 1; key <= 1000; ++key) {
+        assert(mapped.get(key * 2654435761ULL, static_cast<int>(key % PLACEMENT_COUNT)) == static_cast<double>(key) * 0.5);
+    }
+    assert(mapped.find(12345) == nullptr);
+    assert(mapped.find(QTable::EMPTY_KEY) == nullptr);
+    assert(mapped.get(2654435761ULL, -1) == 0.0);
+
+    mapped.close();
+    assert(!mapped.is_open());
+    assert(mapped.find(2654435761ULL) == nullptr);
+
+    std::cout << "✅ Memory-mapped Q-table test passed" << std::endl;
+}
+
+void test_corruption_detection() {
+    std::cout << "Testing Q-table file validation..." << std::endl;
+
+    QTable table = make_table(100);
+    assert(QTableFile::write(TEST_PATH, table));
+    long size = file_size(TEST_PATH);
+
+    // 1バイト書き換えるとチェックサムで検出
+    {
+        std::fstream file(TEST_PATH, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(size / 2);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte ^= 0x40;
+        file.seekp(size / 2);
+        file.write(&byte, 1);
+    }
+    QTable loaded = make_table(5);
+    std::string error;
+    assert(!QTableFile::read(TEST_PATH, loaded, &error));
+    assert(error.find("checksum") != std::string::npos);
+    assert(loaded.size() == 5);   // 失敗時は元の表を変更しない
+
+    MappedQTable mapped;
+    assert(mapped.open(TEST_PATH));          // 検証なしなら開ける
+    assert(!mapped.open(TEST_PATH, true, &error));
+    assert(!mapped.is_open());
+
+    // 途中で切れたファイル
+    assert(QTableFile::write(TEST_PATH, table));
+    {
+        std::ifstream in(TEST_PATH, std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(TEST_PATH, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size() - 100));
+    }
+    assert(!QTableFile::read(TEST_PATH, loaded, &error));
+    assert(error.find("truncated") != std::string::npos);
+    assert(!mapped.open(TEST_PATH, false, &error));
+
+    // 存在しないファイル・別形式のファイル
+    assert(!QTableFile::read("no_such_q_table.bin", loaded, &error));
+    {
+        std::ofstream out(TEST_PATH, std::ios::binary | std::ios::trunc);
+        out << "not a model file, but long enough to hold a header..................";
+    }
+    assert(!QTableFile::read(TEST_PATH, loaded, &error));
+    assert(!mapped.open(TEST_PATH, false, &error));
+
+    std::remove(TEST_PATH);
+    std::cout << "✅ Q-table file validation test passed" << std::endl;
+}
+
+void test_legacy_format() {
+    std::cout << "Testing legacy Q-table format..." << std::endl;
+
+    // バージョン1: "PUYOQT01" + 状態数 + (キー + 22 × (Q値, 訪問回数))
+    {
+        std::ofstream out(TEST_PATH, std::ios::binary | std::ios::trunc);
+        out.write("PUYOQT01", 8);
+        uint64_t count = 1;
+        uint64_t key = 99;
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            double q = i;
+            int visits = i * 2;
+            out.write(reinterpret_cast<const char*>(&q), sizeof(q));
+            out.write(reinterpret_cast<const char*>(&visits), sizeof(visits));
+        }
+    }
+    QTable loaded;
+    assert(QTableFile::read(TEST_PATH, loaded));
+    assert(loaded.size() == 1);
+    assert(loaded.get(99, 5) == 5.0);
+    assert(loaded.find(99)->at(5).visit_count == 10);
+
+    std::remove(TEST_PATH);
+    std::cout << "✅ Legacy Q-table format test passed" << std::endl;
+}
+
+void test_rl_player_mapped_model() {
+    std::cout << "Testing RLPlayerAI mapped model..." << std::endl;
+
+    RLPlayerAI trainer;
+    trainer.set_model_path(TEST_PATH);
+    Field field;
+    ai::GameState state;
+    state.own_field = &field;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::GREEN);
+    trainer.provide_feedback(state, {1, 0}, 500.0);
+    assert(trainer.save_model());
+
+    // mmapしたモデルで同じ状態を引ける
+    RLPlayerAI server;
+    server.set_model_path(TEST_PATH);
+    server.set_mmap_model(true);
+    assert(server.load_model());
+    assert(server.is_model_mapped());
+    assert(server.get_debug_info().find("states=0") != std::string::npos);
+
+    // mmap中に学習した分は元のファイルを書き換えず<model>.overlayへ保存する
+    std::ifstream original(TEST_PATH, std::ios::binary);
+    std::string original_bytes((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+    original.close();
+    state.current_pair = PuyoPair(PuyoColor::BLUE, PuyoColor::YELLOW);
+    server.provide_feedback(state, {3, 0}, 800.0);
+    assert(server.get_q_table().size() == 1);
+    assert(server.save_model());
+    std::ifstream saved(TEST_PATH, std::ios::binary);
+    assert(std::string((std::istreambuf_iterator<char>(saved)), std::istreambuf_iterator<char>()) == original_bytes);
+    saved.close();
+    assert(std::ifstream(server.overlay_path()).good());
+
+    // mmapしても一括読み込みしてもoverlayを重ねて読む
+    RLPlayerAI reopened;
+    reopened.set_model_path(TEST_PATH);
+    reopened.set_mmap_model(true);
+    assert(reopened.load_model());
+    assert(reopened.get_q_table().size() == 1);
+
+    RLPlayerAI bulk;
+    bulk.set_model_path(TEST_PATH);
+    assert(bulk.load_model());
+    assert(bulk.get_q_table().size() == trainer.get_q_table().size() + 1);
+
+    // 表全体を保存すればoverlayは不要になり消える
+    assert(bulk.save_model());
+    assert(!std::ifstream(bulk.overlay_path()).good());
+    RLPlayerAI merged;
+    merged.set_model_path(TEST_PATH);
+    assert(merged.load_model());
+    assert(merged.get_q_table().size() == bulk.get_q_table().size());
+
+    std::remove(TEST_PATH);
+    std::cout << "✅ RLPlayerAI mapped model test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Q-Table File Tests ===" << std::endl;
+
+    test_round_trip();
+    test_mapped_lookup();
+    test_corruption_detection();
+    test_legacy_format();
+    test_rl_player_mapped_model();
+
+    std::cout << "🎉 All Q-table file tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include "../cpp/ai/q_cold_store.h"
+#include "../cpp/ai/rl_player_ai.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+const char* COLD_PATH = "test_q_table_cold.bin";
+
+void test_half_conversion() {
+    std::cout << "Testing float16 conversion..." << std::endl;
+
+    // 正確に表せる値はそのまま戻る
+    for (float value : {0.0f, 1.0f, -2.5f, 0.5f, 1024.0f, 65504.0f, -0.000060975552f}) {
+        assert(half_to_float(float_to_half(value)) == value);
+    }
+    assert(float_to_half(1.0f) == 0x3C00);
+    assert(float_to_half(-2.0f) == 0xC000);
+    assert(float_to_half(65504.0f) == 0x7BFF);
+
+    // 丸め誤差は相対2^-11以内
+    for (float value : {3.14159f, -123.456f, 0.001f, 200.0f, -99.99f}) {
+        float restored = half_to_float(float_to_half(value));
+        assert(std::fabs(restored - value) <= std::fabs(value) / 2048.0f);
+    }
+
+    // 最近接偶数丸め（1 + 2^-11は1に、1 + 3 × 2^-11は1 + 2^-9に）
+    assert(float_to_half(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);
+    assert(float_to_half(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3C02);
+
+    // 範囲外・特殊値・非正規化数
+    assert(float_to_half(1e6f) == 0x7C00);
+    assert(float_to_half(-1e6f) == 0xFC00);
+    assert(std::isinf(half_to_float(float_to_half(std::numeric_limits<float>::infinity()))));
+    assert(std::isnan(half_to_float(float_to_half(std::numeric_limits<float>::quiet_NaN()))));
+    assert(half_to_float(0x0001) == std::ldexp(1.0f, -24));
+    assert(float_to_half(std::ldexp(1.0f, -24)) == 0x0001);
+    assert(float_to_half(1e-10f) == 0x0000);
+
+    std::cout << "✅ float16 conversion test passed" << std::endl;
+}
+
+void test_eviction_order() {
+    std::cout << "Testing Q-table eviction..." << std::endl;
+
+    QTable table(16);
+    for (uint64_t key = 1; key <= 100; ++key) {
+        QRow& row = table.get_or_insert(key);
+        row[0] = QEntry(static_cast<double>(key % 10), static_cast<int>(key / 10));
+    }
+
+    // 訪問回数の少ない状態から、同数ならQ値の絶対値の小さい状態から追い出す
+    std::vector<uint64_t> evicted;
+    size_t capacity = table.capacity();
+    size_t count = table.evict(15, [&](uint64_t key, const QRow&) { evicted.push_back(key); });
+    assert(count == 15);
+    assert(evicted.size() == 15);
+    for (uint64_t key : evicted) {
+        assert(key / 10 == 0 || (key / 10 == 1 && key % 10 <= 5));
+        assert(!table.find(key));
+    }
+    assert(table.size() == 85);
+    assert(table.capacity() == capacity);
+    for (uint64_t key = 16; key <= 100; ++key) {
+        assert(table.get(key, 0) == static_cast<double>(key % 10));
+    }
+    // 追い出した後も追加・検索できる
+    table.get_or_insert(1)[1].q_value = 7.0;
+    assert(table.get(1, 1) == 7.0);
+
+    assert(table.evict(1000, [](uint64_t, const QRow&) {}) == 86);
+    assert(table.empty());
+
+    std::cout << "✅ Q-table eviction test passed" << std::endl;
+}
+
+QRow make_row(double base, int visits) {
+    QRow row;
+    for (int a = 0; a < PLACEMENT_COUNT; ++a) {
+        row[a] = QEntry(base + a * 0.25, visits + a);
+    }
+    return row;
+}
+
+void test_cold_store() {
+    std::cout << "Testing Q-table cold tier..." << std::endl;
+
+    for (bool half : {false, true}) {
+        std::remove(COLD_PATH);
+        std::string error;
+        {
+            QColdStore store;
+            assert(store.open(COLD_PATH, half, &error));
+            assert(store.half_precision() == half);
+            for (uint64_t key = 1; key <= 3000; ++key) {
+                assert(store.append(key * 977, make_row(static_cast<double>(key), static_cast<int>(key))));
+            }
+            // 同じキーを書き直すと新しいレコードが有効になる
+            assert(store.append(977, make_row(-5.0, 1)));
+            assert(store.size() == 3000);
+            assert(store.record_count() == 3001);
+
+            QRow row;
+            assert(store.read(977 * 1234, row));
+            assert(row[4].q_value == 1235.0);
+            assert(row[4].visit_count == 1238);
+            assert(store.read(977, row));
+            assert(row[0].q_value == -5.0);
+            assert(!store.read(12345, row));
+            assert(!store.contains(12345));
+        }
+        assert(static_cast<size_t>(std::filesystem::file_size(COLD_PATH)) ==
+               24 + 3001 * (8 + PLACEMENT_COUNT * ((half ? 2 : 8) + 4)));
+
+        // 書きかけのレコードを足しても、開き直すと切り捨てて索引を作り直す
+        {
+            std::ofstream file(COLD_PATH, std::ios::binary | std::ios::app);
+            file.write("partial", 7);
+        }
+        QColdStore reopened;
+        assert(reopened.open(COLD_PATH, !half, &error));
+        assert(reopened.half_precision() == half);   // 既存ファイルの精度を使う
+        assert(reopened.size() == 3000);
+        QRow row;
+        assert(reopened.read(977, row));
+        assert(row[0].q_value == -5.0);
+        assert(reopened.read(977 * 2999, row));
+        assert(std::fabs(row[1].q_value - 2999.25) <= (half ? 2.0 : 0.0));
+        assert(reopened.append(42, make_row(1.0, 1)));
+        assert(reopened.read(42, row) && row[0].q_value == 1.0);
+    }
+
+    // 別形式のファイルは開かない
+    {
+        std::ofstream file(COLD_PATH, std::ios::binary | std::ios::trunc);
+        file << "not a cold tier file at all";
+    }
+    QColdStore invalid;
+    std::string error;
+    assert(!invalid.open(COLD_PATH, true, &error));
+    assert(!error.empty());
+
+    std::remove(COLD_PATH);
+    std::cout << "✅ Q-table cold tier test passed" << std::endl;
+}
+
+// 列ごとの高さで状態を作る（状態キーは高さとぷよペアの色で決まる）
+Field make_field(int index) {
+    Field field;
+    for (int x = 0; x < 3; ++x) {
+        int height = (index >> (x * 3)) & 7;
+        for (int y = 0; y < height; ++y) {
+            field.set_puyo(Position(x, y), static_cast<PuyoColor>(1 + (x + y) % 4));
+        }
+    }
+    return field;
+}
+
+void test_rl_player_memory_cap() {
+    std::cout << "Testing RLPlayerAI memory cap..." << std::endl;
+
+    std::remove(COLD_PATH);
+    RLPlayerAI ai;
+    assert(ai.set_memory_limit(100, 0.2, COLD_PATH));
+    ai::GameState state;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::GREEN);
+
+    // 上限を超えると80件まで減らし、追い出した状態は退避先に残る
+    std::vector<Field> fields;
+    for (int i = 0; i < 400; ++i) {
+        fields.push_back(make_field(i));
+    }
+    for (int i = 0; i < 400; ++i) {
+        state.own_field = &fields[i];
+        ai.provide_feedback(state, {2, 0}, 100.0);
+        assert(ai.get_q_table().size() <= 100);
+    }
+    assert(ai.get_evicted_states() >= 300);
+    assert(ai.get_cold_store().size() >= 300);
+    assert(ai.get_q_table().capacity() == QTable().capacity());   // 初期容量から拡張しない
+    assert(ai.get_debug_info().find("evicted=") != std::string::npos);
+    assert(ai.get_debug_info().find("cold=") != std::string::npos);
+
+    // 退避した状態を更新すると値を引き継いで表に戻る
+    state.own_field = &fields[0];
+    ai.provide_feedback(state, {2, 0}, 100.0);
+    RLState encoded;
+    for (int y = 0; y < FIELD_HEIGHT; ++y) {
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            encoded.field_state[y * FIELD_WIDTH + x] = static_cast<int>(fields[0].get_puyo(Position(x, y)));
+        }
+    }
+    encoded.current_colors[0] = static_cast<int>(PuyoColor::RED);
+    encoded.current_colors[1] = static_cast<int>(PuyoColor::GREEN);
+    const QRow* row = ai.get_q_table().find(encoded.pack_key());
+    assert(row);
+    assert((*row)[placement_index(2, 0)].visit_count == 2);
+
+    // 上限なしに戻すと追い出さない
+    assert(ai.set_memory_limit(0));
+    size_t evicted = ai.get_evicted_states();
+    for (int i = 0; i < 400; ++i) {
+        state.own_field = &fields[i];
+        ai.provide_feedback(state, {3, 0}, 100.0);
+    }
+    assert(ai.get_evicted_states() == evicted);
+    assert(ai.get_q_table().size() == 400);
+
+    std::remove(COLD_PATH);
+    std::cout << "✅ RLPlayerAI memory cap test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Q-Table Memory Tests ===" << std::endl;
+
+    test_half_conversion();
+    test_eviction_order();
+    test_cold_store();
+    test_rl_player_memory_cap();
+
+    std::cout << "🎉 All Q-table memory tests passed!" << std::endl;
+    return 0;
+}
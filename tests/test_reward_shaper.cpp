@@ -0,0 +1,242 @@
+#include "../cpp/ai/reward_shaper.h"
+#include "../cpp/ai/vec_env.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+const char* CONFIG_PATH = "test_reward_shaper.yaml";
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+void test_nested_config() {
+    std::cout << "Testing nested YAML sections..." << std::endl;
+
+    {
+        std::ofstream file(CONFIG_PATH);
+        file << "top: 1\n"
+                "rewards:\n"
+                "  chain_rewards:\n"
+                "    1: 3.0    # 1連鎖\n"
+                "    3: 30.0\n"
+                "  score_multiplier: 0.01\n"
+                "  high_field_height: 8\n"
+                "\n"
+                "learning:\n"
+                "  learning_rate: 0.5\n";
+    }
+    auto config = ConfigLoader::load_config(CONFIG_PATH);
+    assert(ConfigLoader::get_double(config, "rewards.chain_rewards.1") == 3.0);
+    assert(ConfigLoader::get_double(config, "rewards.chain_rewards.3") == 30.0);
+    // 入れ子のセクションを閉じた後は元のセクションに戻る
+    assert(ConfigLoader::get_double(config, "rewards.score_multiplier") == 0.01);
+    assert(ConfigLoader::get_double(config, "learning.learning_rate") == 0.5);
+    assert(ConfigLoader::get_int(config, "top") == 1);
+    assert(!config.count("rewards.1"));
+
+    // 設定の無い連鎖数は、それ以下で最大の設定値（既定値のうち上書きされなかったものも残る）
+    RewardShaper shaper = RewardShaper::from_config(config);
+    assert(shaper.chain_reward(0, 1000) == 0.0);
+    assert(near(shaper.chain_reward(1, 40), 3.0 + 0.4));
+    assert(near(shaper.chain_reward(2, 0), 15.0));
+    assert(near(shaper.chain_reward(3, 0), 30.0));
+    assert(near(shaper.chain_reward(4, 0), 100.0));
+    assert(near(shaper.chain_reward(12, 0), 200.0));
+    assert(near(shaper.chain_reward(40, 0), 200.0));
+    assert(shaper.weights().high_field_height == 8);
+
+    // リポジトリの設定ファイルのchain_rewardsが読めている
+    RewardShaper repo = RewardShaper::from_file("config/ai_params/rl_player.yaml");
+    auto repo_config = ConfigLoader::load_config("config/ai_params/rl_player.yaml");
+    if (!repo_config.empty()) {
+        assert(repo_config.count("rewards.chain_rewards.5"));
+        assert(near(repo.chain_reward(5, 0), ConfigLoader::get_double(repo_config, "rewards.chain_rewards.5")));
+    }
+
+    std::remove(CONFIG_PATH);
+    std::cout << "✅ Nested YAML sections test passed" << std::endl;
+}
+
+void test_field_summary() {
+    std::cout << "Testing field summary..." << std::endl;
+
+    BitField field;
+    // 赤3連結（L字）、青2個の縦並び、緑1個
+    field.set_puyo(0, 0, PuyoColor::RED);
+    field.set_puyo(1, 0, PuyoColor::RED);
+    field.set_puyo(0, 1, PuyoColor::RED);
+    field.set_puyo(2, 0, PuyoColor::BLUE);
+    field.set_puyo(2, 1, PuyoColor::BLUE);
+    field.set_puyo(2, 2, PuyoColor::GREEN);
+
+    RLFieldSummary summary = RLFeatureExtractor::summarize(field);
+    assert(summary.adjacent_pairs == 3);
+    assert(summary.groups_3 == 1);
+    assert(summary.max_height == 3);
+
+    // 特徴抽出と同じ走査で同じ集計が得られる
+    RLFeatureExtractor extractor(false);
+    RLFeatureVector features;
+    RLFieldSummary from_extract;
+    extractor.extract(field, 0, features, &from_extract);
+    assert(from_extract.adjacent_pairs == summary.adjacent_pairs);
+    assert(from_extract.groups_3 == summary.groups_3);
+    assert(from_extract.max_height == summary.max_height);
+
+    std::cout << "✅ Field summary test passed" << std::endl;
+}
+
+void test_shape_terms() {
+    std::cout << "Testing reward shaping terms..." << std::endl;
+
+    RewardShaper::Weights weights;
+    RewardShaper shaper(weights);
+    RLFieldSummary before, after;
+    BitChainResult none;
+
+    // 同色隣接が2組、3連結が1つ増えた手
+    after.adjacent_pairs = 2;
+    after.groups_3 = 1;
+    after.max_height = 3;
+    assert(near(shaper.shape(before, after, none, false),
+                weights.puyo_placement + 2 * weights.color_grouping + weights.chain_building));
+
+    // 同色隣接が増えない手は無駄手
+    RLFieldSummary flat;
+    flat.max_height = 2;
+    assert(near(shaper.shape(before, flat, none, false), weights.puyo_placement + weights.waste_move));
+
+    // 連鎖した手は連鎖報酬のみ（連結の減少では罰しない）
+    BitChainResult chain;
+    chain.chain_count = 2;
+    chain.score = 360;
+    assert(near(shaper.shape(after, before, chain, false),
+                weights.puyo_placement + shaper.chain_reward(2, 360)));
+
+    // 高さと窒息
+    RLFieldSummary high = flat;
+    high.max_height = weights.high_field_height + 1;
+    assert(near(shaper.shape(before, high, none, true),
+                weights.puyo_placement + weights.waste_move + weights.high_field + weights.game_over));
+
+    std::cout << "✅ Reward shaping terms test passed" << std::endl;
+}
+
+void test_vec_env_shaping() {
+    std::cout << "Testing VecEnv reward shaping..." << std::endl;
+
+    VecEnv::Config config;
+    config.num_envs = 4;
+    config.seed = 9;
+    config.max_turns = 40;
+    config.reward_shaping = true;
+    VecEnv env(config);
+    VecEnv::Config plain_config = config;
+    plain_config.reward_shaping = false;
+    VecEnv plain(plain_config);
+
+    std::vector<uint8_t> obs(env.num_agents() * env.observation_size());
+    std::vector<float> rewards(env.num_agents()), plain_rewards(env.num_agents());
+    bool dones[4], truncated[4];
+    std::vector<int32_t> chains(env.num_agents());
+
+    // 同じ手で進め、整形した報酬を手の前後の盤面から求め直したものと比べる
+    env.reset(obs.data());
+    plain.reset(obs.data());
+    for (int step = 0; step < 200; ++step) {
+        std::vector<int32_t> actions(env.num_agents() * 2);
+        std::vector<BitField> before(env.num_agents());
+        std::vector<PuyoPair> pairs(env.num_agents());
+        std::vector<uint8_t> single(env.observation_size());
+        for (int agent = 0; agent < env.num_agents(); ++agent) {
+            const Placement& placement = PLACEMENTS[(step * 7 + agent * 3) % PLACEMENT_COUNT];
+            actions[agent * 2] = placement.x;
+            actions[agent * 2 + 1] = placement.r;
+            before[agent] = env.field(agent);
+            env.write_observation(agent, single.data());
+            pairs[agent] = PuyoPair(static_cast<PuyoColor>(single[VecEnv::FIELD_OBS]),
+                                    static_cast<PuyoColor>(single[VecEnv::FIELD_OBS + 1]));
+        }
+        env.step(actions.data(), obs.data(), rewards.data(), dones, truncated, chains.data());
+        plain.step(actions.data(), obs.data(), plain_rewards.data(), dones, truncated, chains.data());
+
+        for (int agent = 0; agent < env.num_agents(); ++agent) {
+            int x = actions[agent * 2], r = actions[agent * 2 + 1];
+            if (!before[agent].can_place(x, r)) {
+                assert(rewards[agent] == static_cast<float>(config.invalid_action_reward));
+                continue;
+            }
+            BitField after = before[agent];
+            BitChainResult result = after.place_and_simulate(x, r, pairs[agent].axis, pairs[agent].child);
+            double expected = config.shaper.shape(RLFeatureExtractor::summarize(before[agent]),
+                                                  RLFeatureExtractor::summarize(after), result, false);
+            if (after.is_game_over()) expected += config.shaper.game_over_reward();
+            assert(std::fabs(rewards[agent] - static_cast<float>(expected)) < 1e-3f);
+            // 整形しない環境は得点 × score_scale（窒息の手はgame_over_rewardも）
+            double plain_expected = result.score * config.score_scale +
+                                    (after.is_game_over() ? config.game_over_reward : 0.0);
+            assert(std::fabs(plain_rewards[agent] - static_cast<float>(plain_expected)) < 1e-3f);
+        }
+    }
+    assert(env.total_episodes() > 0);
+
+    std::cout << "✅ VecEnv reward shaping test passed" << std::endl;
+}
+
+void test_vec_env_versus_high_field() {
+    std::cout << "Testing VecEnv high_field after garbage drops..." << std::endl;
+
+    VecEnv::Config config;
+    config.num_envs = 1;
+    config.seed = 5;
+    config.mode = VecEnv::Mode::VERSUS;
+    config.reward_shaping = true;
+    RewardShaper::Weights weights;
+    weights.high_field_height = 2;
+    config.shaper = RewardShaper(weights);
+    VecEnv env(config);
+
+    std::vector<uint8_t> obs(env.num_agents() * env.observation_size());
+    std::vector<float> rewards(env.num_agents());
+    bool dones[2], truncated[2];
+    env.reset(obs.data());
+    PuyoPair pair(static_cast<PuyoColor>(obs[VecEnv::FIELD_OBS]), static_cast<PuyoColor>(obs[VecEnv::FIELD_OBS + 1]));
+
+    // 1列目に縦置き（高さ2）した後に6個降ると高さ3になり、降った後の盤面で高さの項がつく
+    env.pending_garbage(0) = 6;
+    int32_t actions[4] = {0, 0, 5, 0};
+    env.step(actions, obs.data(), rewards.data(), dones, truncated, nullptr);
+    assert(!dones[0]);
+
+    BitField placed;
+    BitChainResult result = placed.place_and_simulate(0, 0, pair.axis, pair.child);
+    RLFieldSummary empty = RLFeatureExtractor::summarize(BitField());
+    RLFieldSummary dropped = RLFeatureExtractor::summarize(env.field(0));
+    assert(RLFeatureExtractor::summarize(placed).max_height == 2);
+    assert(dropped.max_height > weights.high_field_height);
+    double expected = config.shaper.shape(empty, dropped, result, false);
+    assert(near(expected, config.shaper.shape(empty, RLFeatureExtractor::summarize(placed), result, false) +
+                              weights.high_field));
+    assert(std::fabs(rewards[0] - static_cast<float>(expected)) < 1e-3f);
+
+    std::cout << "✅ VecEnv high_field after garbage drops test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Reward Shaper Tests ===" << std::endl;
+
+    test_nested_config();
+    test_field_summary();
+    test_shape_terms();
+    test_vec_env_shaping();
+    test_vec_env_versus_high_field();
+
+    std::cout << "🎉 All reward shaper tests passed!" << std::endl;
+    return 0;
+}
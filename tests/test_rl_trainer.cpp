@@ -0,0 +1,371 @@
+#include "../cpp/ai/concurrent_q_table.h"
+#include "../cpp/ai/mpsc_queue.h"
+#include "../cpp/ai/rl_trainer.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+void test_mpsc_queue() {
+    std::cout << "Testing MPSC queue..." << std::endl;
+
+    MpscQueue<int> queue(3);
+    assert(queue.capacity() == 4);
+    int value = 0;
+    assert(!queue.try_pop(value));
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.try_push(i));
+    }
+    assert(!queue.try_push(4));   // 満杯
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.try_pop(value) && value == i);
+    }
+    assert(!queue.try_pop(value));
+
+    // 複数の生産者から送った値が欠けも重複もなく届く
+    const int producers = 4;
+    const int per_producer = 20000;
+    MpscQueue<int> shared(64);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&shared, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                while (!shared.try_push(p * per_producer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<int> last(producers, -1);
+    std::vector<char> seen(producers * per_producer, 0);
+    for (int received = 0; received < producers * per_producer;) {
+        if (!shared.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(!seen[value]);
+        seen[value] = 1;
+        // 生産者ごとの順序は保たれる
+        int producer = value / per_producer;
+        assert(value % per_producer > last[producer]);
+        last[producer] = value % per_producer;
+        received++;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(!shared.try_pop(value));
+
+    std::cout << "✅ MPSC queue test passed" << std::endl;
+}
+
+void test_concurrent_q_table() {
+    std::cout << "Testing concurrent Q table..." << std::endl;
+
+    ConcurrentQTable table(100);
+    assert(table.capacity() == 128);
+    assert(!table.find(42));
+    assert(table.get(42, 0) == 0.0);
+    ConcurrentQTable::Slot* slot = table.find_or_insert(42);
+    assert(slot && table.find(42) == slot && table.find_or_insert(42) == slot);
+    slot->q_values[3].store(-2.5f);
+    slot->q_values[5].store(1.5f);
+    assert(table.get(42, 3) == -2.5);
+    assert(table.max_q(42) == 1.5);
+    assert(table.max_q(7) == 0.0);
+    assert(!table.find_or_insert(QTable::EMPTY_KEY));
+
+    // 負荷率の上限を超える状態は追加しない
+    for (uint64_t key = 100; key < 300; ++key) {
+        table.find_or_insert(key);
+    }
+    assert(table.size() == static_cast<size_t>(128 * ConcurrentQTable::MAX_LOAD_FACTOR));
+    assert(!table.find_or_insert(1000));
+    assert(table.find(42) == slot);
+
+    // 複数スレッドから同じ状態群へ挿入・訪問回数を加算しても欠けも重複もない
+    const int threads = 4;
+    const int keys = 5000;
+    ConcurrentQTable shared(1 << 14);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&shared, t]() {
+            for (int i = 0; i < keys; ++i) {
+                uint64_t key = static_cast<uint64_t>((i * 7 + t * 13) % keys) * 2654435761ULL;
+                ConcurrentQTable::Slot* row = shared.find_or_insert(key);
+                row->visit_counts[t].fetch_add(1, std::memory_order_relaxed);
+                row->visit_counts[PLACEMENT_COUNT - 1].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    assert(shared.size() == static_cast<size_t>(keys));
+    QTable exported = shared.to_q_table();
+    assert(exported.size() == static_cast<size_t>(keys));
+    exported.for_each([&](uint64_t, const QRow& row) {
+        assert(row[PLACEMENT_COUNT - 1].visit_count == threads);
+        for (int t = 0; t < threads; ++t) {
+            assert(row[t].visit_count == 1);
+        }
+    });
+
+    // QTableとの相互変換
+    ConcurrentQTable imported(64);
+    QTable source;
+    source.get_or_insert(9)[2] = QEntry(0.75, 3);
+    assert(imported.import_from(source) == 0);
+    QTable round_trip = imported.to_q_table();
+    assert(round_trip.get(9, 2) == 0.75);
+    assert((*round_trip.find(9))[2].visit_count == 3);
+
+    std::cout << "✅ Concurrent Q table test passed" << std::endl;
+}
+
+void test_concurrent_update() {
+    std::cout << "Testing Hogwild Q update..." << std::endl;
+
+    RLPlayerAI ai;
+    ConcurrentQTable table(1024);
+    CompactExperience experience;
+    experience.state.current_pair = 0x21;
+    experience.next_state.current_pair = 0x32;
+    experience.action = 4;
+    experience.reward = 10.0f;
+    experience.terminal = 1;
+
+    // 終端: Q ← Q + lr × (r - Q)
+    assert(ai.update_concurrent(table, experience));
+    double lr_step = table.get(experience.state.state_key(), 4);
+    assert(lr_step > 0.0 && lr_step < 10.0);
+    ConcurrentQTable::Slot* slot = table.find(experience.state.state_key());
+    assert(slot->visit_counts[4].load() == 1);
+
+    // 非終端では次状態の最大Q値を割り引いて足す
+    table.find_or_insert(experience.next_state.state_key())->q_values[0].store(100.0f);
+    experience.terminal = 0;
+    experience.reward = 0.0f;
+    double before = table.get(experience.state.state_key(), 4);
+    assert(ai.update_concurrent(table, experience));
+    assert(table.get(experience.state.state_key(), 4) > before);
+    assert(slot->visit_counts[4].load() == 2);
+
+    // learnerの更新した行のキーを記録し、その行だけを共有Q表へ書き写す
+    std::vector<uint64_t> updated;
+    ai.set_updated_keys_log(&updated);
+    experience.terminal = 1;
+    experience.reward = 5.0f;
+    ai.train_on(experience);
+    ai.set_updated_keys_log(nullptr);
+    uint64_t key = experience.state.state_key();
+    assert(updated.size() == 1 && updated[0] == key);
+    ConcurrentQTable published(64);
+    assert(ai.publish_rows(updated, published) == 0);
+    assert(published.size() == 1);
+    assert(std::fabs(published.get(key, 4) - ai.get_q_table().get(key, 4)) < 1e-6);
+    assert(published.find(key)->visit_counts[4].load() == 1);
+    ai.train_on(experience);
+    assert(updated.size() == 1);
+
+    // εはrecord_rewardと同じく減衰し、下限で止まる
+    assert(ai.epsilon_after(0) == ai.get_epsilon());
+    assert(ai.epsilon_after(10) < ai.get_epsilon());
+    assert(ai.epsilon_after(1000000) > 0.0);
+    assert(std::fabs(ai.epsilon_after(1000000) - ai.epsilon_after(2000000)) < 1e-12);
+
+    std::cout << "✅ Hogwild Q update test passed" << std::endl;
+}
+
+void test_training_run() {
+    std::cout << "Testing actor-learner training..." << std::endl;
+
+    const std::string model_path = "test_rl_trainer_model.bin";
+    RLPlayerAI ai;
+    ai.set_model_path(model_path);
+
+    RLTrainer::Options options;
+    options.actors = 3;
+    options.episodes = 30;
+    options.max_turns = 50;
+    options.snapshot_interval = 100;
+    options.checkpoint_interval = 10;
+    options.queue_capacity = 32;
+    RLTrainer::Stats stats = RLTrainer::train(ai, options);
+
+    // 要求したエピソード数だけ学習し、全経験がlearnerに届く
+    assert(stats.actors == 3);
+    assert(stats.episodes == 30);
+    assert(ai.get_total_episodes() == 30);
+    assert(stats.experiences >= 30 && stats.experiences <= 30 * 50);
+    assert(stats.snapshots == stats.experiences / 100);
+    assert(stats.checkpoints == 4);   // 10, 20, 30エピソード目 + 終了時
+    assert(!ai.get_q_table().empty());
+
+    // チェックポイントはsave_modelの形式で読み戻せる
+    RLPlayerAI restored;
+    restored.set_model_path(model_path);
+    restored.load_model();
+    assert(restored.get_q_table().size() == ai.get_q_table().size());
+    std::remove(model_path.c_str());
+
+    std::cout << "✅ Actor-learner training test passed" << std::endl;
+}
+
+void test_hogwild_training_run() {
+    std::cout << "Testing Hogwild training..." << std::endl;
+
+    const std::string model_path = "test_rl_trainer_hogwild.bin";
+    RLPlayerAI ai;
+    ai.set_model_path(model_path);
+
+    RLTrainer::Options options;
+    options.actors = 3;
+    options.episodes = 30;
+    options.max_turns = 50;
+    options.hogwild = true;
+    options.hogwild_capacity = 1 << 12;
+    RLTrainer::Stats stats = RLTrainer::train(ai, options);
+
+    // 各actorの結果がまとめて反映され、終了時に保存される
+    assert(stats.actors == 3);
+    assert(stats.episodes == 30);
+    assert(ai.get_total_episodes() == 30);
+    assert(ai.get_epsilon() < 1.0);
+    assert(stats.experiences >= 30 && stats.experiences <= 30 * 50);
+    assert(stats.snapshots == 0);
+    assert(stats.checkpoints == 1);
+    assert(stats.dropped_updates == 0);
+    assert(!ai.get_q_table().empty());
+
+    // 学習済みの表から再開すると状態が引き継がれる
+    size_t states = ai.get_q_table().size();
+    options.episodes = 5;
+    options.checkpoint_interval = -1;
+    RLTrainer::train(ai, options);
+    assert(ai.get_q_table().size() >= states);
+
+    RLPlayerAI restored;
+    restored.set_model_path(model_path);
+    restored.load_model();
+    assert(restored.get_q_table().size() == states);
+    std::remove(model_path.c_str());
+
+    std::cout << "✅ Hogwild training test passed" << std::endl;
+}
+
+void test_linear_training_run() {
+    std::cout << "Testing actor-learner training with the linear backend..." << std::endl;
+
+    RLPlayerAI ai;
+    ai.set_linear_backend(true);
+
+    RLTrainer::Options options;
+    options.actors = 2;
+    options.episodes = 20;
+    options.max_turns = 40;
+    options.snapshot_interval = 50;
+    options.checkpoint_interval = -1;
+    RLTrainer::Stats stats = RLTrainer::train(ai, options);
+    assert(stats.episodes == 20);
+    assert(stats.snapshots > 0);
+    assert(ai.get_q_table().empty());
+
+    // actorが受け取るスナップショットは学習した重みそのもの（重み0のモデルではない）
+    RLTrainer::Snapshot snapshot(ai);
+    bool learned = false;
+    for (int i = 0; i < LinearValueModel::FEATURE_COUNT; ++i) {
+        assert(snapshot.model.weight(i) == ai.get_value_model().weight(i));
+        if (snapshot.model.weight(i) != 0.0f) learned = true;
+    }
+    assert(learned);
+    assert(snapshot.epsilon == ai.get_epsilon());
+
+    // tabularバックエンドでは線形モデルを写さない
+    RLPlayerAI tabular;
+    RLTrainer::Snapshot empty(tabular);
+    for (int i = 0; i < LinearValueModel::FEATURE_COUNT; ++i) {
+        assert(empty.model.weight(i) == 0.0f);
+    }
+
+    std::cout << "✅ Linear backend training test passed" << std::endl;
+}
+
+void test_resume_from_mapped_model() {
+    std::cout << "Testing training resumed from a mapped model..." << std::endl;
+
+    const std::string model_path = "test_rl_trainer_mapped.bin";
+    RLTrainer::Options options;
+    options.actors = 2;
+    options.episodes = 20;
+    options.max_turns = 40;
+    options.hogwild_capacity = 1 << 12;
+    {
+        RLPlayerAI base;
+        base.set_model_path(model_path);
+        RLTrainer::train(base, options);
+    }
+    RLPlayerAI base;
+    base.set_model_path(model_path);
+    assert(base.load_model());
+    size_t states = base.get_q_table().size();
+    assert(states > 0);
+
+    // Hogwild・actor-learnerのどちらでも、mmapしたモデルの状態を取り込んで学習し、
+    // 元のファイルは書き換えずoverlayへ学習分を保存する（読み戻すと全状態が揃っている）
+    for (bool hogwild : {true, false}) {
+        RLPlayerAI mapped;
+        mapped.set_model_path(model_path);
+        mapped.set_mmap_model(true);
+        assert(mapped.load_model());
+        assert(mapped.get_q_table().empty());
+
+        options.hogwild = hogwild;
+        options.episodes = 5;
+        RLTrainer::Stats stats = RLTrainer::train(mapped, options);
+        assert(stats.failed_checkpoints == 0 && stats.checkpoints >= 1);
+        assert(mapped.is_model_mapped());
+        assert(std::ifstream(mapped.overlay_path()).good());
+
+        // overlayを外せば元のファイルは学習前のまま
+        RLPlayerAI original;
+        assert(std::rename(mapped.overlay_path().c_str(), (model_path + ".saved_overlay").c_str()) == 0);
+        original.set_model_path(model_path);
+        assert(original.load_model());
+        assert(original.get_q_table().size() == states);
+        assert(std::rename((model_path + ".saved_overlay").c_str(), mapped.overlay_path().c_str()) == 0);
+
+        RLPlayerAI restored;
+        restored.set_model_path(model_path);
+        assert(restored.load_model());
+        assert(restored.get_q_table().size() >= states);
+        base.get_q_table().for_each([&](uint64_t key, const QRow&) {
+            assert(restored.get_q_table().find(key));
+        });
+        std::remove(mapped.overlay_path().c_str());
+    }
+    std::remove(model_path.c_str());
+
+    std::cout << "✅ Mapped model resume test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== RL Trainer Tests ===" << std::endl;
+
+    test_mpsc_queue();
+    test_concurrent_q_table();
+    test_concurrent_update();
+    test_training_run();
+    test_hogwild_training_run();
+    test_linear_training_run();
+    test_resume_from_mapped_model();
+
+    std::cout << "🎉 All RL trainer tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include "../cpp/ai/vec_env.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+struct Buffers {
+    std::vector<uint8_t> observations;
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;       // vector<bool>はポインタで渡せないため
+    std::vector<uint8_t> truncated;
+    std::vector<int32_t> chains;
+
+    explicit Buffers(const VecEnv& env)
+        : observations(static_cast<size_t>(env.num_agents()) * env.observation_size()),
+          rewards(env.num_agents()), dones(env.num_agents()), truncated(env.num_agents()),
+          chains(env.num_agents()) {}
+
+    void step(VecEnv& env, const std::vector<int32_t>& actions) {
+        env.step(actions.data(), observations.data(), rewards.data(), reinterpret_cast<bool*>(dones.data()),
+                 reinterpret_cast<bool*>(truncated.data()), chains.data());
+    }
+
+    const uint8_t* observation(const VecEnv& env, int agent) const {
+        return observations.data() + static_cast<size_t>(agent) * env.observation_size();
+    }
+};
+
+VecEnv::Config make_config(int num_envs, VecEnv::Mode mode) {
+    VecEnv::Config config;
+    config.num_envs = num_envs;
+    config.mode = mode;
+    config.seed = 42;
+    return config;
+}
+
+// 置ける配置からランダムに選ぶ
+std::vector<int32_t> random_actions(const VecEnv& env, std::mt19937& rng) {
+    std::vector<uint8_t> mask(static_cast<size_t>(env.num_agents()) * PLACEMENT_COUNT);
+    env.action_mask(mask.data());
+    std::vector<int32_t> actions(env.num_agents() * 2);
+    for (int agent = 0; agent < env.num_agents(); ++agent) {
+        std::vector<int> valid;
+        for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+            if (mask[agent * PLACEMENT_COUNT + i]) valid.push_back(i);
+        }
+        int index = valid.empty() ? 0 : valid[rng() % valid.size()];
+        actions[agent * 2] = PLACEMENTS[index].x;
+        actions[agent * 2 + 1] = PLACEMENTS[index].r;
+    }
+    return actions;
+}
+
+void test_observation_layout() {
+    std::cout << "Testing VecEnv observation layout..." << std::endl;
+
+    VecEnv env(make_config(3, VecEnv::Mode::TOKOTON));
+    assert(env.num_agents() == 3);
+    assert(env.observation_size() == VecEnv::BASE_OBS);
+    Buffers buffers(env);
+    env.reset(buffers.observations.data());
+
+    // 初期盤面は空、ツモは同じシードのNextGeneratorと一致する
+    NextGenerator next(42 + 1);
+    next.initialize_next_sequence();
+    const uint8_t* obs = buffers.observation(env, 1);
+    for (int i = 0; i < VecEnv::FIELD_OBS; ++i) {
+        assert(obs[i] == 0);
+    }
+    for (int i = 0; i < 3; ++i) {
+        assert(obs[VecEnv::FIELD_OBS + i * 2] == static_cast<uint8_t>(next.get_next_pair(i).axis));
+        assert(obs[VecEnv::FIELD_OBS + i * 2 + 1] == static_cast<uint8_t>(next.get_next_pair(i).child));
+    }
+
+    // 盤面のセルは y * FIELD_WIDTH + x
+    env.field(2).set_puyo(4, 0, PuyoColor::BLUE);
+    env.field(2).set_puyo(4, 1, PuyoColor::GARBAGE);
+    env.pending_garbage(2) = 300;
+    std::vector<uint8_t> single(env.observation_size());
+    env.write_observation(2, single.data());
+    assert(single[0 * FIELD_WIDTH + 4] == static_cast<uint8_t>(PuyoColor::BLUE));
+    assert(single[1 * FIELD_WIDTH + 4] == static_cast<uint8_t>(PuyoColor::GARBAGE));
+    assert(single[VecEnv::FIELD_OBS + VecEnv::PAIR_OBS] == 255);
+
+    std::vector<uint8_t> mask(env.num_agents() * PLACEMENT_COUNT);
+    env.action_mask(mask.data());
+    for (int i = 0; i < PLACEMENT_COUNT; ++i) {
+        assert(mask[i] == 1);
+    }
+
+    std::cout << "✅ VecEnv observation layout test passed" << std::endl;
+}
+
+void test_step_and_invalid_action() {
+    std::cout << "Testing VecEnv step..." << std::endl;
+
+    VecEnv env(make_config(2, VecEnv::Mode::TOKOTON));
+    Buffers buffers(env);
+    env.reset(buffers.observations.data());
+    uint8_t next_axis = buffers.observation(env, 0)[VecEnv::FIELD_OBS + 2];
+
+    // ゲーム0は縦置き、ゲーム1は範囲外の配置（ツモを捨てて罰を受ける）
+    std::vector<int32_t> actions = {2, 0, 7, 0};
+    buffers.step(env, actions);
+    const uint8_t* obs = buffers.observation(env, 0);
+    assert(obs[0 * FIELD_WIDTH + 2] != 0);
+    assert(obs[1 * FIELD_WIDTH + 2] != 0);
+    assert(obs[VecEnv::FIELD_OBS] == next_axis);   // ツモが1つ進む
+    assert(env.field(0).count_puyos() == 2);
+    assert(env.field(1).count_puyos() == 0);
+    assert(buffers.rewards[0] == 0.0f);
+    assert(buffers.rewards[1] == static_cast<float>(env.config().invalid_action_reward));
+    assert(!buffers.dones[0] && !buffers.dones[1]);
+    assert(env.turn(0) == 1 && env.turn(1) == 1);
+    assert(env.total_steps() == 2);
+
+    std::cout << "✅ VecEnv step test passed" << std::endl;
+}
+
+void test_auto_reset() {
+    std::cout << "Testing VecEnv auto reset..." << std::endl;
+
+    VecEnv::Config config = make_config(2, VecEnv::Mode::TOKOTON);
+    config.max_turns = 10;
+    VecEnv env(config);
+    Buffers buffers(env);
+    env.reset(buffers.observations.data());
+
+    // ゲーム0は3列目に積み続けて窒息する
+    std::vector<int32_t> actions = {2, 0, 0, 0};
+    bool lost = false;
+    for (int turn = 0; turn < config.max_turns && !lost; ++turn) {
+        actions[2] = turn % FIELD_WIDTH;
+        buffers.step(env, actions);
+        lost = buffers.dones[0] != 0;
+    }
+    assert(lost);
+    assert(!buffers.truncated[0]);
+    assert(buffers.rewards[0] <= static_cast<float>(config.game_over_reward));
+    assert(env.total_episodes() >= 1);
+    // リセット後の観測（空の盤面）が書かれている
+    assert(env.turn(0) == 0);
+    assert(env.field(0).count_puyos() == 0);
+    for (int i = 0; i < VecEnv::FIELD_OBS; ++i) {
+        assert(buffers.observation(env, 0)[i] == 0);
+    }
+
+    // ゲーム1は手数上限で打ち切り
+    while (!buffers.dones[1]) {
+        actions[0] = 5;
+        actions[2] = (actions[2] + 1) % FIELD_WIDTH;
+        buffers.step(env, actions);
+    }
+    assert(buffers.truncated[1]);
+    assert(env.turn(1) == 0);
+
+    std::cout << "✅ VecEnv auto reset test passed" << std::endl;
+}
+
+void test_versus_garbage() {
+    std::cout << "Testing VecEnv versus garbage..." << std::endl;
+
+    VecEnv env(make_config(1, VecEnv::Mode::VERSUS));
+    assert(env.num_agents() == 2);
+    assert(env.observation_size() == VecEnv::BASE_OBS + VecEnv::FIELD_OBS);
+    Buffers buffers(env);
+    env.reset(buffers.observations.data());
+
+    // 置いたツモで消える盤面を用意する（現在のツモの軸の色を3つ並べる）
+    std::vector<uint8_t> obs(env.observation_size());
+    env.write_observation(0, obs.data());
+    PuyoColor axis = static_cast<PuyoColor>(obs[VecEnv::FIELD_OBS]);
+    for (int x = 0; x < 3; ++x) {
+        env.field(0).set_puyo(x, 0, axis);
+    }
+    env.pending_garbage(0) = 1;
+
+    // 縦置きでxの位置に軸、その上に子
+    std::vector<int32_t> actions = {3, 0, 5, 0};
+    buffers.step(env, actions);
+    assert(buffers.chains[0] >= 1);
+    assert(buffers.rewards[0] > 0.0f);
+    assert(buffers.chains[1] == 0);
+
+    // 70点で1個 → まず自分の予告1個と相殺し、残りは相手へ送る（予告分はその手の後に降る）
+    int score = static_cast<int>(buffers.rewards[0] / env.config().score_scale + 0.5f);
+    int sent = score / 70;
+    int offset = std::min(sent, 1);
+    assert(env.pending_garbage(0) == 0);
+    assert(env.pending_garbage(1) == 0);
+    assert(env.field(0).count_color(PuyoColor::GARBAGE) == 1 - offset);
+    assert(env.field(1).count_color(PuyoColor::GARBAGE) == sent - offset);
+
+    // 相手の盤面は観測の後半に入る
+    env.write_observation(0, obs.data());
+    for (int i = 0; i < VecEnv::FIELD_OBS; ++i) {
+        std::vector<uint8_t> other(env.observation_size());
+        env.write_observation(1, other.data());
+        assert(obs[VecEnv::BASE_OBS + i] == other[i]);
+    }
+
+    // 片方が窒息すると両者が終了し、勝者に勝ち報酬
+    for (int y = 0; y < FIELD_HEIGHT - 2; ++y) {
+        env.field(1).set_puyo(2, y, static_cast<PuyoColor>(1 + y % 2 + (y / 2) % 2 * 2));
+        env.field(1).set_puyo(3, y, static_cast<PuyoColor>(1 + (y + 1) % 2 + (y / 2) % 2 * 2));
+    }
+    std::vector<int32_t> finish = {0, 0, 2, 0};
+    buffers.step(env, finish);
+    assert(buffers.dones[0] && buffers.dones[1]);
+    assert(buffers.rewards[1] < 0.0f);
+    assert(buffers.rewards[0] >= static_cast<float>(env.config().win_reward));
+
+    std::cout << "✅ VecEnv versus garbage test passed" << std::endl;
+}
+
+void test_determinism_and_threads() {
+    std::cout << "Testing VecEnv determinism..." << std::endl;
+
+    for (VecEnv::Mode mode : {VecEnv::Mode::TOKOTON, VecEnv::Mode::VERSUS}) {
+        VecEnv::Config config = make_config(16, mode);
+        config.max_turns = 60;
+        VecEnv single(config);
+        config.threads = 4;
+        VecEnv threaded(config);
+        Buffers a(single), b(threaded);
+        single.reset(a.observations.data());
+        threaded.reset(b.observations.data());
+
+        std::mt19937 rng(7);
+        for (int step = 0; step < 300; ++step) {
+            std::vector<int32_t> actions = random_actions(single, rng);
+            a.step(single, actions);
+            b.step(threaded, actions);
+            assert(a.observations == b.observations);
+            assert(std::memcmp(a.rewards.data(), b.rewards.data(), a.rewards.size() * sizeof(float)) == 0);
+            assert(a.dones == b.dones);
+            assert(a.truncated == b.truncated);
+            assert(a.chains == b.chains);
+        }
+        assert(single.total_episodes() == threaded.total_episodes());
+        assert(single.total_episodes() > 0);
+        assert(single.total_steps() == 300 * 16);
+    }
+
+    std::cout << "✅ VecEnv determinism test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== VecEnv Tests ===" << std::endl;
+
+    test_observation_layout();
+    test_step_and_invalid_action();
+    test_auto_reset();
+    test_versus_garbage();
+    test_determinism_and_threads();
+
+    std::cout << "🎉 All VecEnv tests passed!" << std::endl;
+    return 0;
+}
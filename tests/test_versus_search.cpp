@@ -0,0 +1,109 @@
+#include "../cpp/ai/chain_search_ai.h"
+#include "../cpp/core/bit_field.h"
+#include "../cpp/core/field.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+using namespace puyo;
+using namespace puyo::ai;
+
+// 赤1個で2連鎖が発火する盤面
+//   y3: . G
+//   y2: G R
+//   y1: G R
+//   y0: G R .  ← (2,0)に赤で発火
+Field make_two_chain_field() {
+    Field field;
+    for (int y = 0; y < 3; ++y) {
+        field.set_puyo(Position(0, y), PuyoColor::GREEN);
+        field.set_puyo(Position(1, y), PuyoColor::RED);
+    }
+    field.set_puyo(Position(1, 3), PuyoColor::GREEN);
+    return field;
+}
+
+void test_chain_potential() {
+    std::cout << "Testing chain potential kernel..." << std::endl;
+
+    BitField field = BitField::from_field(make_two_chain_field());
+    ChainPotential potential = field.chain_potential(1);
+    assert(potential.chain_count == 2);
+    assert(potential.added == 1);
+    assert(potential.x == 2);
+    assert(potential.color == PuyoColor::RED);
+    assert(potential.score > 0);
+
+    // 元の盤面は変更されない
+    assert(field.count_puyos() == 7);
+
+    // 空の盤面は発火できない
+    ChainPotential none = BitField().chain_potential(2);
+    assert(none.chain_count == 0);
+    assert(none.x == -1);
+
+    // 追加数ごとに調べて統合した結果は、まとめて調べた結果と一致する
+    std::mt19937 rng(32);
+    for (int trial = 0; trial < 100; ++trial) {
+        BitField random;
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            int height = static_cast<int>(rng() % 9);
+            for (int y = 0; y < height; ++y) {
+                random.set_puyo(x, y, static_cast<PuyoColor>(1 + rng() % COLOR_COUNT));
+            }
+        }
+        random.simulate();
+        ChainPotential merged = random.chain_potential(1);
+        for (int added = 2; added <= 4; ++added) {
+            ChainPotential level = random.chain_potential(added, added);
+            assert(level.chain_count == 0 || level.added == added);
+            if (level.better(merged)) merged = level;
+        }
+        ChainPotential all = random.chain_potential(4);
+        assert(merged.chain_count == all.chain_count && merged.score == all.score);
+        assert(merged.added == all.added && merged.x == all.x && merged.color == all.color);
+    }
+
+    std::cout << "✅ Chain potential kernel test passed" << std::endl;
+}
+
+void test_opponent_analysis() {
+    std::cout << "Testing opponent-aware decision..." << std::endl;
+
+    ChainSearchAI ai;
+    assert(ai.initialize());
+
+    Field own;
+    Field opponent = make_two_chain_field();
+    GameState state;
+    state.own_field = &own;
+    state.current_pair = PuyoPair(PuyoColor::RED, PuyoColor::BLUE);
+    state.next_queue = {PuyoPair(PuyoColor::GREEN, PuyoColor::GREEN)};
+
+    // 対戦時のみ相手を解析する
+    AIDecision single = ai.think(state);
+    assert(single.reason.find("opp=") == std::string::npos);
+
+    state.is_versus_mode = true;
+    state.opponent_field = &opponent;
+    AIDecision versus = ai.think(state);
+    assert(versus.reason.find("opp=2chain/1turn") != std::string::npos);
+
+    // 相手の盤面が変われば解析し直す
+    Field calm;
+    state.opponent_field = &calm;
+    versus = ai.think(state);
+    assert(versus.reason.find("opp=0chain/-1turn") != std::string::npos);
+
+    std::cout << "✅ Opponent-aware decision test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Versus Search Tests ===" << std::endl;
+
+    test_chain_potential();
+    test_opponent_analysis();
+
+    std::cout << "\n🎉 All versus search tests passed!" << std::endl;
+    return 0;
+}